@@ -7,6 +7,7 @@ extern "C" {
 
 #define SYNCD_INIT_VIEW  "INIT_VIEW"
 #define SYNCD_APPLY_VIEW "APPLY_VIEW"
+#define SYNCD_APPLY_VIEW_DRY_RUN "APPLY_VIEW_DRY_RUN"
 #define ASIC_STATE_TABLE "ASIC_STATE"
 #define TEMP_PREFIX      "TEMP_"
 
@@ -14,7 +15,15 @@ typedef enum _sai_redis_notify_syncd_t
 {
     SAI_REDIS_NOTIFY_SYNCD_INIT_VIEW,
 
-    SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW
+    SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW,
+
+    /**
+     * @brief Compute apply view transition and report operations that would
+     * be executed, without changing ASIC and redis database. Syncd stays in
+     * current mode. Report can be read using
+     * SAI_REDIS_SWITCH_ATTR_APPLY_VIEW_REPORT.
+     */
+    SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW_DRY_RUN
 
 } sai_redis_notify_syncd_t;
 
@@ -101,6 +110,47 @@ typedef enum _sai_redis_switch_attr_t
      */
     SAI_REDIS_SWITCH_ATTR_PERFORM_LOG_ROTATE,
 
+    /**
+     * @brief Metadata db statistics.
+     *
+     * Json string with number of objects, approximate memory usage per object
+     * type and attribute, and load factors of metadata db hash tables. If
+     * list is too small, SAI_STATUS_BUFFER_OVERFLOW is returned and count is
+     * set to required size including terminating null.
+     *
+     * @type sai_s8_list_t
+     * @flags READ_ONLY
+     */
+    SAI_REDIS_SWITCH_ATTR_META_DB_STATISTICS,
+
+    /**
+     * @brief Metadata db compact mode.
+     *
+     * When set to true, attributes of route, neighbor and fdb entries equal
+     * to their default value are not kept in metadata db. Has impact only
+     * on attributes set after change.
+     *
+     * @type bool
+     * @flags CREATE_AND_SET
+     * @default false
+     */
+    SAI_REDIS_SWITCH_ATTR_META_DB_COMPACT_MODE,
+
+    /**
+     * @brief Report of last apply view or apply view dry run.
+     *
+     * Json object with sizes of both views, number of ASIC operations (total
+     * and per object type and operation as "op:<object type>:<op>"), time
+     * of each phase as "phase:<name>" and syncd peak RSS. Report is sent by
+     * syncd in notify syncd response, it's not stored in redis. If list is
+     * too small, SAI_STATUS_BUFFER_OVERFLOW is returned and count is set to
+     * required size including terminating null.
+     *
+     * @type sai_s8_list_t
+     * @flags READ_ONLY
+     */
+    SAI_REDIS_SWITCH_ATTR_APPLY_VIEW_REPORT,
+
 } sai_redis_switch_attr_t;
 
 /*
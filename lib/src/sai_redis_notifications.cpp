@@ -33,15 +33,11 @@ void handle_fdb_event(
 
     sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
 
-    {
-        std::lock_guard<std::mutex> lock(g_apimutex);
-
-        // NOTE: this meta api must be under mutex since
-        // it will access meta DB and notification comes
-        // from different thread
+    // NOTE: meta db is locked internally, fdb shard is locked exclusively
+    // so this notification doesn't need api mutex and can be processed
+    // while route or neighbor entries are programmed from other thread
 
-        meta_sai_on_fdb_event(count, fdbevent);
-    }
+    meta_sai_on_fdb_event(count, fdbevent);
 
     auto on_fdb_event = redis_switch_notifications.on_fdb_event;
 
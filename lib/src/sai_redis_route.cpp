@@ -154,22 +154,6 @@ sai_status_t sai_bulk_remove_route_entry(
     return SAI_STATUS_NOT_IMPLEMENTED;
 }
 
-sai_status_t redis_dummy_set_route_entry(
-        _In_ const sai_unicast_route_entry_t* unicast_route_entry,
-        _In_ const sai_attribute_t *attr)
-{
-    SWSS_LOG_ENTER();
-
-    /*
-     * Since we are using validation for each route in bulk operations, we
-     * can't execute actual SET, we need to do dummy set and then introduce
-     * internal bulk_set operation that will only touch redis db only once.
-     * So we are returning success here.
-     */
-
-    return SAI_STATUS_SUCCESS;
-}
-
 sai_status_t sai_bulk_set_route_entry_attribute(
         _In_ uint32_t object_count,
         _In_ const sai_unicast_route_entry_t *route_entry,
@@ -227,39 +211,34 @@ sai_status_t sai_bulk_set_route_entry_attribute(
 
     for (uint32_t idx = 0; idx < object_count; ++idx)
     {
-        /*
-         * At the beginning set all statuses to not executed.
-         */
-
-        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
-
         serialized_object_ids.push_back(
                 sai_serialize_route_entry(route_entry[idx]));
     }
 
+    /*
+     * Whole batch is validated at once and local db is updated for valid
+     * entries, then redis db is touched only once in internal bulk set.
+     * Statuses of entries that were not validated are set to not executed.
+     */
+
+    meta_sai_bulk_set_route_entry(
+            object_count,
+            route_entry,
+            attr_list,
+            type == SAI_BULK_OP_TYPE_STOP_ON_ERROR,
+            object_statuses);
+
     for (uint32_t idx = 0; idx < object_count; ++idx)
     {
-        sai_status_t status =
-            meta_sai_set_route_entry(
-                    &route_entry[idx],
-                    &attr_list[idx],
-                    &redis_dummy_set_route_entry);
+        sai_status_t status = object_statuses[idx];
 
-        object_statuses[idx] = status;
-
-        if (status != SAI_STATUS_SUCCESS)
+        if (status != SAI_STATUS_SUCCESS && status != SAI_STATUS_NOT_EXECUTED)
         {
             // TODO add attr id and value
 
             SWSS_LOG_ERROR("failed on index %u: %s",
                     idx,
                     serialized_object_ids[idx].c_str());
-
-            if (type == SAI_BULK_OP_TYPE_STOP_ON_ERROR)
-            {
-                SWSS_LOG_NOTICE("stop on error since previous operation failed");
-                break;
-            }
         }
     }
 
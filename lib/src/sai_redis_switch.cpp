@@ -3,8 +3,11 @@
 #include <thread>
 
 #include "swss/selectableevent.h"
+#include "swss/json.hpp"
 #include "meta/saiserialize.h"
 
+using json = nlohmann::json;
+
 // TODO it may be needed to obtain SAI_SWITCH_ATTR_DEFAULT_TRAP_GROUP object id
 
 sai_switch_notification_t redis_switch_notifications;
@@ -16,6 +19,12 @@ volatile bool g_useTempView = false;
 
 std::shared_ptr<std::thread> notification_thread;
 
+/*
+ * Report of last apply view or apply view dry run, received from syncd in
+ * notify response.
+ */
+std::vector<swss::FieldValueTuple> g_applyViewReport;
+
 // this event is used to nice end notifications thread
 swss::SelectableEvent g_redisNotificationTrheadEvent;
 
@@ -220,7 +229,8 @@ void redis_disconnect_switch(void)
 }
 
 sai_status_t sai_redis_internal_notify_syncd(
-        _In_ const std::string& key)
+        _In_ const std::string& key,
+        _Out_ std::vector<swss::FieldValueTuple>& values)
 {
     SWSS_LOG_ENTER();
 
@@ -274,6 +284,8 @@ sai_status_t sai_redis_internal_notify_syncd(
             sai_status_t status;
             sai_deserialize_status(opkey, status);
 
+            values = kfvFieldsValues(kco);
+
             return status;
         }
 
@@ -322,12 +334,24 @@ sai_status_t sai_redis_notify_syncd(
             g_asicInitViewMode = false;
             break;
 
+        case SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW_DRY_RUN:
+            SWSS_LOG_NOTICE("sending syncd APPLY view dry run");
+            op = SYNCD_APPLY_VIEW_DRY_RUN;
+            break;
+
         default:
             SWSS_LOG_ERROR("invalid notify syncd attr value %d", attr->value.s32);
             return SAI_STATUS_FAILURE;
     }
 
-    sai_status_t status = sai_redis_internal_notify_syncd(op);
+    std::vector<swss::FieldValueTuple> values;
+
+    sai_status_t status = sai_redis_internal_notify_syncd(op, values);
+
+    if (op != SYNCD_INIT_VIEW)
+    {
+        g_applyViewReport = values;
+    }
 
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -407,6 +431,10 @@ sai_status_t redis_set_switch_attribute(
             case SAI_REDIS_SWITCH_ATTR_RECORDING_OUTPUT_DIR:
                 return setRecordingOutputDir(*attr);
 
+            case SAI_REDIS_SWITCH_ATTR_META_DB_COMPACT_MODE:
+                meta_set_compact_mode(attr->value.booldata);
+                return SAI_STATUS_SUCCESS;
+
             default:
                 break;
         }
@@ -417,6 +445,51 @@ sai_status_t redis_set_switch_attribute(
             &redis_generic_set_switch);
 }
 
+sai_status_t getStringAttribute(
+        _In_ const std::string &str,
+        _Inout_ sai_attribute_t &attr)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t count = (uint32_t)str.size() + 1;
+
+    if (attr.value.s8list.list == NULL || attr.value.s8list.count < count)
+    {
+        attr.value.s8list.count = count;
+
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    memcpy(attr.value.s8list.list, str.c_str(), count);
+
+    attr.value.s8list.count = count;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t getMetaDbStatistics(
+        _Inout_ sai_attribute_t &attr)
+{
+    SWSS_LOG_ENTER();
+
+    return getStringAttribute(meta_serialize_db_statistics(meta_get_db_statistics()), attr);
+}
+
+sai_status_t getApplyViewReport(
+        _Inout_ sai_attribute_t &attr)
+{
+    SWSS_LOG_ENTER();
+
+    json j = json::object();
+
+    for (const auto &fv: g_applyViewReport)
+    {
+        j[fvField(fv)] = fvValue(fv);
+    }
+
+    return getStringAttribute(j.dump(), attr);
+}
+
 /**
  * Routine Description:
  *    @brief Get switch attribute value
@@ -437,6 +510,25 @@ sai_status_t redis_get_switch_attribute(
 
     SWSS_LOG_ENTER();
 
+    if (attr_count == 1 && attr_list != NULL)
+    {
+        switch (attr_list[0].id)
+        {
+            case SAI_REDIS_SWITCH_ATTR_META_DB_STATISTICS:
+                return getMetaDbStatistics(attr_list[0]);
+
+            case SAI_REDIS_SWITCH_ATTR_APPLY_VIEW_REPORT:
+                return getApplyViewReport(attr_list[0]);
+
+            case SAI_REDIS_SWITCH_ATTR_META_DB_COMPACT_MODE:
+                attr_list[0].value.booldata = meta_get_compact_mode();
+                return SAI_STATUS_SUCCESS;
+
+            default:
+                break;
+        }
+    }
+
     return meta_sai_get_switch(
             attr_count,
             attr_list,
@@ -81,13 +81,8 @@ void test_enable_recording()
     ASSERT_SUCCESS("Failed to enable recording");
 }
 
-class SaiAttrWrapper;
-extern std::unordered_map<std::string,
-       std::unordered_map<sai_attr_id_t,
-       std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
+extern SaiObjectAttrDb ObjectAttrHash;
 extern void object_reference_insert(sai_object_id_t oid);
-extern std::string get_object_meta_key_string(
-        _In_ const sai_object_meta_key_t& meta_key);
 
 sai_object_id_t create_dummy_object_id(
         _In_ sai_object_type_t objecttype)
@@ -129,14 +124,12 @@ void test_bulk_route_set()
         sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
         object_reference_insert(vr);
         sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
-        std::string vr_key = get_object_meta_key_string(meta_key_vr);
-        ObjectAttrHash[vr_key] = { };
+        ObjectAttrHash[meta_key_vr] = { };
 
         sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
         object_reference_insert(hop);
         sai_object_meta_key_t meta_key_hop = { .object_type = SAI_OBJECT_TYPE_NEXT_HOP, .key = { .object_id = hop } };
-        std::string hop_key = get_object_meta_key_string(meta_key_hop);
-        ObjectAttrHash[hop_key] = { };
+        ObjectAttrHash[meta_key_hop] = { };
 
         route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
         route_entry.destination.addr.ip4 = htonl(0x0a000000 | i);
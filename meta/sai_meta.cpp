@@ -2,11 +2,18 @@
 #include "sai_extra.h"
 #include "saiserialize.h"
 
+#include "swss/json.hpp"
+
 #include <string.h>
 #include <arpa/inet.h>
 
 #include <map>
 #include <iterator>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+
+using json = nlohmann::json;
 
 bool is_ipv6_mask_valid(
         _In_ const uint8_t* mask)
@@ -222,6 +229,179 @@ std::string get_object_meta_key_string(
     return key;
 }
 
+sai_object_type_t get_object_meta_key_class(
+        _In_ sai_object_type_t object_type)
+{
+    switch (object_type)
+    {
+        case SAI_OBJECT_TYPE_SWITCH:
+        case SAI_OBJECT_TYPE_VLAN:
+        case SAI_OBJECT_TYPE_TRAP:
+        case SAI_OBJECT_TYPE_FDB:
+        case SAI_OBJECT_TYPE_ROUTE:
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+            return object_type;
+
+        default:
+
+            // all object id types share the same key space, just like "oid:" string key
+
+            return SAI_OBJECT_TYPE_NULL;
+    }
+}
+
+size_t get_ip_addr_size(
+        _In_ sai_ip_addr_family_t family)
+{
+    switch (family)
+    {
+        case SAI_IP_ADDR_FAMILY_IPV4:
+            return sizeof(sai_ip4_t);
+
+        case SAI_IP_ADDR_FAMILY_IPV6:
+            return sizeof(sai_ip6_t);
+
+        default:
+            return 0;
+    }
+}
+
+static inline void meta_key_hash_append(
+        _Inout_ std::size_t& hash,
+        _In_ const void* mem,
+        _In_ size_t size)
+{
+    // FNV-1a
+
+    const uint8_t* p = (const uint8_t*)mem;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+std::size_t SaiObjectMetaKeyHash::operator()(
+        _In_ const sai_object_meta_key_t& meta_key) const
+{
+    sai_object_type_t ot = get_object_meta_key_class(meta_key.object_type);
+
+    std::size_t hash = 14695981039346656037ULL;
+
+    meta_key_hash_append(hash, &ot, sizeof(ot));
+
+    switch (ot)
+    {
+        case SAI_OBJECT_TYPE_SWITCH:
+            break;
+
+        case SAI_OBJECT_TYPE_VLAN:
+            meta_key_hash_append(hash, &meta_key.key.vlan_id, sizeof(meta_key.key.vlan_id));
+            break;
+
+        case SAI_OBJECT_TYPE_TRAP:
+            meta_key_hash_append(hash, &meta_key.key.trap_id, sizeof(meta_key.key.trap_id));
+            break;
+
+        case SAI_OBJECT_TYPE_FDB:
+            {
+                const auto& fdb = meta_key.key.fdb_entry;
+
+                meta_key_hash_append(hash, fdb.mac_address, sizeof(fdb.mac_address));
+                meta_key_hash_append(hash, &fdb.vlan_id, sizeof(fdb.vlan_id));
+                break;
+            }
+
+        case SAI_OBJECT_TYPE_ROUTE:
+            {
+                const auto& route = meta_key.key.route_entry;
+
+                size_t size = get_ip_addr_size(route.destination.addr_family);
+
+                meta_key_hash_append(hash, &route.vr_id, sizeof(route.vr_id));
+                meta_key_hash_append(hash, &route.destination.addr_family, sizeof(route.destination.addr_family));
+                meta_key_hash_append(hash, &route.destination.addr, size);
+                meta_key_hash_append(hash, &route.destination.mask, size);
+                break;
+            }
+
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+            {
+                const auto& neighbor = meta_key.key.neighbor_entry;
+
+                size_t size = get_ip_addr_size(neighbor.ip_address.addr_family);
+
+                meta_key_hash_append(hash, &neighbor.rif_id, sizeof(neighbor.rif_id));
+                meta_key_hash_append(hash, &neighbor.ip_address.addr_family, sizeof(neighbor.ip_address.addr_family));
+                meta_key_hash_append(hash, &neighbor.ip_address.addr, size);
+                break;
+            }
+
+        default:
+            meta_key_hash_append(hash, &meta_key.key.object_id, sizeof(meta_key.key.object_id));
+            break;
+    }
+
+    return hash;
+}
+
+bool SaiObjectMetaKeyEqual::operator()(
+        _In_ const sai_object_meta_key_t& a,
+        _In_ const sai_object_meta_key_t& b) const
+{
+    sai_object_type_t ot = get_object_meta_key_class(a.object_type);
+
+    if (ot != get_object_meta_key_class(b.object_type))
+    {
+        return false;
+    }
+
+    switch (ot)
+    {
+        case SAI_OBJECT_TYPE_SWITCH:
+            return true;
+
+        case SAI_OBJECT_TYPE_VLAN:
+            return a.key.vlan_id == b.key.vlan_id;
+
+        case SAI_OBJECT_TYPE_TRAP:
+            return a.key.trap_id == b.key.trap_id;
+
+        case SAI_OBJECT_TYPE_FDB:
+            return a.key.fdb_entry.vlan_id == b.key.fdb_entry.vlan_id &&
+                memcmp(a.key.fdb_entry.mac_address, b.key.fdb_entry.mac_address, sizeof(sai_mac_t)) == 0;
+
+        case SAI_OBJECT_TYPE_ROUTE:
+            {
+                const auto& ra = a.key.route_entry;
+                const auto& rb = b.key.route_entry;
+
+                size_t size = get_ip_addr_size(ra.destination.addr_family);
+
+                return ra.vr_id == rb.vr_id &&
+                    ra.destination.addr_family == rb.destination.addr_family &&
+                    memcmp(&ra.destination.addr, &rb.destination.addr, size) == 0 &&
+                    memcmp(&ra.destination.mask, &rb.destination.mask, size) == 0;
+            }
+
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+            {
+                const auto& na = a.key.neighbor_entry;
+                const auto& nb = b.key.neighbor_entry;
+
+                size_t size = get_ip_addr_size(na.ip_address.addr_family);
+
+                return na.rif_id == nb.rif_id &&
+                    na.ip_address.addr_family == nb.ip_address.addr_family &&
+                    memcmp(&na.ip_address.addr, &nb.ip_address.addr, size) == 0;
+            }
+
+        default:
+            return a.key.object_id == b.key.object_id;
+    }
+}
+
 const sai_attribute_t* get_attribute_by_id(
         _In_ sai_attr_id_t id,
         _In_ uint32_t attr_count,
@@ -247,63 +427,81 @@ const sai_attribute_t* get_attribute_by_id(
     return NULL;
 }
 
+extern std::vector<sai_object_type_attr_metadata_t> ObjectTypeAttrMetadata;
+
+const sai_object_type_attr_metadata_t* get_object_type_attr_metadata(
+        _In_ sai_object_type_t objecttype)
+{
+    SWSS_LOG_ENTER();
+
+    if (objecttype <= SAI_OBJECT_TYPE_NULL || (size_t)objecttype >= ObjectTypeAttrMetadata.size())
+    {
+        SWSS_LOG_ERROR("invalid object type value: %d", objecttype);
+
+        return NULL;
+    }
+
+    return &ObjectTypeAttrMetadata[objecttype];
+}
+
 const sai_attr_metadata_t* get_attribute_metadata(
         _In_ sai_object_type_t objecttype,
         _In_ sai_attr_id_t attrid)
 {
     SWSS_LOG_ENTER();
 
-    const auto &it = AttributesMetadata.find(objecttype);
+    const auto* t = get_object_type_attr_metadata(objecttype);
 
-    if (it == AttributesMetadata.end())
+    if (t == NULL)
     {
-        SWSS_LOG_ERROR("invalid object type value: %d", objecttype);
-
         return NULL;
     }
 
-    const auto &attrset = it->second;
+    const sai_attr_metadata_t* md = NULL;
+
+    if (attrid < t->dense.size())
+    {
+        md = t->dense[attrid];
+    }
+    else if (attrid >= META_DENSE_ATTR_ID_MAX)
+    {
+        const auto &it = t->sparse.find(attrid);
 
-    const auto &ita = attrset.find(attrid);
+        if (it != t->sparse.end())
+        {
+            md = it->second;
+        }
+    }
 
-    if (ita == attrset.end())
+    if (md == NULL)
     {
         SWSS_LOG_ERROR("attribute %d not found in metadata for object type %s", attrid, get_object_type_name(objecttype));
 
         return NULL;
     }
 
-    SWSS_LOG_DEBUG("objecttype: %s, attrid: %s", get_object_type_name(objecttype), ita->second->attridname);
+    SWSS_LOG_DEBUG("objecttype: %s, attrid: %s", get_object_type_name(objecttype), md->attridname);
 
-    return ita->second;
+    return md;
 }
 
-std::vector<const sai_attr_metadata_t*> get_attributes_metadata(
+const std::vector<const sai_attr_metadata_t*>& get_attributes_metadata(
         _In_ sai_object_type_t objecttype)
 {
     SWSS_LOG_ENTER();
 
-    // NOTE: this is not performance best, we can do better
-
     SWSS_LOG_DEBUG("objecttype: %d", objecttype);
 
-    const auto &it = AttributesMetadata.find(objecttype);
-
-    std::vector<const sai_attr_metadata_t*> attrs;
-
-    if (it == AttributesMetadata.end())
-    {
-        SWSS_LOG_ERROR("invalid object type value: %d", objecttype);
+    static const std::vector<const sai_attr_metadata_t*> empty;
 
-        return attrs;
-    }
+    const auto* t = get_object_type_attr_metadata(objecttype);
 
-    for (auto i: it->second)
+    if (t == NULL)
     {
-        attrs.push_back(i.second);
+        return empty;
     }
 
-    return attrs;
+    return t->attributes;
 }
 
 class SaiAttrWrapper
@@ -313,16 +511,11 @@ class SaiAttrWrapper
         SaiAttrWrapper(
                 _In_ const sai_attr_metadata_t* meta,
                 _In_ const sai_attribute_t& attr):
-            m_meta(meta),
-            m_attr(attr)
+            m_meta(meta)
     {
         SWSS_LOG_ENTER();
 
-        m_attr.id = attr.id;
-
-        std::string s = sai_serialize_attr_value(*meta, attr, false);
-
-        sai_deserialize_attr_value(s, *meta, m_attr, false);
+        sai_copy_attr_value(*meta, attr, m_attr);
     }
 
         ~SaiAttrWrapper()
@@ -355,161 +548,549 @@ class SaiAttrWrapper
 // fdb, route, neighbor don't need reference count,
 // they are leafs and can be removed at any time
 std::unordered_map<sai_object_id_t,int32_t> ObjectReferences;
+
+// maximum number of referencing objects printed in logs
+#define META_REFERENCES_LOG_MAX_COUNT 16
+
+// reverse index of ObjectReferences, referenced object id to objects and
+// attributes holding the reference with number of references
+std::unordered_map<sai_object_id_t,std::unordered_map<sai_object_meta_key_t,std::map<sai_attr_id_t,uint32_t>,SaiObjectMetaKeyHash,SaiObjectMetaKeyEqual>> ObjectReverseReferences;
 std::unordered_map<sai_vlan_id_t,int32_t> VlanReferences;
-std::unordered_map<std::string,std::string> AttributeKeys;
-std::unordered_map<std::string,std::unordered_map<sai_attr_id_t,std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
+std::unordered_map<sai_object_meta_key_t,std::string,SaiObjectMetaKeyHash,SaiObjectMetaKeyEqual> AttributeKeys;
 
-// GENERIC REFERENCE FUNCTIONS
+// reverse index of AttributeKeys, constructed attribute key to object
+std::unordered_map<std::string,sai_object_meta_key_t> AttributeKeysObjects;
+SaiObjectAttrDb ObjectAttrHash;
 
-bool object_reference_exists(
-        _In_ sai_object_id_t oid)
-{
-    SWSS_LOG_ENTER();
+// guards reference counters and attribute keys, since they can be modified
+// by concurrent operations on different leaf shards, validation of one shard
+// must take it as well when reading them, since other shard may be writing
+std::mutex ReferencesMutex;
 
-    bool exists = ObjectReferences.find(oid) != ObjectReferences.end();
+// DB LOCKS
 
-    SWSS_LOG_DEBUG("object 0x%lx refrence: %s", oid, exists ? "exists" : "missing");
+// NOTE: no logging in constructor and destructor since db is global
+// object and logger may not exist yet or may be already destroyed
 
-    return exists;
+MetaRWLock::MetaRWLock()
+{
+    pthread_rwlock_init(&m_lock, NULL);
 }
 
-void object_reference_inc(
-        _In_ sai_object_id_t oid)
+MetaRWLock::~MetaRWLock()
+{
+    pthread_rwlock_destroy(&m_lock);
+}
+
+void MetaRWLock::lockRead()
 {
     SWSS_LOG_ENTER();
 
-    if (oid == SAI_NULL_OBJECT_ID)
-    {
-        return;
-    }
+    pthread_rwlock_rdlock(&m_lock);
+}
 
-    if (!object_reference_exists(oid))
-    {
-        SWSS_LOG_ERROR("FATAL: object oid 0x%lx not in reference map", oid);
-        throw;
-    }
+void MetaRWLock::lockWrite()
+{
+    SWSS_LOG_ENTER();
 
-    ObjectReferences[oid]++;
+    pthread_rwlock_wrlock(&m_lock);
+}
 
-    SWSS_LOG_DEBUG("increased reference on oid 0x%lx to %d", oid, ObjectReferences[oid]);
+void MetaRWLock::unlock()
+{
+    SWSS_LOG_ENTER();
+
+    pthread_rwlock_unlock(&m_lock);
 }
 
-void object_reference_dec(
-        _In_ sai_object_id_t oid)
+size_t SaiObjectAttrDb::getShardIndex(
+        _In_ sai_object_type_t object_type)
 {
     SWSS_LOG_ENTER();
 
-    if (oid == SAI_NULL_OBJECT_ID)
+    switch (object_type)
     {
-        return;
-    }
+        case SAI_OBJECT_TYPE_ROUTE:
+            return 1;
 
-    if (!object_reference_exists(oid))
-    {
-        SWSS_LOG_ERROR("FATAL: object oid 0x%lx not in reference map", oid);
-        throw;
-    }
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+            return 2;
 
-    ObjectReferences[oid]--;
+        case SAI_OBJECT_TYPE_FDB:
+            return 3;
 
-    if (ObjectReferences[oid] < 0)
-    {
-        SWSS_LOG_ERROR("FATAL: object oid 0x%lx reference count is negative!", oid);
-        throw;
+        default:
+            return 0;
     }
-
-    SWSS_LOG_DEBUG("decreased reference on oid 0x%lx to %d", oid, ObjectReferences[oid]);
 }
 
-void object_reference_dec(
-        _In_ const sai_object_list_t& list)
+SaiObjectAttrHash& SaiObjectAttrDb::operator[](
+        _In_ const sai_object_meta_key_t& meta_key)
 {
     SWSS_LOG_ENTER();
 
-    for (uint32_t i = 0; i < list.count; ++i)
-    {
-        object_reference_dec(list.list[i]);
-    }
+    return m_shards[getShardIndex(meta_key.object_type)][meta_key];
 }
 
-void object_reference_inc(
-        _In_ const sai_object_list_t& list)
+bool SaiObjectAttrDb::exists(
+        _In_ const sai_object_meta_key_t& meta_key) const
 {
     SWSS_LOG_ENTER();
 
-    for (uint32_t i = 0; i < list.count; ++i)
-    {
-        object_reference_inc(list.list[i]);
-    }
+    const Shard& shard = m_shards[getShardIndex(meta_key.object_type)];
+
+    return shard.find(meta_key) != shard.end();
 }
 
-void object_reference_insert(
-        _In_ sai_object_id_t oid)
+const SaiObjectAttrHash* SaiObjectAttrDb::find(
+        _In_ const sai_object_meta_key_t& meta_key) const
 {
     SWSS_LOG_ENTER();
 
-    if (object_reference_exists(oid))
-    {
-        SWSS_LOG_ERROR("FATAL: object oid 0x%lx already in reference map", oid);
-        throw;
-    }
+    const Shard& shard = m_shards[getShardIndex(meta_key.object_type)];
 
-    ObjectReferences[oid] = 0;
+    auto it = shard.find(meta_key);
 
-    SWSS_LOG_DEBUG("inserted reference on 0x%lx", oid);
+    return (it == shard.end()) ? NULL : &it->second;
 }
 
-int32_t object_reference_count(
-        _In_ sai_object_id_t oid)
+size_t SaiObjectAttrDb::erase(
+        _In_ const sai_object_meta_key_t& meta_key)
 {
     SWSS_LOG_ENTER();
 
-    if (object_reference_exists(oid))
-    {
-        int32_t count = ObjectReferences[oid];
+    return m_shards[getShardIndex(meta_key.object_type)].erase(meta_key);
+}
 
-        SWSS_LOG_DEBUG("reference count on oid 0x%lx is %d", oid, count);
+size_t SaiObjectAttrDb::size() const
+{
+    SWSS_LOG_ENTER();
 
-        return count;
+    size_t size = 0;
+
+    for (size_t idx = 0; idx < META_DB_SHARD_COUNT; ++idx)
+    {
+        size += m_shards[idx].size();
     }
 
-    SWSS_LOG_ERROR("FATAL: object oid 0x%lx reference not in map", oid);
-    throw;
+    return size;
 }
 
-void object_reference_remove(
-        _In_ sai_object_id_t oid)
+void SaiObjectAttrDb::clear()
 {
     SWSS_LOG_ENTER();
 
-    if (object_reference_exists(oid))
+    for (size_t idx = 0; idx < META_DB_SHARD_COUNT; ++idx)
     {
-        int32_t count = object_reference_count(oid);
-
-        if (count > 0)
-        {
-            SWSS_LOG_ERROR("FATAL: removing object oid 0x%lx but reference count is: %d", oid, count);
-            throw;
-        }
+        m_shards[idx].clear();
     }
-
-    SWSS_LOG_DEBUG("removing object oid 0x%lx reference", oid);
-
-    ObjectReferences.erase(oid);
 }
 
-// VLAN REFERENCE FUNCTIONS
-
-bool vlan_reference_exists(
-        _In_ sai_vlan_id_t vlanid)
+const SaiObjectAttrDb::Shard& SaiObjectAttrDb::getShard(
+        _In_ size_t index) const
 {
     SWSS_LOG_ENTER();
 
-    bool exists = VlanReferences.find(vlanid) != VlanReferences.end();
+    return m_shards[index];
+}
 
-    SWSS_LOG_DEBUG("vlan %u refrence: %s", vlanid, exists ? "exists" : "missing");
+MetaRWLock& SaiObjectAttrDb::getShardLock(
+        _In_ sai_object_type_t object_type)
+{
+    SWSS_LOG_ENTER();
 
-    return exists;
+    return m_shardLocks[getShardIndex(object_type)];
+}
+
+MetaRWLock& SaiObjectAttrDb::getLock()
+{
+    SWSS_LOG_ENTER();
+
+    return m_lock;
+}
+
+MetaDbLockGuard::MetaDbLockGuard(
+        _In_ sai_object_type_t object_type,
+        _In_ bool write):
+    m_shardLock(NULL)
+{
+    SWSS_LOG_ENTER();
+
+    if (SaiObjectAttrDb::getShardIndex(object_type) == 0)
+    {
+        if (write)
+        {
+            ObjectAttrHash.getLock().lockWrite();
+        }
+        else
+        {
+            ObjectAttrHash.getLock().lockRead();
+        }
+
+        return;
+    }
+
+    ObjectAttrHash.getLock().lockRead();
+
+    m_shardLock = &ObjectAttrHash.getShardLock(object_type);
+
+    if (write)
+    {
+        m_shardLock->lockWrite();
+    }
+    else
+    {
+        m_shardLock->lockRead();
+    }
+}
+
+MetaDbLockGuard::~MetaDbLockGuard()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_shardLock != NULL)
+    {
+        m_shardLock->unlock();
+    }
+
+    ObjectAttrHash.getLock().unlock();
+}
+
+// GENERIC REFERENCE FUNCTIONS
+
+bool object_reference_exists(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    bool exists = ObjectReferences.find(oid) != ObjectReferences.end();
+
+    SWSS_LOG_DEBUG("object 0x%lx refrence: %s", oid, exists ? "exists" : "missing");
+
+    return exists;
+}
+
+void object_reference_inc(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    if (oid == SAI_NULL_OBJECT_ID)
+    {
+        return;
+    }
+
+    if (!object_reference_exists(oid))
+    {
+        SWSS_LOG_ERROR("FATAL: object oid 0x%lx not in reference map", oid);
+        throw;
+    }
+
+    ObjectReferences[oid]++;
+
+    SWSS_LOG_DEBUG("increased reference on oid 0x%lx to %d", oid, ObjectReferences[oid]);
+}
+
+void object_reference_dec(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    if (oid == SAI_NULL_OBJECT_ID)
+    {
+        return;
+    }
+
+    if (!object_reference_exists(oid))
+    {
+        SWSS_LOG_ERROR("FATAL: object oid 0x%lx not in reference map", oid);
+        throw;
+    }
+
+    ObjectReferences[oid]--;
+
+    if (ObjectReferences[oid] < 0)
+    {
+        SWSS_LOG_ERROR("FATAL: object oid 0x%lx reference count is negative!", oid);
+        throw;
+    }
+
+    SWSS_LOG_DEBUG("decreased reference on oid 0x%lx to %d", oid, ObjectReferences[oid]);
+}
+
+void object_reference_dec(
+        _In_ const sai_object_list_t& list)
+{
+    SWSS_LOG_ENTER();
+
+    for (uint32_t i = 0; i < list.count; ++i)
+    {
+        object_reference_dec(list.list[i]);
+    }
+}
+
+void object_reference_inc(
+        _In_ const sai_object_list_t& list)
+{
+    SWSS_LOG_ENTER();
+
+    for (uint32_t i = 0; i < list.count; ++i)
+    {
+        object_reference_inc(list.list[i]);
+    }
+}
+
+void object_reference_insert(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    if (object_reference_exists(oid))
+    {
+        SWSS_LOG_ERROR("FATAL: object oid 0x%lx already in reference map", oid);
+        throw;
+    }
+
+    ObjectReferences[oid] = 0;
+
+    SWSS_LOG_DEBUG("inserted reference on 0x%lx", oid);
+}
+
+int32_t object_reference_count(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    if (object_reference_exists(oid))
+    {
+        int32_t count = ObjectReferences[oid];
+
+        SWSS_LOG_DEBUG("reference count on oid 0x%lx is %d", oid, count);
+
+        return count;
+    }
+
+    SWSS_LOG_ERROR("FATAL: object oid 0x%lx reference not in map", oid);
+    throw;
+}
+
+void object_reference_remove(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    if (object_reference_exists(oid))
+    {
+        int32_t count = object_reference_count(oid);
+
+        if (count > 0)
+        {
+            SWSS_LOG_ERROR("FATAL: removing object oid 0x%lx but reference count is: %d", oid, count);
+            throw;
+        }
+    }
+
+    SWSS_LOG_DEBUG("removing object oid 0x%lx reference", oid);
+
+    ObjectReferences.erase(oid);
+    ObjectReverseReferences.erase(oid);
+}
+
+// REVERSE REFERENCE FUNCTIONS
+
+void object_reference_inc(
+        _In_ sai_object_id_t oid,
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ sai_attr_id_t attr_id)
+{
+    SWSS_LOG_ENTER();
+
+    if (oid == SAI_NULL_OBJECT_ID)
+    {
+        return;
+    }
+
+    object_reference_inc(oid);
+
+    ObjectReverseReferences[oid][meta_key][attr_id]++;
+}
+
+void object_reference_dec(
+        _In_ sai_object_id_t oid,
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ sai_attr_id_t attr_id)
+{
+    SWSS_LOG_ENTER();
+
+    if (oid == SAI_NULL_OBJECT_ID)
+    {
+        return;
+    }
+
+    object_reference_dec(oid);
+
+    auto it = ObjectReverseReferences.find(oid);
+
+    if (it == ObjectReverseReferences.end())
+    {
+        SWSS_LOG_ERROR("FATAL: object oid 0x%lx not in reverse reference map", oid);
+        throw;
+    }
+
+    auto itk = it->second.find(meta_key);
+
+    if (itk == it->second.end() || itk->second.find(attr_id) == itk->second.end())
+    {
+        SWSS_LOG_ERROR("FATAL: object oid 0x%lx reverse reference from %s attr %d not found",
+                oid, get_object_meta_key_string(meta_key).c_str(), attr_id);
+        throw;
+    }
+
+    if (--itk->second[attr_id] == 0)
+    {
+        itk->second.erase(attr_id);
+
+        if (itk->second.empty())
+        {
+            it->second.erase(itk);
+        }
+
+        if (it->second.empty())
+        {
+            ObjectReverseReferences.erase(it);
+        }
+    }
+}
+
+void object_reference_inc(
+        _In_ const sai_object_list_t& list,
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ sai_attr_id_t attr_id)
+{
+    SWSS_LOG_ENTER();
+
+    for (uint32_t i = 0; i < list.count; ++i)
+    {
+        object_reference_inc(list.list[i], meta_key, attr_id);
+    }
+}
+
+void object_reference_dec(
+        _In_ const sai_object_list_t& list,
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ sai_attr_id_t attr_id)
+{
+    SWSS_LOG_ENTER();
+
+    for (uint32_t i = 0; i < list.count; ++i)
+    {
+        object_reference_dec(list.list[i], meta_key, attr_id);
+    }
+}
+
+std::vector<sai_object_meta_reference_t> get_object_references(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<sai_object_meta_reference_t> refs;
+
+    auto it = ObjectReverseReferences.find(oid);
+
+    if (it == ObjectReverseReferences.end())
+    {
+        return refs;
+    }
+
+    for (const auto& obj: it->second)
+    {
+        for (const auto& attr: obj.second)
+        {
+            sai_object_meta_reference_t ref;
+
+            ref.meta_key = obj.first;
+            ref.attr_id = attr.first;
+            ref.count = attr.second;
+
+            refs.push_back(ref);
+        }
+    }
+
+    return refs;
+}
+
+std::string get_object_references_string(
+        _In_ sai_object_id_t oid,
+        _In_ size_t max_count)
+{
+    SWSS_LOG_ENTER();
+
+    auto refs = get_object_references(oid);
+
+    std::string str;
+
+    for (size_t idx = 0; idx < refs.size() && idx < max_count; ++idx)
+    {
+        const auto& ref = refs[idx];
+
+        if (idx != 0)
+        {
+            str += ", ";
+        }
+
+        str += get_object_type_name(ref.meta_key.object_type);
+        str += " ";
+        str += get_object_meta_key_string(ref.meta_key);
+        str += " ";
+        str += (ref.attr_id == META_REFERENCE_KEY_ATTR_ID) ? "key" : get_attr_name(ref.meta_key.object_type, ref.attr_id);
+
+        if (ref.count > 1)
+        {
+            str += " x" + std::to_string(ref.count);
+        }
+    }
+
+    if (refs.size() > max_count)
+    {
+        str += ", ... (" + std::to_string(refs.size()) + " total)";
+    }
+
+    return str;
+}
+
+std::vector<sai_object_meta_reference_t> meta_get_object_references(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NULL, true);
+
+    return get_object_references(oid);
+}
+
+std::string meta_get_object_references_string(
+        _In_ sai_object_id_t oid,
+        _In_ size_t max_count)
+{
+    SWSS_LOG_ENTER();
+
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NULL, true);
+
+    return get_object_references_string(oid, max_count);
+}
+
+// VLAN REFERENCE FUNCTIONS
+
+bool vlan_reference_exists(
+        _In_ sai_vlan_id_t vlanid)
+{
+    SWSS_LOG_ENTER();
+
+    bool exists = VlanReferences.find(vlanid) != VlanReferences.end();
+
+    SWSS_LOG_DEBUG("vlan %u refrence: %s", vlanid, exists ? "exists" : "missing");
+
+    return exists;
 }
 
 void vlan_reference_inc(
@@ -606,31 +1187,19 @@ void vlan_reference_remove(
 }
 
 bool object_exists(
-        _In_ const std::string& key)
-{
-    SWSS_LOG_ENTER();
-
-    bool exists = ObjectAttrHash.find(key) != ObjectAttrHash.end();
-
-    SWSS_LOG_DEBUG("%s %s", key.c_str(), exists ? "exists" : "missing");
-
-    return exists;
-}
-
-bool object_exists(
-        _In_ const sai_object_meta_key_t meta_key)
+        _In_ const sai_object_meta_key_t& meta_key)
 {
     SWSS_LOG_ENTER();
 
-    std::string key = get_object_meta_key_string(meta_key);
-
-    return object_exists(key);
+    return ObjectAttrHash.exists(meta_key);
 }
 
 sai_status_t meta_init_db()
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NULL, true);
+
     meta_init();
 
     // we need local db to keep track if
@@ -639,25 +1208,23 @@ sai_status_t meta_init_db()
     // condition is in force
 
     ObjectReferences.clear();
+    ObjectReverseReferences.clear();
     VlanReferences.clear();
     ObjectAttrHash.clear();
     AttributeKeys.clear();
+    AttributeKeysObjects.clear();
 
     // init switch
 
     sai_object_meta_key_t meta_key = { .object_type = SAI_OBJECT_TYPE_SWITCH, .key = { } };
 
-    std::string switch_key = get_object_meta_key_string(meta_key);
-
-    ObjectAttrHash[switch_key] = { };
+    ObjectAttrHash[meta_key] = { };
 
     // init default vlan
 
     sai_object_meta_key_t meta_key_vlan = { .object_type = SAI_OBJECT_TYPE_VLAN, .key = { .vlan_id = DEFAULT_VLAN_NUMBER } };
 
-    std::string vlan_key = get_object_meta_key_string(meta_key_vlan);
-
-    ObjectAttrHash[vlan_key] = { };
+    ObjectAttrHash[meta_key_vlan] = { };
 
     vlan_reference_insert(DEFAULT_VLAN_NUMBER);
     vlan_reference_inc(DEFAULT_VLAN_NUMBER);
@@ -668,9 +1235,7 @@ sai_status_t meta_init_db()
     {
         sai_object_meta_key_t meta_key_trap = { .object_type = SAI_OBJECT_TYPE_TRAP, .key = { .trap_id = (sai_hostif_trap_id_t)trap } };
 
-        std::string trap_key = get_object_meta_key_string(meta_key_trap);
-
-        ObjectAttrHash[trap_key] = { };
+        ObjectAttrHash[meta_key_trap] = { };
 
         // not need for now creating trap references since
         // in this SAI all traps are created by default
@@ -699,20 +1264,18 @@ const sai_attribute_t* get_object_previous_attr(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = get_object_meta_key_string(meta_key);
-
-    auto it = ObjectAttrHash.find(key);
+    auto hash = ObjectAttrHash.find(meta_key);
 
-    if (it == ObjectAttrHash.end())
+    if (hash == NULL)
     {
-        SWSS_LOG_ERROR("object key %s not found", key.c_str());
+        SWSS_LOG_ERROR("object key %s not found", get_object_meta_key_string(meta_key).c_str());
 
         return NULL;
     }
 
-    auto ita = it->second.find(md.attrid);
+    auto ita = hash->find(md.attrid);
 
-    if (ita == it->second.end())
+    if (ita == hash->end())
     {
         // attribute id not found
         return NULL;
@@ -724,6 +1287,71 @@ const sai_attribute_t* get_object_previous_attr(
     return ita->second->getattr();
 }
 
+// COMPACT MODE
+
+std::atomic<bool> CompactMode(false);
+
+void meta_set_compact_mode(
+        _In_ bool enable)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("setting meta db compact mode to %s", enable ? "true" : "false");
+
+    CompactMode = enable;
+}
+
+bool meta_get_compact_mode()
+{
+    SWSS_LOG_ENTER();
+
+    return CompactMode;
+}
+
+bool is_compact_attr_default(
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ const sai_attr_metadata_t& md,
+        _In_ const sai_attribute_t& attr)
+{
+    SWSS_LOG_ENTER();
+
+    if (!CompactMode)
+    {
+        return false;
+    }
+
+    switch (meta_key.object_type)
+    {
+        case SAI_OBJECT_TYPE_ROUTE:
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+        case SAI_OBJECT_TYPE_FDB:
+            break;
+
+        default:
+            return false;
+    }
+
+    // conditional attributes must be present in local db for set/get
+    // validation and object ids are needed when decreasing references
+
+    if (md.isconditional() || is_object_id_serialization_type(md.serializationtype))
+    {
+        return false;
+    }
+
+    if (md.defaultvaluetype != SAI_DEFAULT_VALUE_TYPE_CONST)
+    {
+        return false;
+    }
+
+    sai_attribute_t defattr;
+
+    defattr.id = md.attrid;
+    defattr.value = md.defaultvalue;
+
+    return sai_compare_attr_value(md, attr, defattr);
+}
+
 void set_object(
         _In_ const sai_object_meta_key_t meta_key,
         _In_ const sai_attr_metadata_t& md,
@@ -731,78 +1359,285 @@ void set_object(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = get_object_meta_key_string(meta_key);
+    if (!object_exists(meta_key))
+    {
+        std::string key = get_object_meta_key_string(meta_key);
+
+        SWSS_LOG_ERROR("FATAL: object %s doesn't exist", key.c_str());
+        throw std::runtime_error("FATAL: object doesn't exist" + key);
+    }
+
+    if (is_compact_attr_default(meta_key, md, *attr))
+    {
+        META_LOG_DEBUG(md, "attribute %d on %s is default, not stored", attr->id, get_object_type_name(meta_key.object_type));
+
+        ObjectAttrHash[meta_key].erase(attr->id);
+
+        return;
+    }
+
+    META_LOG_DEBUG(md, "set attribute %d on %s", attr->id, get_object_type_name(meta_key.object_type));
+
+    auto p = new SaiAttrWrapper(&md,*attr);
+
+    ObjectAttrHash[meta_key][attr->id] = std::shared_ptr<SaiAttrWrapper>(p);
+}
+
+const std::vector<std::shared_ptr<SaiAttrWrapper>> get_object(
+        _In_ const sai_object_meta_key_t meta_key)
+{
+    if (!object_exists(meta_key))
+    {
+        SWSS_LOG_ERROR("FATAL: object %s doesn't exist", get_object_meta_key_string(meta_key).c_str());
+        throw;
+    }
+
+    std::vector<std::shared_ptr<SaiAttrWrapper>> attrs;
+
+    const auto& hash = *ObjectAttrHash.find(meta_key);
+
+    for (auto it = hash.begin(); it != hash.end(); ++it)
+    {
+        attrs.push_back(it->second);
+    }
+
+    return attrs;
+}
+
+void remove_object(
+        _In_ const sai_object_meta_key_t meta_key)
+{
+    SWSS_LOG_ENTER();
+
+    if (!object_exists(meta_key))
+    {
+        SWSS_LOG_ERROR("FATAL: object %s doesn't exist", get_object_meta_key_string(meta_key).c_str());
+        throw;
+    }
+
+    SWSS_LOG_DEBUG("removing object %s", get_object_type_name(meta_key.object_type));
+
+    ObjectAttrHash.erase(meta_key);
+}
+
+void create_object(
+        _In_ const sai_object_meta_key_t& meta_key)
+{
+    SWSS_LOG_ENTER();
+
+    if (object_exists(meta_key))
+    {
+        SWSS_LOG_ERROR("FATAL: object %s already exists", get_object_meta_key_string(meta_key).c_str());
+        throw;
+    }
+
+    SWSS_LOG_DEBUG("creating object %s", get_object_type_name(meta_key.object_type));
+
+    ObjectAttrHash[meta_key] = {};
+}
+
+// DB STATISTICS
+
+template <typename K, typename V>
+size_t get_hash_node_size()
+{
+    // value, next pointer and cached hash code
+    return sizeof(std::pair<const K,V>) + sizeof(void*) + sizeof(size_t);
+}
+
+template <typename T>
+size_t get_hash_bytes(
+        _In_ const T& hash)
+{
+    return sizeof(hash) +
+        hash.bucket_count() * sizeof(void*) +
+        hash.size() * get_hash_node_size<typename T::key_type, typename T::mapped_type>();
+}
+
+size_t get_attr_value_list_bytes(
+        _In_ const sai_attr_metadata_t& md,
+        _In_ const sai_attribute_t& attr)
+{
+    SWSS_LOG_ENTER();
+
+    const sai_attribute_value_t& value = attr.value;
+
+    switch (md.serializationtype)
+    {
+        case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
+            return value.objlist.count * sizeof(sai_object_id_t);
+
+        case SAI_SERIALIZATION_TYPE_UINT8_LIST:
+        case SAI_SERIALIZATION_TYPE_INT8_LIST:
+            return value.u8list.count * sizeof(uint8_t);
+
+        case SAI_SERIALIZATION_TYPE_UINT16_LIST:
+        case SAI_SERIALIZATION_TYPE_INT16_LIST:
+            return value.u16list.count * sizeof(uint16_t);
+
+        case SAI_SERIALIZATION_TYPE_UINT32_LIST:
+        case SAI_SERIALIZATION_TYPE_INT32_LIST:
+            return value.u32list.count * sizeof(uint32_t);
+
+        case SAI_SERIALIZATION_TYPE_VLAN_LIST:
+            return value.vlanlist.count * sizeof(sai_vlan_id_t);
+
+        case SAI_SERIALIZATION_TYPE_QOS_MAP_LIST:
+            return value.qosmap.count * sizeof(sai_qos_map_t);
+
+        case SAI_SERIALIZATION_TYPE_TUNNEL_MAP_LIST:
+            return value.tunnelmap.count * sizeof(sai_tunnel_map_t);
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            return value.aclfield.enable ? value.aclfield.data.objlist.count * sizeof(sai_object_id_t) : 0;
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_UINT8_LIST:
+            return value.aclfield.enable ? (value.aclfield.data.u8list.count + value.aclfield.mask.u8list.count) : 0;
+
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            return value.aclaction.enable ? value.aclaction.parameter.objlist.count * sizeof(sai_object_id_t) : 0;
+
+        default:
+            return 0;
+    }
+}
+
+sai_meta_db_statistics_t meta_get_db_statistics()
+{
+    SWSS_LOG_ENTER();
+
+    sai_meta_db_statistics_t stats = { };
 
-    if (!object_exists(key))
-    {
-        SWSS_LOG_ERROR("FATAL: object %s doesn't exist", key.c_str());
-        throw std::runtime_error("FATAL: object doesn't exist" + key);
-    }
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NULL, true);
 
-    META_LOG_DEBUG(md, "set attribute %d on %s", attr->id, key.c_str());
+    const size_t objectnode = get_hash_node_size<sai_object_meta_key_t, SaiObjectAttrHash>();
 
-    auto p = new SaiAttrWrapper(&md,*attr);
+    // hash node, shared pointer control block and wrapper itself
 
-    ObjectAttrHash[key][attr->id] = std::shared_ptr<SaiAttrWrapper>(p);
-}
+    const size_t attrnode = get_hash_node_size<sai_attr_id_t, std::shared_ptr<SaiAttrWrapper>>() +
+        2 * sizeof(long) + sizeof(void*) +
+        sizeof(SaiAttrWrapper);
 
-const std::vector<std::shared_ptr<SaiAttrWrapper>> get_object(
-        _In_ const sai_object_meta_key_t meta_key)
-{
-    std::string key = get_object_meta_key_string(meta_key);
+    size_t buckets = 0;
 
-    if (!object_exists(key))
+    for (size_t idx = 0; idx < META_DB_SHARD_COUNT; ++idx)
     {
-        SWSS_LOG_ERROR("FATAL: object %s doesn't exist", key.c_str());
-        throw;
-    }
+        const auto& shard = ObjectAttrHash.getShard(idx);
 
-    std::vector<std::shared_ptr<SaiAttrWrapper>> attrs;
+        stats.bytes += sizeof(shard) + shard.bucket_count() * sizeof(void*);
 
-    const auto& hash = ObjectAttrHash[key];
+        buckets += shard.bucket_count();
 
-    for (auto it = hash.begin(); it != hash.end(); ++it)
-    {
-        attrs.push_back(it->second);
+        for (const auto& obj: shard)
+        {
+            auto& ots = stats.objecttypes[obj.first.object_type];
+
+            size_t objbytes = objectnode + obj.second.bucket_count() * sizeof(void*);
+
+            for (const auto& a: obj.second)
+            {
+                const sai_attribute_t& attr = *a.second->getattr();
+
+                auto md = get_attribute_metadata(obj.first.object_type, attr.id);
+
+                size_t bytes = attrnode + (md ? get_attr_value_list_bytes(*md, attr) : 0);
+
+                auto& as = ots.attributes[attr.id];
+
+                as.count++;
+                as.bytes += bytes;
+
+                objbytes += bytes;
+            }
+
+            ots.objects++;
+            ots.bytes += objbytes;
+
+            stats.objects++;
+            stats.attributes += obj.second.size();
+            stats.bytes += objbytes;
+        }
     }
 
-    return attrs;
-}
+    stats.references = ObjectReferences.size() + VlanReferences.size();
+    stats.referencesbytes = get_hash_bytes(ObjectReferences) + get_hash_bytes(VlanReferences);
 
-void remove_object(
-        _In_ const sai_object_meta_key_t meta_key)
-{
-    SWSS_LOG_ENTER();
+    for (const auto& rr: ObjectReverseReferences)
+    {
+        // reverse index node, referencing objects and attribute map nodes
+        stats.referencesbytes += get_hash_node_size<sai_object_id_t, decltype(rr.second)>() +
+            get_hash_bytes(rr.second);
+
+        for (const auto& obj: rr.second)
+        {
+            stats.referencesbytes += obj.second.size() * (sizeof(std::pair<const sai_attr_id_t,uint32_t>) + 4 * sizeof(void*));
+        }
+    }
 
-    std::string key = get_object_meta_key_string(meta_key);
+    stats.attributekeys = AttributeKeys.size();
+    stats.attributekeysbytes = get_hash_bytes(AttributeKeys) + get_hash_bytes(AttributeKeysObjects);
 
-    if (!object_exists(key))
+    for (const auto& ak: AttributeKeys)
     {
-        SWSS_LOG_ERROR("FATAL: object %s doesn't exist", key.c_str());
-        throw;
+        // key string is kept in both directions
+        stats.attributekeysbytes += 2 * ak.second.capacity();
     }
 
-    SWSS_LOG_DEBUG("removing object %s", key.c_str());
+    stats.objectsloadfactor = buckets ? (float)stats.objects / (float)buckets : 0;
+    stats.referencesloadfactor = ObjectReferences.load_factor();
+    stats.attributekeysloadfactor = AttributeKeys.load_factor();
 
-    ObjectAttrHash.erase(key);
+    return stats;
 }
 
-void create_object(
-        _In_ const sai_object_meta_key_t& meta_key)
+std::string meta_serialize_db_statistics(
+        _In_ const sai_meta_db_statistics_t& stats)
 {
     SWSS_LOG_ENTER();
 
-    std::string key = get_object_meta_key_string(meta_key);
+    json j;
 
-    if (object_exists(key))
+    j["objects"] = stats.objects;
+    j["attributes"] = stats.attributes;
+    j["bytes"] = stats.bytes;
+    j["references"] = stats.references;
+    j["references_bytes"] = stats.referencesbytes;
+    j["attribute_keys"] = stats.attributekeys;
+    j["attribute_keys_bytes"] = stats.attributekeysbytes;
+    j["objects_load_factor"] = stats.objectsloadfactor;
+    j["references_load_factor"] = stats.referencesloadfactor;
+    j["attribute_keys_load_factor"] = stats.attributekeysloadfactor;
+    j["compact_mode"] = CompactMode.load();
+
+    json ots = json::object();
+
+    for (const auto& ot: stats.objecttypes)
     {
-        SWSS_LOG_ERROR("FATAL: object %s already exists", key.c_str());
-        throw;
+        json o;
+
+        o["objects"] = ot.second.objects;
+        o["bytes"] = ot.second.bytes;
+
+        json attrs = json::object();
+
+        for (const auto& a: ot.second.attributes)
+        {
+            json aj;
+
+            aj["count"] = a.second.count;
+            aj["bytes"] = a.second.bytes;
+
+            attrs[get_attr_name(ot.first, a.first)] = aj;
+        }
+
+        o["attributes"] = attrs;
+
+        ots[get_object_type_name(ot.first)] = o;
     }
 
-    SWSS_LOG_DEBUG("creating object %s", key.c_str());
+    j["object_types"] = ots;
 
-    ObjectAttrHash[key] = {};
+    return j.dump();
 }
 
 sai_status_t meta_generic_validation_objlist(
@@ -831,6 +1666,8 @@ sai_status_t meta_generic_validation_objlist(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    std::lock_guard<std::mutex> lock(ReferencesMutex);
+
     std::set<sai_object_id_t> oids;
 
     sai_object_type_t object_type = SAI_OBJECT_TYPE_NULL;
@@ -973,18 +1810,25 @@ std::string construct_key(
         {
             case SAI_SERIALIZATION_TYPE_UINT32_LIST: // only for port
 
-                // TODO this list should be sorted
-                for (uint32_t i = 0; i < value.u32list.count; ++i)
                 {
-                    name += std::to_string(value.u32list.list[i]);
+                    // list is sorted, so the same lanes in different order give the same key
+
+                    std::vector<uint32_t> list(value.u32list.list, value.u32list.list + value.u32list.count);
 
-                    if (i != value.u32list.count - 1)
+                    std::sort(list.begin(), list.end());
+
+                    for (size_t i = 0; i < list.size(); ++i)
                     {
-                        name += ",";
+                        name += std::to_string(list[i]);
+
+                        if (i != list.size() - 1)
+                        {
+                            name += ",";
+                        }
                     }
-                }
 
-                break;
+                    break;
+                }
 
             case SAI_SERIALIZATION_TYPE_INT32:
                 name += std::to_string(value.s32); // if enum then get enum name?
@@ -1380,6 +2224,8 @@ sai_status_t meta_generic_validation_create(
 
         if (md.isvlan())
         {
+            std::lock_guard<std::mutex> lock(ReferencesMutex);
+
             if (!vlan_reference_exists(value.u16))
             {
                 SWSS_LOG_ERROR("vlan %d is missing", value.u16);
@@ -1404,11 +2250,9 @@ sai_status_t meta_generic_validation_create(
 
             {
                 // just sanity check if object already exists
-                std::string key = get_object_meta_key_string(meta_key);
-
-                if (object_exists(key))
+                if (object_exists(meta_key))
                 {
-                    SWSS_LOG_ERROR("object key %s already exists", key.c_str());
+                    SWSS_LOG_ERROR("object key %s already exists", get_object_meta_key_string(meta_key).c_str());
 
                     return SAI_STATUS_ITEM_ALREADY_EXISTS;
                 }
@@ -1430,23 +2274,14 @@ sai_status_t meta_generic_validation_create(
         return SAI_STATUS_FAILURE;
     }
 
-    // check if all mandatory attrributes were passed
+    const auto& t = *get_object_type_attr_metadata(meta_key.object_type);
 
-    for (auto mdp: metadata)
+    // check if all mandatory attrributes were passed, conditional are not on this list
+
+    for (auto mdp: t.mandatoryoncreate)
     {
         const sai_attr_metadata_t& md = *mdp;
 
-        if (!HAS_FLAG_MANDATORY_ON_CREATE(md.flags))
-        {
-            continue;
-        }
-
-        if (md.isconditional())
-        {
-            // skip conditional attributes for now
-            continue;
-        }
-
         const auto &it = attrs.find(md.attrid);
 
         if (it == attrs.end())
@@ -1458,15 +2293,10 @@ sai_status_t meta_generic_validation_create(
     }
 
     // check if we need any conditional attributes
-    for (auto mdp: metadata)
+    for (auto mdp: t.conditional)
     {
         const sai_attr_metadata_t& md = *mdp;
 
-        if (!md.isconditional())
-        {
-            continue;
-        }
-
         // this is conditional attribute, check if it's required
 
         bool any = false;
@@ -1554,16 +2384,15 @@ sai_status_t meta_generic_validation_create(
     {
         std::string key = construct_key(meta_key, attr_count, attr_list);
 
-        for (auto& it: AttributeKeys)
-        {
-            // since we didn't created oid yet, we don't know if attribute key exists, check all
+        // since we didn't created oid yet, we don't know if attribute key exists, check index
 
-            if (it.second == key)
-            {
-                SWSS_LOG_ERROR("attribute key %s already exists, can't create", key.c_str());
+        std::lock_guard<std::mutex> lock(ReferencesMutex);
 
-                return SAI_STATUS_INVALID_PARAMETER;
-            }
+        if (AttributeKeysObjects.find(key) != AttributeKeysObjects.end())
+        {
+            SWSS_LOG_ERROR("attribute key %s already exists, can't create", key.c_str());
+
+            return SAI_STATUS_INVALID_PARAMETER;
         }
     }
 
@@ -1575,11 +2404,9 @@ sai_status_t meta_generic_validation_remove(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = get_object_meta_key_string(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -1605,6 +2432,8 @@ sai_status_t meta_generic_validation_remove(
             {
                 sai_vlan_id_t vlan_id = meta_key.key.vlan_id;
 
+                std::lock_guard<std::mutex> lock(ReferencesMutex);
+
                 if (!vlan_reference_exists(vlan_id))
                 {
                     SWSS_LOG_ERROR("vlan %u reference doesn't exist", vlan_id);
@@ -1661,6 +2490,8 @@ sai_status_t meta_generic_validation_remove(
                     return SAI_STATUS_INVALID_PARAMETER;
                 }
 
+                std::lock_guard<std::mutex> lock(ReferencesMutex);
+
                 if (!object_reference_exists(oid))
                 {
                     SWSS_LOG_ERROR("object 0x%lx reference doesn't exist", oid);
@@ -1674,6 +2505,8 @@ sai_status_t meta_generic_validation_remove(
                 {
                     SWSS_LOG_ERROR("object 0x%lx reference count is %d, can't remove", oid, count);
 
+                    SWSS_LOG_ERROR("object 0x%lx is referenced by: %s", oid, get_object_references_string(oid, META_REFERENCES_LOG_MAX_COUNT).c_str());
+
                     return SAI_STATUS_INVALID_PARAMETER;
                 }
 
@@ -1997,6 +2830,8 @@ sai_status_t meta_generic_validation_set(
 
     if (md.isvlan())
     {
+        std::lock_guard<std::mutex> lock(ReferencesMutex);
+
         if (!vlan_reference_exists(value.u16))
         {
             SWSS_LOG_ERROR("vlan %d is missing", value.u16);
@@ -2021,11 +2856,9 @@ sai_status_t meta_generic_validation_set(
 
     // check if object on which we perform operation exists
 
-    std::string key = get_object_meta_key_string(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        META_LOG_ERROR(md, "object key %s doesn't exist", key.c_str());
+        META_LOG_ERROR(md, "object key %s doesn't exist", get_object_meta_key_string(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -2041,7 +2874,7 @@ sai_status_t meta_generic_validation_set(
         case SAI_OBJECT_TYPE_VLAN:
         case SAI_OBJECT_TYPE_TRAP:
 
-            SWSS_LOG_DEBUG("object key exists: %s", key.c_str());
+            SWSS_LOG_DEBUG("object key exists: %s", get_object_type_name(meta_key.object_type));
             break;
 
         default:
@@ -2277,11 +3110,9 @@ sai_status_t meta_generic_validation_get(
         }
     }
 
-    std::string key = get_object_meta_key_string(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -2295,7 +3126,7 @@ sai_status_t meta_generic_validation_get(
         case SAI_OBJECT_TYPE_VLAN:
         case SAI_OBJECT_TYPE_TRAP:
 
-            SWSS_LOG_DEBUG("object key exists: %s", key.c_str());
+            SWSS_LOG_DEBUG("object key exists: %s", get_object_type_name(meta_key.object_type));
 
             break;
 
@@ -2339,11 +3170,11 @@ void meta_generic_validation_post_create(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = get_object_meta_key_string(meta_key);
+    std::lock_guard<std::mutex> lock(ReferencesMutex);
 
-    if (object_exists(key))
+    if (object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s already exists (vendor bug?)", key.c_str());
+        SWSS_LOG_ERROR("object key %s already exists (vendor bug?)", get_object_meta_key_string(meta_key).c_str());
 
         // this may produce inconsistency
     }
@@ -2353,11 +3184,11 @@ void meta_generic_validation_post_create(
     switch (meta_key.object_type)
     {
         case SAI_OBJECT_TYPE_ROUTE:
-            object_reference_inc(meta_key.key.route_entry.vr_id);
+            object_reference_inc(meta_key.key.route_entry.vr_id, meta_key, META_REFERENCE_KEY_ATTR_ID);
             break;
 
         case SAI_OBJECT_TYPE_NEIGHBOR:
-            object_reference_inc(meta_key.key.neighbor_entry.rif_id);
+            object_reference_inc(meta_key.key.neighbor_entry.rif_id, meta_key, META_REFERENCE_KEY_ATTR_ID);
             break;
 
         case SAI_OBJECT_TYPE_FDB:
@@ -2448,11 +3279,11 @@ void meta_generic_validation_post_create(
                 break;
 
             case SAI_SERIALIZATION_TYPE_OBJECT_ID:
-                object_reference_inc(value.oid);
+                object_reference_inc(value.oid, meta_key, md.attrid);
                 break;
 
             case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
-                object_reference_inc(value.objlist);
+                object_reference_inc(value.objlist, meta_key, md.attrid);
                 break;
 
             case SAI_SERIALIZATION_TYPE_VLAN_LIST:
@@ -2474,11 +3305,11 @@ void meta_generic_validation_post_create(
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
-                object_reference_inc(value.aclfield.data.oid);
+                object_reference_inc(value.aclfield.data.oid, meta_key, md.attrid);
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
-                object_reference_inc(value.aclfield.data.objlist);
+                object_reference_inc(value.aclfield.data.objlist, meta_key, md.attrid);
                 break;
 
                 // case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_UINT8_LIST:
@@ -2498,11 +3329,11 @@ void meta_generic_validation_post_create(
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
-                object_reference_inc(value.aclaction.parameter.oid);
+                object_reference_inc(value.aclaction.parameter.oid, meta_key, md.attrid);
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-                object_reference_inc(value.aclaction.parameter.objlist);
+                object_reference_inc(value.aclaction.parameter.objlist, meta_key, md.attrid);
                 break;
 
                 // ACL END
@@ -2536,9 +3367,10 @@ void meta_generic_validation_post_create(
 
     if (haskeys)
     {
-        std::string ok = get_object_meta_key_string(meta_key);
+        std::string key = construct_key(meta_key, attr_count, attr_list);
 
-        AttributeKeys[ok] = construct_key(meta_key, attr_count, attr_list);
+        AttributeKeys[meta_key] = key;
+        AttributeKeysObjects[key] = meta_key;
     }
 }
 
@@ -2547,6 +3379,8 @@ void meta_generic_validation_post_remove(
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::mutex> lock(ReferencesMutex);
+
     // get all attributes that was set
 
     for (auto&it: get_object(meta_key))
@@ -2581,11 +3415,11 @@ void meta_generic_validation_post_remove(
                 break;
 
             case SAI_SERIALIZATION_TYPE_OBJECT_ID:
-                object_reference_dec(value.oid);
+                object_reference_dec(value.oid, meta_key, md.attrid);
                 break;
 
             case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
-                object_reference_dec(value.objlist);
+                object_reference_dec(value.objlist, meta_key, md.attrid);
                 break;
 
                 //case SAI_SERIALIZATION_TYPE_VLAN_LIST:
@@ -2606,11 +3440,11 @@ void meta_generic_validation_post_remove(
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
-                object_reference_dec(value.aclfield.data.oid);
+                object_reference_dec(value.aclfield.data.oid, meta_key, md.attrid);
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
-                object_reference_dec(value.aclfield.data.objlist);
+                object_reference_dec(value.aclfield.data.objlist, meta_key, md.attrid);
                 break;
 
                 // case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_UINT8_LIST:
@@ -2629,11 +3463,11 @@ void meta_generic_validation_post_remove(
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
-                object_reference_dec(value.aclaction.parameter.oid);
+                object_reference_dec(value.aclaction.parameter.oid, meta_key, md.attrid);
                 break;
 
             case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-                object_reference_dec(value.aclaction.parameter.objlist);
+                object_reference_dec(value.aclaction.parameter.objlist, meta_key, md.attrid);
                 break;
 
                 // ACL END
@@ -2672,11 +3506,11 @@ void meta_generic_validation_post_remove(
             throw;
 
         case SAI_OBJECT_TYPE_ROUTE:
-            object_reference_dec(meta_key.key.route_entry.vr_id);
+            object_reference_dec(meta_key.key.route_entry.vr_id, meta_key, META_REFERENCE_KEY_ATTR_ID);
             break;
 
         case SAI_OBJECT_TYPE_NEIGHBOR:
-            object_reference_dec(meta_key.key.neighbor_entry.rif_id);
+            object_reference_dec(meta_key.key.neighbor_entry.rif_id, meta_key, META_REFERENCE_KEY_ATTR_ID);
             break;
 
         case SAI_OBJECT_TYPE_FDB:
@@ -2699,13 +3533,15 @@ void meta_generic_validation_post_remove(
 
     remove_object(meta_key);
 
-    std::string ok = get_object_meta_key_string(meta_key);
+    auto it = AttributeKeys.find(meta_key);
 
-    if (AttributeKeys.find(ok) != AttributeKeys.end())
+    if (it != AttributeKeys.end())
     {
-        SWSS_LOG_DEBUG("erasing attributes key %s", AttributeKeys[ok].c_str());
+        SWSS_LOG_DEBUG("erasing attributes key %s", it->second.c_str());
 
-        AttributeKeys.erase(ok);
+        AttributeKeysObjects.erase(it->second);
+
+        AttributeKeys.erase(it);
     }
 }
 
@@ -2715,6 +3551,8 @@ void meta_generic_validation_post_set(
 {
     SWSS_LOG_ENTER();
 
+    std::lock_guard<std::mutex> lock(ReferencesMutex);
+
     auto mdp = get_attribute_metadata(meta_key.object_type, attr->id);
 
     const sai_attribute_value_t& value = attr->value;
@@ -2748,10 +3586,10 @@ void meta_generic_validation_post_set(
                 if (previous_attr != NULL)
                 {
                     // decrease previous if it was set
-                    object_reference_dec(previous_attr->value.oid);
+                    object_reference_dec(previous_attr->value.oid, meta_key, md.attrid);
                 }
 
-                object_reference_inc(value.oid);
+                object_reference_inc(value.oid, meta_key, md.attrid);
 
                 break;
             }
@@ -2764,10 +3602,10 @@ void meta_generic_validation_post_set(
                 if (previous_attr != NULL)
                 {
                     // decrease previous if it was set
-                    object_reference_dec(previous_attr->value.objlist);
+                    object_reference_dec(previous_attr->value.objlist, meta_key, md.attrid);
                 }
 
-                object_reference_inc(value.objlist);
+                object_reference_inc(value.objlist, meta_key, md.attrid);
 
                 break;
             }
@@ -2797,10 +3635,10 @@ void meta_generic_validation_post_set(
                 if (previous_attr != NULL)
                 {
                     // decrease previous if it was set
-                    object_reference_dec(previous_attr->value.aclfield.data.oid);
+                    object_reference_dec(previous_attr->value.aclfield.data.oid, meta_key, md.attrid);
                 }
 
-                object_reference_inc(value.aclfield.data.oid);
+                object_reference_inc(value.aclfield.data.oid, meta_key, md.attrid);
 
                 break;
             }
@@ -2813,10 +3651,10 @@ void meta_generic_validation_post_set(
                 if (previous_attr != NULL)
                 {
                     // decrease previous if it was set
-                    object_reference_dec(previous_attr->value.aclfield.data.objlist);
+                    object_reference_dec(previous_attr->value.aclfield.data.objlist, meta_key, md.attrid);
                 }
 
-                object_reference_inc(value.aclfield.data.objlist);
+                object_reference_inc(value.aclfield.data.objlist, meta_key, md.attrid);
 
                 break;
             }
@@ -2845,10 +3683,10 @@ void meta_generic_validation_post_set(
                 if (previous_attr != NULL)
                 {
                     // decrease previous if it was set
-                    object_reference_dec(previous_attr->value.aclaction.parameter.oid);
+                    object_reference_dec(previous_attr->value.aclaction.parameter.oid, meta_key, md.attrid);
                 }
 
-                object_reference_inc(value.aclaction.parameter.oid);
+                object_reference_inc(value.aclaction.parameter.oid, meta_key, md.attrid);
                 break;
             }
 
@@ -2860,10 +3698,10 @@ void meta_generic_validation_post_set(
                 if (previous_attr != NULL)
                 {
                     // decrease previous if it was set
-                    object_reference_dec(previous_attr->value.aclaction.parameter.objlist);
+                    object_reference_dec(previous_attr->value.aclaction.parameter.objlist, meta_key, md.attrid);
                 }
 
-                object_reference_inc(value.aclaction.parameter.objlist);
+                object_reference_inc(value.aclaction.parameter.objlist, meta_key, md.attrid);
 
                 break;
             }
@@ -2926,6 +3764,8 @@ void meta_generic_validation_post_get_objlist(
         return;
     }
 
+    std::lock_guard<std::mutex> lock(ReferencesMutex);
+
     std::set<sai_object_id_t> oids;
 
     for (uint32_t i = 0; i < count; ++i)
@@ -3058,9 +3898,7 @@ void meta_generic_validation_post_get(
 
                         sai_object_meta_key_t meta_key_vlan = { .object_type = SAI_OBJECT_TYPE_VLAN, .key = { .vlan_id = vlan_id } };
 
-                        std::string key_vlan = get_object_meta_key_string(meta_key_vlan);
-
-                        if (object_exists(key_vlan))
+                        if (object_exists(meta_key_vlan))
                         {
                             continue;
                         }
@@ -3231,6 +4069,8 @@ sai_status_t meta_sai_set_switch(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_SWITCH, true);
+
     sai_status_t status;
 
     sai_object_meta_key_t meta_key = { .object_type = SAI_OBJECT_TYPE_SWITCH, .key = { } };
@@ -3282,6 +4122,8 @@ sai_status_t meta_sai_get_switch(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_SWITCH, false);
+
     sai_status_t status;
 
     sai_object_meta_key_t meta_key = { .object_type = SAI_OBJECT_TYPE_SWITCH, .key = { } };
@@ -3350,11 +4192,9 @@ sai_status_t meta_sai_validate_fdb_entry(
     /*
     sai_object_meta_key_t meta_key_vlan = { .object_type = SAI_OBJECT_TYPE_VLAN, .key = { .vlan_id = vlan_id } };
 
-    std::string key_vlan = get_object_meta_key_string(meta_key_vlan);
-
-    if (!object_exists(key_vlan))
+    if (!object_exists(meta_key_vlan))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_vlan.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_vlan).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3364,13 +4204,11 @@ sai_status_t meta_sai_validate_fdb_entry(
 
     sai_object_meta_key_t meta_key_fdb = { .object_type = SAI_OBJECT_TYPE_FDB, .key = { .fdb_entry = *fdb_entry } };
 
-    std::string key_fdb = get_object_meta_key_string(meta_key_fdb);
-
     if (create)
     {
-        if (object_exists(key_fdb))
+        if (object_exists(meta_key_fdb))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_fdb.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", get_object_meta_key_string(meta_key_fdb).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3380,9 +4218,9 @@ sai_status_t meta_sai_validate_fdb_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_fdb) && !get)
+    if (!object_exists(meta_key_fdb) && !get)
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_fdb.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_fdb).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3400,6 +4238,8 @@ sai_status_t meta_sai_create_fdb_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_FDB, true);
+
     sai_status_t status = meta_sai_validate_fdb_entry(fdb_entry, true);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3448,6 +4288,8 @@ sai_status_t meta_sai_remove_fdb_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_FDB, true);
+
     sai_status_t status = meta_sai_validate_fdb_entry(fdb_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3497,6 +4339,8 @@ sai_status_t meta_sai_set_fdb_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_FDB, true);
+
     sai_status_t status = meta_sai_validate_fdb_entry(fdb_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3547,6 +4391,8 @@ sai_status_t meta_sai_get_fdb_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_FDB, false);
+
     // NOTE: when doing get, entry may not exist on metadata db
 
     sai_status_t status = meta_sai_validate_fdb_entry(fdb_entry, false, true);
@@ -3650,24 +4496,20 @@ sai_status_t meta_sai_validate_neighbor_entry(
 
     sai_object_meta_key_t meta_key_rif = { .object_type = expected, .key = { .object_id = rif } };
 
-    std::string key_rif = get_object_meta_key_string(meta_key_rif);
-
-    if (!object_exists(key_rif))
+    if (!object_exists(meta_key_rif))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_rif.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_rif).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
     sai_object_meta_key_t meta_key_neighbor = { .object_type = SAI_OBJECT_TYPE_NEIGHBOR, .key = { .neighbor_entry = *neighbor_entry } };
 
-    std::string key_neighbor = get_object_meta_key_string(meta_key_neighbor);
-
     if (create)
     {
-        if (object_exists(key_neighbor))
+        if (object_exists(meta_key_neighbor))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_neighbor.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", get_object_meta_key_string(meta_key_neighbor).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3677,9 +4519,9 @@ sai_status_t meta_sai_validate_neighbor_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_neighbor))
+    if (!object_exists(meta_key_neighbor))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_neighbor.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_neighbor).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3697,6 +4539,8 @@ sai_status_t meta_sai_create_neighbor_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NEIGHBOR, true);
+
     sai_status_t status = meta_sai_validate_neighbor_entry(neighbor_entry, true);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3745,6 +4589,8 @@ sai_status_t meta_sai_remove_neighbor_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NEIGHBOR, true);
+
     sai_status_t status = meta_sai_validate_neighbor_entry(neighbor_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3794,6 +4640,8 @@ sai_status_t meta_sai_set_neighbor_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NEIGHBOR, true);
+
     sai_status_t status = meta_sai_validate_neighbor_entry(neighbor_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3844,6 +4692,8 @@ sai_status_t meta_sai_get_neighbor_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_NEIGHBOR, false);
+
     sai_status_t status = meta_sai_validate_neighbor_entry(neighbor_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3903,13 +4753,11 @@ sai_status_t meta_sai_validate_vlan_id(
 
     sai_object_meta_key_t meta_key_vlan = { .object_type = SAI_OBJECT_TYPE_VLAN, .key = { .vlan_id = vlan_id } };
 
-    std::string key_vlan = get_object_meta_key_string(meta_key_vlan);
-
     if (create)
     {
-        if (object_exists(key_vlan))
+        if (object_exists(meta_key_vlan))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_vlan.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", get_object_meta_key_string(meta_key_vlan).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3917,9 +4765,9 @@ sai_status_t meta_sai_validate_vlan_id(
         return SAI_STATUS_SUCCESS;
     }
 
-    if (!object_exists(key_vlan))
+    if (!object_exists(meta_key_vlan))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_vlan.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_vlan).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3933,6 +4781,8 @@ sai_status_t meta_sai_create_vlan(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_VLAN, true);
+
     sai_status_t status = meta_sai_validate_vlan_id(vlan_id, true);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -3981,6 +4831,8 @@ sai_status_t meta_sai_remove_vlan(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_VLAN, true);
+
     sai_status_t status = meta_sai_validate_vlan_id(vlan_id, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4037,6 +4889,8 @@ sai_status_t meta_sai_set_vlan(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_VLAN, true);
+
     sai_status_t status = meta_sai_validate_vlan_id(vlan_id, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4087,6 +4941,8 @@ sai_status_t meta_sai_get_vlan(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_VLAN, false);
+
     sai_status_t status = meta_sai_validate_vlan_id(vlan_id, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4131,9 +4987,8 @@ sai_status_t meta_sai_get_vlan(
 
 // ROUTE ENTRY
 
-sai_status_t meta_sai_validate_route_entry(
-        _In_ const sai_unicast_route_entry_t* unicast_route_entry,
-        _In_ bool create)
+sai_status_t meta_sai_validate_route_entry_prefix(
+        _In_ const sai_unicast_route_entry_t* unicast_route_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -4169,7 +5024,13 @@ sai_status_t meta_sai_validate_route_entry(
             return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_object_id_t vr = unicast_route_entry->vr_id;
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t meta_sai_validate_route_entry_vr(
+        _In_ sai_object_id_t vr)
+{
+    SWSS_LOG_ENTER();
 
     if (vr == SAI_NULL_OBJECT_ID)
     {
@@ -4200,26 +5061,31 @@ sai_status_t meta_sai_validate_route_entry(
 
     sai_object_meta_key_t meta_key_vr = { .object_type = expected, .key = { .object_id = vr } };
 
-    std::string key_vr = get_object_meta_key_string(meta_key_vr);
-
-    if (!object_exists(key_vr))
+    if (!object_exists(meta_key_vr))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_vr.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_vr).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t meta_sai_validate_route_entry_exists(
+        _In_ const sai_unicast_route_entry_t* unicast_route_entry,
+        _In_ bool create)
+{
+    SWSS_LOG_ENTER();
+
     // check if route entry exists
 
     sai_object_meta_key_t meta_key_route = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = *unicast_route_entry } };
 
-    std::string key_route = get_object_meta_key_string(meta_key_route);
-
     if (create)
     {
-        if (object_exists(key_route))
+        if (object_exists(meta_key_route))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_route.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", get_object_meta_key_string(meta_key_route).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -4229,9 +5095,9 @@ sai_status_t meta_sai_validate_route_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_route))
+    if (!object_exists(meta_key_route))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_route.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_route).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -4239,6 +5105,29 @@ sai_status_t meta_sai_validate_route_entry(
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t meta_sai_validate_route_entry(
+        _In_ const sai_unicast_route_entry_t* unicast_route_entry,
+        _In_ bool create)
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status = meta_sai_validate_route_entry_prefix(unicast_route_entry);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    status = meta_sai_validate_route_entry_vr(unicast_route_entry->vr_id);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    return meta_sai_validate_route_entry_exists(unicast_route_entry, create);
+}
+
 sai_status_t meta_sai_create_route_entry(
         _In_ const sai_unicast_route_entry_t* unicast_route_entry,
         _In_ uint32_t attr_count,
@@ -4247,6 +5136,8 @@ sai_status_t meta_sai_create_route_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_ROUTE, true);
+
     sai_status_t status = meta_sai_validate_route_entry(unicast_route_entry, true);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4295,6 +5186,8 @@ sai_status_t meta_sai_remove_route_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_ROUTE, true);
+
     sai_status_t status = meta_sai_validate_route_entry(unicast_route_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4344,6 +5237,8 @@ sai_status_t meta_sai_set_route_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_ROUTE, true);
+
     sai_status_t status = meta_sai_validate_route_entry(unicast_route_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4394,6 +5289,8 @@ sai_status_t meta_sai_get_route_entry(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_ROUTE, false);
+
     sai_status_t status = meta_sai_validate_route_entry(unicast_route_entry, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4436,6 +5333,141 @@ sai_status_t meta_sai_get_route_entry(
     return status;
 }
 
+sai_status_t meta_sai_validate_bulk_route_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_unicast_route_entry_t* route_entry,
+        _In_ bool create,
+        _In_ bool stop_on_error,
+        _Out_ sai_status_t *object_statuses)
+{
+    SWSS_LOG_ENTER();
+
+    if (route_entry == NULL || object_statuses == NULL)
+    {
+        SWSS_LOG_ERROR("route_entry or object_statuses pointer is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    // routes in batch usually share few virtual routers, validate each only once
+
+    std::unordered_map<sai_object_id_t, sai_status_t> vrs;
+
+    sai_status_t result = SAI_STATUS_SUCCESS;
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        const sai_unicast_route_entry_t* entry = &route_entry[idx];
+
+        sai_status_t status = meta_sai_validate_route_entry_prefix(entry);
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            auto it = vrs.find(entry->vr_id);
+
+            if (it == vrs.end())
+            {
+                it = vrs.emplace(entry->vr_id, meta_sai_validate_route_entry_vr(entry->vr_id)).first;
+            }
+
+            status = it->second;
+        }
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            status = meta_sai_validate_route_entry_exists(entry, create);
+        }
+
+        object_statuses[idx] = status;
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        if (result == SAI_STATUS_SUCCESS)
+        {
+            result = status;
+        }
+
+        if (stop_on_error)
+        {
+            break;
+        }
+    }
+
+    return result;
+}
+
+sai_status_t meta_sai_bulk_set_route_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_unicast_route_entry_t* route_entry,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ bool stop_on_error,
+        _Out_ sai_status_t *object_statuses)
+{
+    SWSS_LOG_ENTER();
+
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_ROUTE, true);
+
+    /*
+     * Validates whole batch and updates local db for entries which passed
+     * validation, actual set is executed by caller as single bulk operation.
+     */
+
+    if (attr_list == NULL)
+    {
+        SWSS_LOG_ERROR("attr_list pointer is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_status_t result = meta_sai_validate_bulk_route_entry(object_count, route_entry, false, stop_on_error, object_statuses);
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        sai_object_meta_key_t meta_key = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = route_entry[idx] } };
+
+        sai_status_t status = meta_generic_validation_set(meta_key, &attr_list[idx]);
+
+        object_statuses[idx] = status;
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            meta_generic_validation_post_set(meta_key, &attr_list[idx]);
+
+            continue;
+        }
+
+        if (result == SAI_STATUS_SUCCESS)
+        {
+            result = status;
+        }
+
+        if (stop_on_error)
+        {
+            for (uint32_t i = idx + 1; i < object_count; ++i)
+            {
+                object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+            }
+
+            break;
+        }
+    }
+
+    return result;
+}
+
 // TRAP
 
 sai_status_t meta_sai_validate_trap(
@@ -4460,6 +5492,8 @@ sai_status_t meta_sai_set_trap(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_TRAP, true);
+
     sai_status_t status = meta_sai_validate_trap(hostif_trapid);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4510,6 +5544,8 @@ sai_status_t meta_sai_get_trap(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_TRAP, false);
+
     sai_status_t status = meta_sai_validate_trap(hostif_trapid);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4631,11 +5667,9 @@ sai_status_t meta_sai_validate_oid(
 
     sai_object_meta_key_t meta_key_oid = { .object_type = expected, .key = { .object_id = oid } };
 
-    std::string key_oid = get_object_meta_key_string(meta_key_oid);
-
-    if (!object_exists(key_oid))
+    if (!object_exists(meta_key_oid))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_oid.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", get_object_meta_key_string(meta_key_oid).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -4652,6 +5686,8 @@ sai_status_t meta_sai_create_oid(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(object_type, true);
+
     sai_status_t status = meta_sai_validate_oid(object_type, object_id, true);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4704,6 +5740,8 @@ sai_status_t meta_sai_remove_oid(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(object_type, true);
+
     sai_status_t status = meta_sai_validate_oid(object_type, &object_id, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4754,6 +5792,8 @@ sai_status_t meta_sai_set_oid(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(object_type, true);
+
     sai_status_t status = meta_sai_validate_oid(object_type, &object_id, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4805,6 +5845,8 @@ sai_status_t meta_sai_get_oid(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(object_type, false);
+
     sai_status_t status = meta_sai_validate_oid(object_type, &object_id, false);
 
     if (status != SAI_STATUS_SUCCESS)
@@ -4858,24 +5900,20 @@ void meta_sai_on_fdb_event_single(
 
     sai_object_meta_key_t meta_key_vlan = { .object_type = SAI_OBJECT_TYPE_VLAN, .key = { .vlan_id = data.fdb_entry.vlan_id} };
 
-    std::string key_vlan = get_object_meta_key_string(meta_key_vlan);
-
-    if (!object_exists(key_vlan))
+    if (!object_exists(meta_key_vlan))
     {
-        SWSS_LOG_WARN("object key %s doesn't exist", key_vlan.c_str());
+        SWSS_LOG_WARN("object key %s doesn't exist", get_object_meta_key_string(meta_key_vlan).c_str());
     }
 
     const sai_object_meta_key_t meta_key_fdb = { .object_type = SAI_OBJECT_TYPE_FDB, .key = { .fdb_entry = data.fdb_entry } };
 
-    std::string key_fdb = get_object_meta_key_string(meta_key_fdb);
-
     switch (data.event_type)
     {
         case SAI_FDB_EVENT_LEARNED:
 
-            if (object_exists(key_fdb))
+            if (object_exists(meta_key_fdb))
             {
-                SWSS_LOG_WARN("object key %s alearedy exists, but received LEARNED event", key_fdb.c_str());
+                SWSS_LOG_WARN("object key %s alearedy exists, but received LEARNED event", get_object_meta_key_string(meta_key_fdb).c_str());
                 break;
             }
 
@@ -4905,7 +5943,7 @@ void meta_sai_on_fdb_event_single(
                 }
                 else
                 {
-                    SWSS_LOG_ERROR("failed to insert %s received in notification: %s", key_fdb.c_str(), sai_serialize_status(status).c_str());
+                    SWSS_LOG_ERROR("failed to insert %s received in notification: %s", get_object_meta_key_string(meta_key_fdb).c_str(), sai_serialize_status(status).c_str());
                 }
             }
 
@@ -4914,9 +5952,9 @@ void meta_sai_on_fdb_event_single(
         case SAI_FDB_EVENT_AGED:
         case SAI_FDB_EVENT_FLUSHED:
 
-            if (!object_exists(key_fdb))
+            if (!object_exists(meta_key_fdb))
             {
-                SWSS_LOG_WARN("object key %s don't exist but received AGED/FLUSHED event", key_fdb.c_str());
+                SWSS_LOG_WARN("object key %s don't exist but received AGED/FLUSHED event", get_object_meta_key_string(meta_key_fdb).c_str());
                 break;
             }
 
@@ -4937,6 +5975,8 @@ void meta_sai_on_fdb_event(
 {
     SWSS_LOG_ENTER();
 
+    MetaDbLockGuard lock(SAI_OBJECT_TYPE_FDB, true);
+
     for (uint32_t i = 0; i < count; ++i)
     {
         meta_sai_on_fdb_event_single(data[i]);
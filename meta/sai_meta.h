@@ -5,10 +5,14 @@
 #include <stdlib.h>
 #include <iostream>
 #include <vector>
+#include <map>
+#include <string>
 #include <unordered_map>
 #include <set>
 #include <memory>
 
+#include <pthread.h>
+
 extern "C" {
 #include "sai.h"
 }
@@ -34,6 +38,10 @@ extern "C" {
 #define SAI_QUEUE_ATTR_INDEX 0x100 // TODO remove on new SAI
 #endif
 
+#ifndef SAI_STATUS_NOT_EXECUTED
+#define SAI_STATUS_NOT_EXECUTED SAI_STATUS_CODE(0x00000017L) // same as in sairedis.h
+#endif
+
 #define StringifyEnum(x) ((std::is_enum<x>::value) ? #x : 0)
 
 typedef enum _sai_attr_serialization_type_t
@@ -726,10 +734,205 @@ struct HashForEnum
     }
 };
 
+/*
+ * Hash and equality of object meta key, used to key local meta database
+ * directly by meta key, without serializing it to string. Only fields
+ * relevant for given object type are taken into account, for all object id
+ * types only object id is compared.
+ */
+
+struct SaiObjectMetaKeyHash
+{
+    std::size_t operator()(
+            _In_ const sai_object_meta_key_t& meta_key) const;
+};
+
+struct SaiObjectMetaKeyEqual
+{
+    bool operator()(
+            _In_ const sai_object_meta_key_t& a,
+            _In_ const sai_object_meta_key_t& b) const;
+};
+
+class SaiAttrWrapper;
+
+typedef std::unordered_map<sai_attr_id_t,std::shared_ptr<SaiAttrWrapper>> SaiObjectAttrHash;
+
+/*
+ * Reader/writer lock, std::shared_timed_mutex is not available in C++11.
+ */
+
+class MetaRWLock
+{
+    public:
+
+        MetaRWLock();
+
+        ~MetaRWLock();
+
+        void lockRead();
+
+        void lockWrite();
+
+        void unlock();
+
+    private:
+
+        MetaRWLock(const MetaRWLock&);
+        MetaRWLock& operator=(const MetaRWLock&);
+
+        pthread_rwlock_t m_lock;
+};
+
+/*
+ * Shard 0 holds all objects which can be referenced by other objects,
+ * route, neighbor and fdb entries have their own shards.
+ */
+#define META_DB_SHARD_COUNT 4
+
+/**
+ * @brief Local metadata db of objects and their attributes.
+ *
+ * Route, neighbor and fdb entries are leafs, they are not referenced by
+ * any other object, so operations on different leaf shards can be
+ * executed concurrently, for example fdb learn notification and route
+ * create. Each shard is guarded by its own lock, and whole db is guarded
+ * by db lock which is held exclusively by operations on non leaf objects.
+ */
+class SaiObjectAttrDb
+{
+    public:
+
+        typedef std::unordered_map<sai_object_meta_key_t,SaiObjectAttrHash,SaiObjectMetaKeyHash,SaiObjectMetaKeyEqual> Shard;
+
+        SaiObjectAttrHash& operator[](
+                _In_ const sai_object_meta_key_t& meta_key);
+
+        bool exists(
+                _In_ const sai_object_meta_key_t& meta_key) const;
+
+        const SaiObjectAttrHash* find(
+                _In_ const sai_object_meta_key_t& meta_key) const;
+
+        size_t erase(
+                _In_ const sai_object_meta_key_t& meta_key);
+
+        size_t size() const;
+
+        void clear();
+
+        const Shard& getShard(
+                _In_ size_t index) const;
+
+        MetaRWLock& getShardLock(
+                _In_ sai_object_type_t object_type);
+
+        MetaRWLock& getLock();
+
+        static size_t getShardIndex(
+                _In_ sai_object_type_t object_type);
+
+    private:
+
+        Shard m_shards[META_DB_SHARD_COUNT];
+
+        MetaRWLock m_shardLocks[META_DB_SHARD_COUNT];
+
+        MetaRWLock m_lock;
+};
+
+/**
+ * @brief Scoped lock on local metadata db for operation on given object type.
+ *
+ * Operations on leaf objects take db lock shared and shard lock shared or
+ * exclusive, all other operations take db lock shared for read or
+ * exclusive for write. Locks are not recursive, so only public meta api
+ * entry points acquire them.
+ */
+class MetaDbLockGuard
+{
+    public:
+
+        MetaDbLockGuard(
+                _In_ sai_object_type_t object_type,
+                _In_ bool write);
+
+        ~MetaDbLockGuard();
+
+    private:
+
+        MetaDbLockGuard(const MetaDbLockGuard&);
+        MetaDbLockGuard& operator=(const MetaDbLockGuard&);
+
+        MetaRWLock* m_shardLock;
+};
+
+/*
+ * Attribute ids below this value are kept in dense table indexed by
+ * attribute id, rest (custom ranges) are kept in sparse hash.
+ */
+#define META_DENSE_ATTR_ID_MAX 0x4000
+
+/*
+ * Per object type attribute metadata tables, populated once at meta init
+ * from AttributesMetadata, so lookups on hot paths don't hash and
+ * validation loops only visit attributes that matter.
+ */
+typedef struct _sai_object_type_attr_metadata_t
+{
+    /*
+     * Dense table indexed by attribute id, NULL if attribute is not defined.
+     */
+    std::vector<const sai_attr_metadata_t*>                        dense;
+
+    /*
+     * Attributes with id equal or above META_DENSE_ATTR_ID_MAX.
+     */
+    std::unordered_map<sai_attr_id_t, const sai_attr_metadata_t*>  sparse;
+
+    /*
+     * All attributes sorted by attribute id.
+     */
+    std::vector<const sai_attr_metadata_t*>                        attributes;
+
+    /*
+     * Mandatory on create attributes which are not conditional.
+     */
+    std::vector<const sai_attr_metadata_t*>                        mandatoryoncreate;
+
+    std::vector<const sai_attr_metadata_t*>                        conditional;
+
+    /*
+     * Attributes that can contain object id.
+     */
+    std::vector<const sai_attr_metadata_t*>                        objectids;
+
+} sai_object_type_attr_metadata_t;
+
 // TODO those should be internal only
 extern std::unordered_map<sai_object_type_t,std::unordered_map<sai_attr_id_t, const sai_attr_metadata_t*>, HashForEnum> AttributesMetadata;
 extern std::unordered_map<std::string,const sai_attr_metadata_t*> AttributesIdMetadata;
 
+class SaiPerfectHash;
+
+/**
+ * @brief Get attribute metadata by attribute id name, for example
+ * "SAI_ROUTE_ATTR_NEXT_HOP_ID", using perfect hash table built on init.
+ *
+ * @return Attribute metadata or NULL if name is not valid attribute id.
+ */
+extern const sai_attr_metadata_t* get_attribute_metadata_by_name(
+        _In_ const std::string& name);
+
+/**
+ * @brief Get perfect hash table of enum values names, value of the name is
+ * index to enum values array.
+ *
+ * @return Hash table or NULL if table was not built for this enum.
+ */
+extern const SaiPerfectHash* get_enum_values_perfect_hash(
+        _In_ const sai_enum_metadata_t* meta);
+
 extern std::string get_attr_info(const sai_attr_metadata_t& md);
 extern const char* get_object_type_name(sai_object_type_t o);
 extern const char* get_attr_name(sai_object_type_t o, sai_attr_id_t a);
@@ -743,6 +946,12 @@ extern const sai_attr_metadata_t* get_attribute_metadata(
         _In_ sai_object_type_t objecttype,
         _In_ sai_attr_id_t attrid);
 
+extern const sai_object_type_attr_metadata_t* get_object_type_attr_metadata(
+        _In_ sai_object_type_t objecttype);
+
+extern const std::vector<const sai_attr_metadata_t*>& get_attributes_metadata(
+        _In_ sai_object_type_t objecttype);
+
 extern const sai_attribute_t* get_object_previous_attr(
         _In_ const sai_object_meta_key_t meta_key,
         _In_ const sai_attr_metadata_t& md);
@@ -750,6 +959,137 @@ extern const sai_attribute_t* get_object_previous_attr(
 extern sai_status_t meta_init_db();
 extern void meta_init();
 
+extern bool is_object_id_serialization_type(
+        _In_ sai_attr_serialization_type_t serializationtype);
+
+// OBJECT REFERENCES
+
+/*
+ * Attribute id of reference which is held by object key and not by
+ * attribute, for example virtual router id in route entry.
+ */
+#define META_REFERENCE_KEY_ATTR_ID ((sai_attr_id_t)-1)
+
+typedef struct _sai_object_meta_reference_t
+{
+    /*
+     * Object which holds reference.
+     */
+    sai_object_meta_key_t meta_key;
+
+    /*
+     * Attribute which holds reference or META_REFERENCE_KEY_ATTR_ID.
+     */
+    sai_attr_id_t attr_id;
+
+    /*
+     * Number of references held by attribute, object list can contain
+     * same object id multiple times.
+     */
+    uint32_t count;
+
+} sai_object_meta_reference_t;
+
+/**
+ * @brief Get all objects which hold reference on given object id.
+ *
+ * References are returned in no particular order.
+ */
+extern std::vector<sai_object_meta_reference_t> meta_get_object_references(
+        _In_ sai_object_id_t oid);
+
+/**
+ * @brief Get human readable list of objects which hold reference on given
+ * object id, at most max_count references are listed.
+ */
+extern std::string meta_get_object_references_string(
+        _In_ sai_object_id_t oid,
+        _In_ size_t max_count);
+
+// DB STATISTICS
+
+typedef struct _sai_meta_attr_statistics_t
+{
+    /*
+     * Number of objects which have this attribute in local db.
+     */
+    size_t count;
+
+    /*
+     * Approximate number of bytes used by this attribute, including
+     * hash node, wrapper and list allocations.
+     */
+    size_t bytes;
+
+} sai_meta_attr_statistics_t;
+
+typedef struct _sai_meta_object_type_statistics_t
+{
+    size_t objects;
+
+    /*
+     * Approximate number of bytes used by objects of this type, including
+     * attributes.
+     */
+    size_t bytes;
+
+    std::map<sai_attr_id_t, sai_meta_attr_statistics_t> attributes;
+
+} sai_meta_object_type_statistics_t;
+
+typedef struct _sai_meta_db_statistics_t
+{
+    std::map<sai_object_type_t, sai_meta_object_type_statistics_t> objecttypes;
+
+    size_t objects;
+
+    size_t attributes;
+
+    size_t bytes;
+
+    size_t references;
+
+    size_t referencesbytes;
+
+    size_t attributekeys;
+
+    size_t attributekeysbytes;
+
+    float objectsloadfactor;
+
+    float referencesloadfactor;
+
+    float attributekeysloadfactor;
+
+} sai_meta_db_statistics_t;
+
+/**
+ * @brief Collect memory statistics of local metadata db.
+ *
+ * Byte counts are estimates based on container node sizes and list
+ * allocations, actual allocator overhead is not accounted.
+ */
+extern sai_meta_db_statistics_t meta_get_db_statistics();
+
+/**
+ * @brief Serialize local metadata db statistics to json string.
+ */
+extern std::string meta_serialize_db_statistics(
+        _In_ const sai_meta_db_statistics_t& stats);
+
+/**
+ * @brief Enable or disable compact storage of leaf objects.
+ *
+ * When enabled, attributes of route, neighbor and fdb entries which are
+ * set to their const default value are not kept in local db, since absent
+ * attribute is equivalent to default one. Conditional and object id
+ * attributes are always kept.
+ */
+extern void meta_set_compact_mode(
+        _In_ bool enable);
+
+extern bool meta_get_compact_mode();
+
 
 // GENERIC FUNCTION POINTERS
 
@@ -909,6 +1249,36 @@ extern sai_status_t meta_sai_set_route_entry(
         _In_ const sai_attribute_t *attr,
         _In_ sai_set_route_attribute_fn set);
 
+/**
+ * @brief Validate batch of route entries.
+ *
+ * Each distinct virtual router is validated only once. Statuses of entries
+ * not validated (after first failure on stop on error) are set to
+ * SAI_STATUS_NOT_EXECUTED.
+ *
+ * @return SAI_STATUS_SUCCESS if all entries are valid, otherwise status of
+ * first failed entry.
+ */
+extern sai_status_t meta_sai_validate_bulk_route_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_unicast_route_entry_t* route_entry,
+        _In_ bool create,
+        _In_ bool stop_on_error,
+        _Out_ sai_status_t *object_statuses);
+
+/**
+ * @brief Validate bulk set on route entries and update local db.
+ *
+ * Entry attribute is validated and applied to local db only when its
+ * status is SAI_STATUS_SUCCESS, caller executes actual set for those.
+ */
+extern sai_status_t meta_sai_bulk_set_route_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_unicast_route_entry_t* route_entry,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ bool stop_on_error,
+        _Out_ sai_status_t *object_statuses);
+
 extern sai_status_t meta_sai_get_route_entry(
         _In_ const sai_unicast_route_entry_t* unicast_route_entry,
         _In_ uint32_t attr_count,
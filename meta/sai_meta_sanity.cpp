@@ -1,5 +1,7 @@
 #include <sstream>
+#include <algorithm>
 #include "sai_meta.h"
+#include "saiperfecthash.h"
 
 const char metadata_sai_status_t_enum_name[] = "sai_status_t";
 const sai_status_t metadata_sai_status_t_enum_values[] = {
@@ -263,6 +265,15 @@ std::unordered_map<sai_object_type_t,std::unordered_map<sai_attr_id_t, const sai
 
 std::unordered_map<std::string, const sai_attr_metadata_t*> AttributesIdMetadata;
 
+// perfect hash of attribute id names, value is index to list
+std::vector<const sai_attr_metadata_t*> AttributesIdMetadataList;
+SaiPerfectHash AttributesIdPerfectHash;
+
+std::unordered_map<const sai_enum_metadata_t*, SaiPerfectHash> EnumValuesPerfectHash;
+
+// flat per object type tables, built from AttributesMetadata after sanity checks
+std::vector<sai_object_type_attr_metadata_t> ObjectTypeAttrMetadata;
+
 // Serialization type name resolve
 
 std::unordered_map<int32_t, std::string> get_serialization_type_map()
@@ -1740,6 +1751,168 @@ void metadata_sanity_check(const sai_attr_metadata_t& md)
     // bool haveMandatoryContitionalAttributes
 }
 
+bool is_object_id_serialization_type(
+        _In_ sai_attr_serialization_type_t serializationtype)
+{
+    switch (serializationtype)
+    {
+        case SAI_SERIALIZATION_TYPE_OBJECT_ID:
+        case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void meta_init_object_type_attr_metadata()
+{
+    SWSS_LOG_ENTER();
+
+    ObjectTypeAttrMetadata.clear();
+    ObjectTypeAttrMetadata.resize(SAI_OBJECT_TYPE_MAX);
+
+    for (const auto& ot: AttributesMetadata)
+    {
+        auto& t = ObjectTypeAttrMetadata[ot.first];
+
+        for (const auto& a: ot.second)
+        {
+            t.attributes.push_back(a.second);
+        }
+
+        std::sort(t.attributes.begin(), t.attributes.end(),
+                [](const sai_attr_metadata_t* a, const sai_attr_metadata_t* b) { return a->attrid < b->attrid; });
+
+        for (const auto mdp: t.attributes)
+        {
+            const sai_attr_metadata_t& md = *mdp;
+
+            if (md.attrid < META_DENSE_ATTR_ID_MAX)
+            {
+                if (md.attrid >= t.dense.size())
+                {
+                    t.dense.resize(md.attrid + 1, NULL);
+                }
+
+                t.dense[md.attrid] = mdp;
+            }
+            else
+            {
+                t.sparse[md.attrid] = mdp;
+            }
+
+            if (md.isconditional())
+            {
+                t.conditional.push_back(mdp);
+            }
+            else if (HAS_FLAG_MANDATORY_ON_CREATE(md.flags))
+            {
+                t.mandatoryoncreate.push_back(mdp);
+            }
+
+            if (is_object_id_serialization_type(md.serializationtype))
+            {
+                t.objectids.push_back(mdp);
+            }
+        }
+
+        SWSS_LOG_INFO("object type %d: %zu attributes, dense table size %zu",
+                ot.first, t.attributes.size(), t.dense.size());
+    }
+}
+
+void meta_init_enum_values_perfect_hash(
+        _In_ const sai_enum_metadata_t* meta)
+{
+    SWSS_LOG_ENTER();
+
+    if (meta == NULL || EnumValuesPerfectHash.find(meta) != EnumValuesPerfectHash.end())
+    {
+        return;
+    }
+
+    std::vector<const char*> names(meta->valuesnames, meta->valuesnames + meta->valuescount);
+
+    if (!EnumValuesPerfectHash[meta].build(names))
+    {
+        SWSS_LOG_WARN("failed to build perfect hash for enum %s, values will be searched linearly", meta->name);
+
+        EnumValuesPerfectHash.erase(meta);
+    }
+}
+
+void meta_init_perfect_hash()
+{
+    SWSS_LOG_ENTER();
+
+    AttributesIdMetadataList.clear();
+
+    std::vector<const char*> names;
+
+    for (const auto& a: AttributesIdMetadata)
+    {
+        AttributesIdMetadataList.push_back(a.second);
+
+        names.push_back(a.second->attridname);
+    }
+
+    if (!AttributesIdPerfectHash.build(names))
+    {
+        SWSS_LOG_ERROR("attribute id names are not unique");
+        throw;
+    }
+
+    EnumValuesPerfectHash.clear();
+
+    for (const auto mdp: AttributesIdMetadataList)
+    {
+        meta_init_enum_values_perfect_hash(mdp->enummetadata);
+    }
+
+    // enums which are deserialized directly, not as attribute value
+
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_switch_oper_status_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_port_oper_status_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_status_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_fdb_event_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_object_type_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_port_event_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_packet_color_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_packet_action_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_next_hop_group_type_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_meter_type_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_hostif_trap_type_t);
+    meta_init_enum_values_perfect_hash(&metadata_enum_sai_port_stat_t);
+
+    SWSS_LOG_INFO("perfect hash built for %zu attribute ids and %zu enums",
+            AttributesIdPerfectHash.size(), EnumValuesPerfectHash.size());
+}
+
+const sai_attr_metadata_t* get_attribute_metadata_by_name(
+        _In_ const std::string& name)
+{
+    // no log enter, this is called for every deserialized attribute
+
+    int idx = AttributesIdPerfectHash.find(name);
+
+    return (idx < 0) ? NULL : AttributesIdMetadataList[idx];
+}
+
+const SaiPerfectHash* get_enum_values_perfect_hash(
+        _In_ const sai_enum_metadata_t* meta)
+{
+    // no log enter, this is called for every deserialized enum
+
+    auto it = EnumValuesPerfectHash.find(meta);
+
+    return (it == EnumValuesPerfectHash.end()) ? NULL : &it->second;
+}
+
 void meta_init()
 {
     SWSS_LOG_ENTER();
@@ -1807,4 +1980,8 @@ void meta_init()
     CHECK(vlan);
     CHECK(vlan_member);
     CHECK(wred);
+
+    meta_init_object_type_attr_metadata();
+
+    meta_init_perfect_hash();
 }
@@ -0,0 +1,195 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "sai_meta.h"
+#include "saiserialize.h"
+
+extern void sai_deserialize_enum(
+        _In_ const std::string& s,
+        _In_ const sai_enum_metadata_t *meta,
+        _Out_ int32_t& value);
+
+/*
+ * Metadata benchmark.
+ *
+ * Measures cost of metadata helpers used on hot paths of syncd and compares
+ * them with code they replaced. Timing depends on machine load, so this is
+ * not part of "make check", only correctness is verified by tests.
+ */
+
+void bench_copy_attr_value()
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t list[4] = { 0x1000000000001, 0x1000000000002, 0x1000000000003, 0x1000000000004 };
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_LAG_ATTR_PORT_LIST;
+    attr.value.objlist.count = 4;
+    attr.value.objlist.list = list;
+
+    const auto& md = *get_attribute_metadata(SAI_OBJECT_TYPE_LAG, SAI_LAG_ATTR_PORT_LIST);
+
+    // compare with serialize/deserialize round trip
+
+    const int n = 100000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < n; ++i)
+    {
+        sai_attribute_t a;
+
+        a.id = attr.id;
+
+        std::string str = sai_serialize_attr_value(md, attr, false);
+
+        sai_deserialize_attr_value(str, md, a, false);
+
+        sai_deserialize_free_attribute_value(md.serializationtype, a);
+    }
+
+    auto mid = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < n; ++i)
+    {
+        sai_attribute_t a;
+
+        sai_copy_attr_value(md, attr, a);
+
+        sai_deserialize_free_attribute_value(md.serializationtype, a);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << "serialize round trip: "
+        << std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count() << " us, "
+        << "direct copy: "
+        << std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count() << " us "
+        << "(" << n << " copies)" << std::endl;
+}
+
+void bench_perfect_hash_deserialize()
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<std::string> names;
+
+    for (const auto& a: AttributesIdMetadata)
+    {
+        names.push_back(a.first);
+    }
+
+    const sai_enum_metadata_t* meta = &metadata_enum_sai_hostif_trap_type_t;
+
+    // per field decode cost, hash map and linear scan compared to perfect hash
+
+    const int n = 100;
+
+    size_t found = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (const auto& name: names)
+        {
+            found += AttributesIdMetadata.find(name) != AttributesIdMetadata.end();
+        }
+    }
+
+    auto mid = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (const auto& name: names)
+        {
+            found += get_attribute_metadata_by_name(name) != NULL;
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (found != 2 * n * names.size())
+    {
+        std::cerr << "attribute id lookup failed" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    size_t count = n * names.size();
+
+    std::cout << "attr id: hash map: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() / count << " ns, "
+        << "perfect hash: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() / count << " ns "
+        << "per field (" << count << " fields)" << std::endl;
+
+    std::vector<std::string> values(meta->valuesnames, meta->valuesnames + meta->valuescount);
+
+    int32_t sum = 0;
+
+    start = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (const auto& v: values)
+        {
+            for (size_t idx = 0; idx < meta->valuescount; ++idx)
+            {
+                if (strcmp(v.c_str(), meta->valuesnames[idx]) == 0)
+                {
+                    sum += meta->values[idx];
+                    break;
+                }
+            }
+        }
+    }
+
+    mid = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (const auto& v: values)
+        {
+            int32_t value;
+
+            sai_deserialize_enum(v, meta, value);
+
+            sum -= value;
+        }
+    }
+
+    end = std::chrono::high_resolution_clock::now();
+
+    if (sum != 0)
+    {
+        std::cerr << "enum value lookup failed" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    count = n * values.size();
+
+    std::cout << "enum " << meta->name << ": linear scan: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() / count << " ns, "
+        << "perfect hash: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() / count << " ns "
+        << "per field (" << count << " fields)" << std::endl;
+}
+
+int main()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init();
+
+    bench_copy_attr_value();
+    bench_perfect_hash_deserialize();
+
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include "saiperfecthash.h"
+
+#include "swss/logger.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+/*
+ * Number of seeds tried for single bucket before table is enlarged.
+ */
+#define SEED_SEARCH_LIMIT 0x10000
+
+SaiPerfectHash::SaiPerfectHash()
+{
+    SWSS_LOG_ENTER();
+
+    // empty
+}
+
+uint32_t SaiPerfectHash::hash(
+        _In_ const char* key,
+        _In_ size_t length,
+        _In_ uint32_t seed)
+{
+    // no log enter, this is called on every lookup
+
+    uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        h ^= (uint8_t)key[i];
+        h *= 16777619u;
+    }
+
+    // final avalanche, so different seeds give independent slots
+
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+
+    return h;
+}
+
+bool SaiPerfectHash::build(
+        _In_ const std::vector<const char*>& keys)
+{
+    SWSS_LOG_ENTER();
+
+    m_keys = keys;
+    m_lengths.clear();
+    m_seeds.clear();
+    m_slots.clear();
+
+    std::vector<const char*> sorted = keys;
+
+    std::sort(sorted.begin(), sorted.end(),
+            [](const char* a, const char* b) { return strcmp(a, b) < 0; });
+
+    for (size_t i = 1; i < sorted.size(); ++i)
+    {
+        if (strcmp(sorted[i - 1], sorted[i]) == 0)
+        {
+            SWSS_LOG_ERROR("key %s is not unique", sorted[i]);
+
+            m_keys.clear();
+
+            return false;
+        }
+    }
+
+    size_t n = keys.size();
+
+    if (n == 0)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        m_lengths.push_back((uint32_t)strlen(keys[i]));
+    }
+
+    size_t bucketCount = (n + 1) / 2;
+
+    std::vector<std::vector<uint32_t>> buckets(bucketCount);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        buckets[hash(keys[i], m_lengths[i], 0) % bucketCount].push_back((uint32_t)i);
+    }
+
+    std::vector<size_t> order;
+
+    for (size_t b = 0; b < bucketCount; ++b)
+    {
+        order.push_back(b);
+    }
+
+    std::stable_sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    size_t tableSize = n;
+
+    while (true)
+    {
+        m_seeds.assign(bucketCount, 0);
+        m_slots.assign(tableSize, -1);
+
+        bool success = true;
+
+        for (size_t b: order)
+        {
+            const auto& bucket = buckets[b];
+
+            if (bucket.empty())
+            {
+                break;
+            }
+
+            std::vector<size_t> positions;
+
+            uint32_t seed = 1;
+
+            for (; seed < SEED_SEARCH_LIMIT; ++seed)
+            {
+                positions.clear();
+
+                for (uint32_t idx: bucket)
+                {
+                    size_t pos = hash(keys[idx], m_lengths[idx], seed) % tableSize;
+
+                    if (m_slots[pos] != -1 || std::find(positions.begin(), positions.end(), pos) != positions.end())
+                    {
+                        break;
+                    }
+
+                    positions.push_back(pos);
+                }
+
+                if (positions.size() == bucket.size())
+                {
+                    break;
+                }
+            }
+
+            if (seed == SEED_SEARCH_LIMIT)
+            {
+                success = false;
+                break;
+            }
+
+            m_seeds[b] = seed;
+
+            for (size_t i = 0; i < bucket.size(); ++i)
+            {
+                m_slots[positions[i]] = (int32_t)bucket[i];
+            }
+        }
+
+        if (success)
+        {
+            break;
+        }
+
+        tableSize += tableSize / 8 + 1;
+
+        SWSS_LOG_INFO("seed not found, enlarging table to %zu for %zu keys", tableSize, n);
+    }
+
+    return true;
+}
+
+int SaiPerfectHash::find(
+        _In_ const char* key,
+        _In_ size_t length) const
+{
+    // no log enter, this is called for every deserialized field
+
+    if (m_slots.empty())
+    {
+        return -1;
+    }
+
+    uint32_t seed = m_seeds[hash(key, length, 0) % m_seeds.size()];
+
+    int idx = m_slots[hash(key, length, seed) % m_slots.size()];
+
+    if (idx < 0 || m_lengths[idx] != length || memcmp(m_keys[idx], key, length) != 0)
+    {
+        return -1;
+    }
+
+    return idx;
+}
+
+int SaiPerfectHash::find(
+        _In_ const std::string& key) const
+{
+    return find(key.c_str(), key.length());
+}
+
+size_t SaiPerfectHash::size() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_keys.size();
+}
@@ -0,0 +1,68 @@
+#ifndef __SAI_PERFECT_HASH_H__
+#define __SAI_PERFECT_HASH_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "sai.h"
+}
+
+/**
+ * @brief Minimal perfect hash of constant string keys.
+ *
+ * Table is built using hash and displace method: keys are split into
+ * buckets by first hash, and for each bucket (largest first) seed is
+ * searched which places all bucket keys into free slots by second hash.
+ * Lookup costs two hashes of the key, one seed load and one string compare
+ * to reject keys which are not in the table.
+ *
+ * Keys are not copied, they must outlive the table, which is true for
+ * metadata names.
+ */
+class SaiPerfectHash
+{
+    public:
+
+        SaiPerfectHash();
+
+        /**
+         * @brief Build table, value of the key is its index in keys vector.
+         *
+         * @return False if keys are not unique.
+         */
+        bool build(
+                _In_ const std::vector<const char*>& keys);
+
+        /**
+         * @brief Find key in table.
+         *
+         * @return Index of the key or -1 if key is not present.
+         */
+        int find(
+                _In_ const char* key,
+                _In_ size_t length) const;
+
+        int find(
+                _In_ const std::string& key) const;
+
+        size_t size() const;
+
+    private:
+
+        static uint32_t hash(
+                _In_ const char* key,
+                _In_ size_t length,
+                _In_ uint32_t seed);
+
+        std::vector<const char*> m_keys;
+
+        std::vector<uint32_t> m_lengths;
+
+        std::vector<uint32_t> m_seeds;
+
+        std::vector<int32_t> m_slots;
+};
+
+#endif // __SAI_PERFECT_HASH_H__
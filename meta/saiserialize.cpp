@@ -1,5 +1,6 @@
 #include "saiserialize.h"
 #include "meta/sai_meta.h"
+#include "meta/saiperfecthash.h"
 #include "swss/tokenize.h"
 #include "swss/json.hpp"
 
@@ -401,6 +402,292 @@ sai_status_t transfer_attributes(
     return SAI_STATUS_SUCCESS;
 }
 
+template<typename T>
+void sai_copy_list(
+        _In_ const T &src_element,
+        _Out_ T &dst_element)
+{
+    dst_element.count = src_element.count;
+
+    if (src_element.list == NULL || src_element.count == 0)
+    {
+        dst_element.list = NULL;
+        return;
+    }
+
+    dst_element.list = sai_alloc_n_of_ptr_type(src_element.count, dst_element.list);
+
+    memcpy(dst_element.list, src_element.list, sizeof(src_element.list[0]) * src_element.count);
+}
+
+template<typename T>
+bool sai_compare_list(
+        _In_ const T &a,
+        _In_ const T &b)
+{
+    if (a.count != b.count)
+    {
+        return false;
+    }
+
+    if (a.list == NULL || b.list == NULL || a.count == 0)
+    {
+        // serialized as "count:null"
+        return (a.list == NULL || a.count == 0) == (b.list == NULL || b.count == 0);
+    }
+
+    return memcmp(a.list, b.list, sizeof(a.list[0]) * a.count) == 0;
+}
+
+#define COMPARE_MEMBER(x) (memcmp(&a.value.x, &b.value.x, sizeof(a.value.x)) == 0)
+
+void sai_copy_attr_value(
+        _In_ const sai_attr_metadata_t &meta,
+        _In_ const sai_attribute_t &src_attr,
+        _Out_ sai_attribute_t &dst_attr)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Primitive values are copied with entire value union, lists are
+     * allocated and copied below, so result can be released by
+     * sai_deserialize_free_attribute_value, same as deserialized value.
+     */
+
+    dst_attr.id = src_attr.id;
+    dst_attr.value = src_attr.value;
+
+    switch (meta.serializationtype)
+    {
+        case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
+            sai_copy_list(src_attr.value.objlist, dst_attr.value.objlist);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_UINT8_LIST:
+            sai_copy_list(src_attr.value.u8list, dst_attr.value.u8list);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_INT8_LIST:
+            sai_copy_list(src_attr.value.s8list, dst_attr.value.s8list);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_UINT16_LIST:
+            sai_copy_list(src_attr.value.u16list, dst_attr.value.u16list);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_INT16_LIST:
+            sai_copy_list(src_attr.value.s16list, dst_attr.value.s16list);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_UINT32_LIST:
+            sai_copy_list(src_attr.value.u32list, dst_attr.value.u32list);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_INT32_LIST:
+            sai_copy_list(src_attr.value.s32list, dst_attr.value.s32list);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_VLAN_LIST:
+            sai_copy_list(src_attr.value.vlanlist, dst_attr.value.vlanlist);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_QOS_MAP_LIST:
+            sai_copy_list(src_attr.value.qosmap, dst_attr.value.qosmap);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_TUNNEL_MAP_LIST:
+            sai_copy_list(src_attr.value.tunnelmap, dst_attr.value.tunnelmap);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+
+            if (!src_attr.value.aclfield.enable)
+            {
+                // parameter is not needed when field is disabled, and may be garbage
+                memset(&dst_attr.value, 0, sizeof(dst_attr.value));
+                break;
+            }
+
+            sai_copy_list(src_attr.value.aclfield.data.objlist, dst_attr.value.aclfield.data.objlist);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_UINT8_LIST:
+
+            if (!src_attr.value.aclfield.enable)
+            {
+                memset(&dst_attr.value, 0, sizeof(dst_attr.value));
+                break;
+            }
+
+            sai_copy_list(src_attr.value.aclfield.mask.u8list, dst_attr.value.aclfield.mask.u8list);
+            sai_copy_list(src_attr.value.aclfield.data.u8list, dst_attr.value.aclfield.data.u8list);
+            break;
+
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+
+            if (!src_attr.value.aclaction.enable)
+            {
+                memset(&dst_attr.value, 0, sizeof(dst_attr.value));
+                break;
+            }
+
+            sai_copy_list(src_attr.value.aclaction.parameter.objlist, dst_attr.value.aclaction.parameter.objlist);
+            break;
+
+        default:
+            // primitive value, already copied
+            break;
+    }
+}
+
+bool sai_compare_attr_value(
+        _In_ const sai_attr_metadata_t &meta,
+        _In_ const sai_attribute_t &a,
+        _In_ const sai_attribute_t &b)
+{
+    SWSS_LOG_ENTER();
+
+    switch (meta.serializationtype)
+    {
+        case SAI_SERIALIZATION_TYPE_BOOL:
+            return a.value.booldata == b.value.booldata;
+
+        case SAI_SERIALIZATION_TYPE_CHARDATA:
+            return strncmp(a.value.chardata, b.value.chardata, sizeof(a.value.chardata)) == 0;
+
+        case SAI_SERIALIZATION_TYPE_UINT8:
+        case SAI_SERIALIZATION_TYPE_INT8:
+            return COMPARE_MEMBER(u8);
+
+        case SAI_SERIALIZATION_TYPE_UINT16:
+        case SAI_SERIALIZATION_TYPE_INT16:
+            return COMPARE_MEMBER(u16);
+
+        case SAI_SERIALIZATION_TYPE_UINT32:
+        case SAI_SERIALIZATION_TYPE_INT32:
+            return COMPARE_MEMBER(u32);
+
+        case SAI_SERIALIZATION_TYPE_UINT64:
+        case SAI_SERIALIZATION_TYPE_INT64:
+            return COMPARE_MEMBER(u64);
+
+        case SAI_SERIALIZATION_TYPE_MAC:
+            return COMPARE_MEMBER(mac);
+
+        case SAI_SERIALIZATION_TYPE_IP4:
+            return COMPARE_MEMBER(ip4);
+
+        case SAI_SERIALIZATION_TYPE_IP6:
+            return COMPARE_MEMBER(ip6);
+
+        case SAI_SERIALIZATION_TYPE_IP_ADDRESS:
+
+            if (a.value.ipaddr.addr_family != b.value.ipaddr.addr_family)
+            {
+                return false;
+            }
+
+            return (a.value.ipaddr.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+                ? COMPARE_MEMBER(ipaddr.addr.ip4)
+                : COMPARE_MEMBER(ipaddr.addr.ip6);
+
+        case SAI_SERIALIZATION_TYPE_OBJECT_ID:
+            return COMPARE_MEMBER(oid);
+
+        case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
+            return sai_compare_list(a.value.objlist, b.value.objlist);
+
+        case SAI_SERIALIZATION_TYPE_UINT8_LIST:
+            return sai_compare_list(a.value.u8list, b.value.u8list);
+
+        case SAI_SERIALIZATION_TYPE_INT8_LIST:
+            return sai_compare_list(a.value.s8list, b.value.s8list);
+
+        case SAI_SERIALIZATION_TYPE_UINT16_LIST:
+            return sai_compare_list(a.value.u16list, b.value.u16list);
+
+        case SAI_SERIALIZATION_TYPE_INT16_LIST:
+            return sai_compare_list(a.value.s16list, b.value.s16list);
+
+        case SAI_SERIALIZATION_TYPE_UINT32_LIST:
+            return sai_compare_list(a.value.u32list, b.value.u32list);
+
+        case SAI_SERIALIZATION_TYPE_INT32_LIST:
+            return sai_compare_list(a.value.s32list, b.value.s32list);
+
+        case SAI_SERIALIZATION_TYPE_UINT32_RANGE:
+            return COMPARE_MEMBER(u32range);
+
+        case SAI_SERIALIZATION_TYPE_INT32_RANGE:
+            return COMPARE_MEMBER(s32range);
+
+        case SAI_SERIALIZATION_TYPE_VLAN_LIST:
+            return sai_compare_list(a.value.vlanlist, b.value.vlanlist);
+
+        default:
+            break;
+    }
+
+    if (meta.serializationtype >= SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_BOOL &&
+            meta.serializationtype <= SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_UINT8_LIST)
+    {
+        if (a.value.aclfield.enable != b.value.aclfield.enable)
+        {
+            return false;
+        }
+
+        if (!a.value.aclfield.enable)
+        {
+            // parameter is not needed when field is disabled
+            return true;
+        }
+    }
+
+    if (meta.serializationtype >= SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_UINT8 &&
+            meta.serializationtype <= SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST)
+    {
+        if (a.value.aclaction.enable != b.value.aclaction.enable)
+        {
+            return false;
+        }
+
+        if (!a.value.aclaction.enable)
+        {
+            return true;
+        }
+    }
+
+    switch (meta.serializationtype)
+    {
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+            return COMPARE_MEMBER(aclfield.data.oid);
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            return sai_compare_list(a.value.aclfield.data.objlist, b.value.aclfield.data.objlist);
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_UINT8_LIST:
+            return sai_compare_list(a.value.aclfield.mask.u8list, b.value.aclfield.mask.u8list) &&
+                sai_compare_list(a.value.aclfield.data.u8list, b.value.aclfield.data.u8list);
+
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+            return COMPARE_MEMBER(aclaction.parameter.oid);
+
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            return sai_compare_list(a.value.aclaction.parameter.objlist, b.value.aclaction.parameter.objlist);
+
+        default:
+            break;
+    }
+
+    /*
+     * Remaining types (acl primitives, qos and tunnel maps) are structures
+     * which may contain padding or unused union members, so they are
+     * compared using serialized value.
+     */
+
+    return sai_serialize_attr_value(meta, a) == sai_serialize_attr_value(meta, b);
+}
+
 // util
 
 uint8_t get_ip_mask(
@@ -1488,14 +1775,29 @@ void sai_deserialize_enum(
         return sai_deserialize_number(s, value);
     }
 
-    for (size_t i = 0; i < meta->valuescount; ++i)
+    const SaiPerfectHash* hash = get_enum_values_perfect_hash(meta);
+
+    if (hash != NULL)
     {
-        if (strcmp(s.c_str(), meta->valuesnames[i]) == 0)
+        int idx = hash->find(s);
+
+        if (idx >= 0)
         {
-            value = meta->values[i];
+            value = meta->values[idx];
             return;
         }
     }
+    else
+    {
+        for (size_t i = 0; i < meta->valuescount; ++i)
+        {
+            if (strcmp(s.c_str(), meta->valuesnames[i]) == 0)
+            {
+                value = meta->values[i];
+                return;
+            }
+        }
+    }
 
     SWSS_LOG_WARN("enum %s not found in enum %s", s.c_str(), meta->name);
 
@@ -2282,9 +2584,9 @@ void sai_deserialize_attr_id(
         throw std::runtime_error("meta pointer is null");
     }
 
-    auto it = AttributesIdMetadata.find(s);
+    *meta = get_attribute_metadata_by_name(s);
 
-    if (it == AttributesIdMetadata.end())
+    if (*meta == NULL)
     {
         if (AttributesIdMetadata.size() == 0)
         {
@@ -2294,8 +2596,6 @@ void sai_deserialize_attr_id(
         SWSS_LOG_ERROR("invalid attr id: %s", s.c_str());
         throw std::runtime_error("invalid attr id");
     }
-
-    *meta = it->second;
 }
 
 void sai_deserialize_attr_id(
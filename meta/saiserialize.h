@@ -26,6 +26,24 @@ sai_status_t transfer_attributes(
         _In_ sai_attribute_t *dst_attr_list,
         _In_ bool countOnly = false);
 
+/**
+ * @brief Deep copy attribute value, allocating lists.
+ *
+ * Copied value must be released by sai_deserialize_free_attribute_value.
+ */
+void sai_copy_attr_value(
+        _In_ const sai_attr_metadata_t &meta,
+        _In_ const sai_attribute_t &src_attr,
+        _Out_ sai_attribute_t &dst_attr);
+
+/**
+ * @brief Compare attribute values, equal if serialized values are equal.
+ */
+bool sai_compare_attr_value(
+        _In_ const sai_attr_metadata_t &meta,
+        _In_ const sai_attribute_t &a,
+        _In_ const sai_attribute_t &b);
+
 // serialize
 
 std::string sai_serialize_ip_address(
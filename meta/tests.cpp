@@ -3,15 +3,15 @@
 
 #include <map>
 #include <iterator>
+#include <thread>
 
 #include "sai_meta.h"
 #include "sai_extra.h"
 #include "saiserialize.h"
 
-class SaiAttrWrapper;
-extern std::unordered_map<std::string,std::unordered_map<sai_attr_id_t,std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
+extern SaiObjectAttrDb ObjectAttrHash;
 extern bool is_ipv6_mask_valid(const uint8_t* mask);
-extern bool object_exists(const std::string& key);
+extern bool object_exists(const sai_object_meta_key_t& meta_key);
 extern bool object_reference_exists(sai_object_id_t oid);
 extern void object_reference_inc(sai_object_id_t oid);
 extern void object_reference_dec(sai_object_id_t oid);
@@ -20,6 +20,10 @@ extern void object_reference_insert(sai_object_id_t oid);
 extern int32_t object_reference_count(sai_object_id_t oid);
 extern std::string get_object_meta_key_string(
         _In_ const sai_object_meta_key_t& meta_key);
+extern void sai_deserialize_enum(
+        _In_ const std::string& s,
+        _In_ const sai_enum_metadata_t *meta,
+        _Out_ int32_t& value);
 
 std::string construct_key(
         _In_ const sai_object_meta_key_t& meta_key,
@@ -912,15 +916,13 @@ void test_fdb_entry_remove()
 
     sai_object_meta_key_t meta = { .object_type = SAI_OBJECT_TYPE_FDB, .key = { .fdb_entry = fdb_entry } };
 
-    std::string key = get_object_meta_key_string(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_fdb_entry(&fdb_entry, &dummy_success_sai_remove_fdb_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 }
 
 void test_fdb_entry_set()
@@ -941,8 +943,7 @@ void test_fdb_entry_set()
 
     // TODO we should use CREATE for this
     sai_object_meta_key_t meta_key_fdb = { .object_type = SAI_OBJECT_TYPE_FDB, .key = { .fdb_entry = fdb_entry } };
-    std::string fdb_key = get_object_meta_key_string(meta_key_fdb);
-    ObjectAttrHash[fdb_key] = { };
+    ObjectAttrHash[meta_key_fdb] = { };
 
     // attr is null
     status = meta_sai_set_fdb_entry(&fdb_entry, NULL, &dummy_success_sai_set_fdb_entry);
@@ -1006,8 +1007,7 @@ void test_fdb_entry_get()
 
     // TODO we should use CREATE for this
     sai_object_meta_key_t meta_key_fdb = { .object_type = SAI_OBJECT_TYPE_FDB, .key = { .fdb_entry = fdb_entry } };
-    std::string fdb_key = get_object_meta_key_string(meta_key_fdb);
-    ObjectAttrHash[fdb_key] = { };
+    ObjectAttrHash[meta_key_fdb] = { };
 
     fdb_entry.vlan_id = 1;
     attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
@@ -1148,8 +1148,7 @@ void test_neighbor_entry_create()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .object_type = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .key = { .object_id = rif } };
-    std::string rif_key = get_object_meta_key_string(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    ObjectAttrHash[meta_key_rif] = { };
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1248,8 +1247,7 @@ void test_neighbor_entry_remove()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .object_type = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .key = { .object_id = rif } };
-    std::string rif_key = get_object_meta_key_string(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    ObjectAttrHash[meta_key_rif] = { };
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1297,15 +1295,13 @@ void test_neighbor_entry_remove()
 
     sai_object_meta_key_t meta = { .object_type = SAI_OBJECT_TYPE_NEIGHBOR, .key = { .neighbor_entry = neighbor_entry } };
 
-    std::string key = get_object_meta_key_string(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_neighbor_entry(&neighbor_entry, &dummy_success_sai_remove_neighbor_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 }
 
 void test_neighbor_entry_set()
@@ -1337,8 +1333,7 @@ void test_neighbor_entry_set()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .object_type = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .key = { .object_id = rif } };
-    std::string rif_key = get_object_meta_key_string(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    ObjectAttrHash[meta_key_rif] = { };
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1415,8 +1410,7 @@ void test_neighbor_entry_get()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .object_type = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .key = { .object_id = rif } };
-    std::string rif_key = get_object_meta_key_string(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    ObjectAttrHash[meta_key_rif] = { };
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1513,8 +1507,7 @@ void test_neighbor_entry_flow()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .object_type = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .key = { .object_id = rif } };
-    std::string rif_key = get_object_meta_key_string(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    ObjectAttrHash[meta_key_rif] = { };
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1571,8 +1564,7 @@ void test_vlan_create()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP_INSTANCE);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .object_type = SAI_OBJECT_TYPE_STP_INSTANCE, .key = { .object_id = stp } };
-    std::string stp_key = get_object_meta_key_string(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    ObjectAttrHash[meta_key_stp] = { };
 
     SWSS_LOG_NOTICE("create tests");
 
@@ -1611,8 +1603,7 @@ void test_vlan_remove()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP_INSTANCE);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .object_type = SAI_OBJECT_TYPE_STP_INSTANCE, .key = { .object_id = stp } };
-    std::string stp_key = get_object_meta_key_string(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    ObjectAttrHash[meta_key_stp] = { };
 
     SWSS_LOG_NOTICE("create");
 
@@ -1659,8 +1650,7 @@ void test_vlan_set()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP_INSTANCE);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .object_type = SAI_OBJECT_TYPE_STP_INSTANCE, .key = { .object_id = stp } };
-    std::string stp_key = get_object_meta_key_string(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    ObjectAttrHash[meta_key_stp] = { };
 
     SWSS_LOG_NOTICE("create");
 
@@ -1757,8 +1747,7 @@ void test_vlan_get()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP_INSTANCE);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .object_type = SAI_OBJECT_TYPE_STP_INSTANCE, .key = { .object_id = stp } };
-    std::string stp_key = get_object_meta_key_string(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    ObjectAttrHash[meta_key_stp] = { };
 
     SWSS_LOG_NOTICE("create");
 
@@ -1868,8 +1857,7 @@ void test_vlan_flow()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP_INSTANCE);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .object_type = SAI_OBJECT_TYPE_STP_INSTANCE, .key = { .object_id = stp } };
-    std::string stp_key = get_object_meta_key_string(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    ObjectAttrHash[meta_key_stp] = { };
 
     SWSS_LOG_NOTICE("create");
 
@@ -1989,14 +1977,12 @@ void test_route_entry_create()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
-    std::string vr_key = get_object_meta_key_string(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    ObjectAttrHash[meta_key_vr] = { };
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .object_type = SAI_OBJECT_TYPE_NEXT_HOP, .key = { .object_id = hop } };
-    std::string hop_key = get_object_meta_key_string(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    ObjectAttrHash[meta_key_hop] = { };
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2118,14 +2104,12 @@ void test_route_entry_remove()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
-    std::string vr_key = get_object_meta_key_string(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    ObjectAttrHash[meta_key_vr] = { };
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .object_type = SAI_OBJECT_TYPE_NEXT_HOP, .key = { .object_id = hop } };
-    std::string hop_key = get_object_meta_key_string(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    ObjectAttrHash[meta_key_hop] = { };
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2189,15 +2173,13 @@ void test_route_entry_remove()
 
     sai_object_meta_key_t meta = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = route_entry } };
 
-    std::string key = get_object_meta_key_string(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_route_entry(&route_entry, &dummy_success_sai_remove_route_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2223,14 +2205,12 @@ void test_route_entry_set()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
-    std::string vr_key = get_object_meta_key_string(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    ObjectAttrHash[meta_key_vr] = { };
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .object_type = SAI_OBJECT_TYPE_NEXT_HOP, .key = { .object_id = hop } };
-    std::string hop_key = get_object_meta_key_string(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    ObjectAttrHash[meta_key_hop] = { };
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2327,14 +2307,12 @@ void test_route_entry_get()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
-    std::string vr_key = get_object_meta_key_string(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    ObjectAttrHash[meta_key_vr] = { };
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .object_type = SAI_OBJECT_TYPE_NEXT_HOP, .key = { .object_id = hop } };
-    std::string hop_key = get_object_meta_key_string(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    ObjectAttrHash[meta_key_hop] = { };
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2413,6 +2391,298 @@ void test_route_entry_get()
     META_ASSERT_SUCCESS(status);
 }
 
+void test_route_entry_bulk_set()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init_db();
+
+    sai_status_t status;
+
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
+    ObjectAttrHash[meta_key_vr] = { };
+
+    const uint32_t count = 4;
+
+    sai_unicast_route_entry_t routes[count];
+    sai_attribute_t attrs[count];
+    sai_status_t statuses[count];
+
+    memset(routes, 0, sizeof(routes));
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        routes[i].vr_id = vr;
+        routes[i].destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        routes[i].destination.addr.ip4 = htonl(0x0a000000 | (i << 8));
+        routes[i].destination.mask.ip4 = htonl(0xffffff00);
+
+        attrs[i].id = SAI_ROUTE_ATTR_PACKET_ACTION;
+        attrs[i].value.s32 = SAI_PACKET_ACTION_DROP;
+
+        if (i != 2)
+        {
+            status = meta_sai_create_route_entry(&routes[i], 0, NULL, &dummy_success_sai_create_route_entry);
+            META_ASSERT_SUCCESS(status);
+        }
+    }
+
+    SWSS_LOG_NOTICE("route 2 doesn't exist, ignore error");
+
+    status = meta_sai_bulk_set_route_entry(count, routes, attrs, false, statuses);
+    META_ASSERT_FAIL(status);
+
+    META_ASSERT_TRUE(statuses[0] == SAI_STATUS_SUCCESS);
+    META_ASSERT_TRUE(statuses[1] == SAI_STATUS_SUCCESS);
+    META_ASSERT_TRUE(statuses[2] == SAI_STATUS_INVALID_PARAMETER);
+    META_ASSERT_TRUE(statuses[3] == SAI_STATUS_SUCCESS);
+
+    SWSS_LOG_NOTICE("stop on error");
+
+    status = meta_sai_bulk_set_route_entry(count, routes, attrs, true, statuses);
+    META_ASSERT_FAIL(status);
+
+    META_ASSERT_TRUE(statuses[1] == SAI_STATUS_SUCCESS);
+    META_ASSERT_TRUE(statuses[2] == SAI_STATUS_INVALID_PARAMETER);
+    META_ASSERT_TRUE(statuses[3] == SAI_STATUS_NOT_EXECUTED);
+
+    SWSS_LOG_NOTICE("invalid attribute on first entry, stop on error");
+
+    attrs[0].id = -1;
+
+    status = meta_sai_bulk_set_route_entry(2, routes, attrs, true, statuses);
+    META_ASSERT_FAIL(status);
+
+    META_ASSERT_TRUE(statuses[1] == SAI_STATUS_NOT_EXECUTED);
+}
+
+void test_object_reverse_references()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init_db();
+
+    sai_status_t status;
+    sai_attribute_t attr;
+
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
+    ObjectAttrHash[meta_key_vr] = { };
+
+    sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
+    object_reference_insert(hop);
+    sai_object_meta_key_t meta_key_hop = { .object_type = SAI_OBJECT_TYPE_NEXT_HOP, .key = { .object_id = hop } };
+    ObjectAttrHash[meta_key_hop] = { };
+
+    sai_unicast_route_entry_t route_entry;
+
+    memset(&route_entry, 0, sizeof(route_entry));
+
+    route_entry.vr_id = vr;
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.destination.addr.ip4 = htonl(0x0a000000);
+    route_entry.destination.mask.ip4 = htonl(0xffffff00);
+
+    sai_object_meta_key_t meta_key_route = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = route_entry } };
+
+    attr.id = SAI_ROUTE_ATTR_NEXT_HOP_ID;
+    attr.value.oid = hop;
+
+    status = meta_sai_create_route_entry(&route_entry, 1, &attr, &dummy_success_sai_create_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    auto refs = meta_get_object_references(vr);
+
+    META_ASSERT_TRUE(refs.size() == 1);
+    META_ASSERT_TRUE(SaiObjectMetaKeyEqual()(refs[0].meta_key, meta_key_route));
+    META_ASSERT_TRUE(refs[0].attr_id == META_REFERENCE_KEY_ATTR_ID);
+
+    refs = meta_get_object_references(hop);
+
+    META_ASSERT_TRUE(refs.size() == 1);
+    META_ASSERT_TRUE(SaiObjectMetaKeyEqual()(refs[0].meta_key, meta_key_route));
+    META_ASSERT_TRUE(refs[0].attr_id == SAI_ROUTE_ATTR_NEXT_HOP_ID);
+    META_ASSERT_TRUE(refs[0].count == 1);
+
+    META_ASSERT_TRUE(meta_get_object_references_string(hop, 1).find("SAI_ROUTE_ATTR_NEXT_HOP_ID") != std::string::npos);
+
+    SWSS_LOG_NOTICE("next hop is in use, ignore error");
+
+    status = meta_sai_remove_oid(SAI_OBJECT_TYPE_NEXT_HOP, hop, &dummy_success_sai_remove_oid);
+    META_ASSERT_FAIL(status);
+
+    attr.value.oid = SAI_NULL_OBJECT_ID;
+
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    META_ASSERT_TRUE(meta_get_object_references(hop).size() == 0);
+
+    status = meta_sai_remove_route_entry(&route_entry, &dummy_success_sai_remove_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    META_ASSERT_TRUE(meta_get_object_references(vr).size() == 0);
+}
+
+void test_fdb_event_concurrent()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init_db();
+
+    sai_object_id_t lag = create_dummy_object_id(SAI_OBJECT_TYPE_LAG);
+    object_reference_insert(lag);
+    sai_object_meta_key_t meta_key_lag = { .object_type = SAI_OBJECT_TYPE_LAG, .key = { .object_id = lag } };
+    ObjectAttrHash[meta_key_lag] = { };
+
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
+    ObjectAttrHash[meta_key_vr] = { };
+
+    const uint32_t count = 1000;
+
+    size_t objects = ObjectAttrHash.size();
+
+    auto fdb_events = [&](sai_fdb_event_t event_type)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            sai_attribute_t attr;
+
+            attr.id = SAI_FDB_ENTRY_ATTR_PORT_ID;
+            attr.value.oid = lag;
+
+            sai_fdb_event_notification_data_t data;
+
+            memset(&data, 0, sizeof(data));
+
+            data.event_type = event_type;
+            data.fdb_entry.vlan_id = 1;
+            data.fdb_entry.mac_address[4] = (uint8_t)(i >> 8);
+            data.fdb_entry.mac_address[5] = (uint8_t)i;
+            data.attr_count = 1;
+            data.attr = &attr;
+
+            meta_sai_on_fdb_event(1, &data);
+        }
+    };
+
+    sai_unicast_route_entry_t routes[count];
+
+    memset(routes, 0, sizeof(routes));
+
+    std::thread learn(fdb_events, SAI_FDB_EVENT_LEARNED);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        routes[i].vr_id = vr;
+        routes[i].destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        routes[i].destination.addr.ip4 = htonl(0x0a000000 | (i << 8));
+        routes[i].destination.mask.ip4 = htonl(0xffffff00);
+
+        sai_status_t status = meta_sai_create_route_entry(&routes[i], 0, NULL, &dummy_success_sai_create_route_entry);
+        META_ASSERT_SUCCESS(status);
+    }
+
+    learn.join();
+
+    META_ASSERT_TRUE(ObjectAttrHash.size() == objects + 2 * count);
+    META_ASSERT_TRUE(object_reference_count(lag) == (int32_t)count);
+    META_ASSERT_TRUE(object_reference_count(vr) == (int32_t)count);
+
+    std::thread age(fdb_events, SAI_FDB_EVENT_AGED);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sai_status_t status = meta_sai_remove_route_entry(&routes[i], &dummy_success_sai_remove_route_entry);
+        META_ASSERT_SUCCESS(status);
+    }
+
+    age.join();
+
+    META_ASSERT_TRUE(ObjectAttrHash.size() == objects);
+    META_ASSERT_TRUE(object_reference_count(lag) == 0);
+    META_ASSERT_TRUE(object_reference_count(vr) == 0);
+}
+
+void test_meta_db_statistics()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init_db();
+
+    sai_status_t status;
+    sai_attribute_t attr;
+
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
+    ObjectAttrHash[meta_key_vr] = { };
+
+    sai_unicast_route_entry_t route_entry;
+
+    memset(&route_entry, 0, sizeof(route_entry));
+
+    route_entry.vr_id = vr;
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.destination.addr.ip4 = htonl(0x0a000000);
+    route_entry.destination.mask.ip4 = htonl(0xffffff00);
+
+    sai_object_meta_key_t meta_key_route = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = route_entry } };
+
+    attr.id = SAI_ROUTE_ATTR_PACKET_ACTION;
+    attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    status = meta_sai_create_route_entry(&route_entry, 1, &attr, &dummy_success_sai_create_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    auto stats = meta_get_db_statistics();
+
+    META_ASSERT_TRUE(stats.objecttypes[SAI_OBJECT_TYPE_ROUTE].objects == 1);
+    META_ASSERT_TRUE(stats.objecttypes[SAI_OBJECT_TYPE_ROUTE].attributes[SAI_ROUTE_ATTR_PACKET_ACTION].count == 1);
+    META_ASSERT_TRUE(stats.objects == ObjectAttrHash.size());
+    META_ASSERT_TRUE(stats.bytes > 0);
+
+    std::string s = meta_serialize_db_statistics(stats);
+
+    META_ASSERT_TRUE(s.find("SAI_ROUTE_ATTR_PACKET_ACTION") != std::string::npos);
+
+    SWSS_LOG_NOTICE("compact mode, default value is not stored");
+
+    meta_set_compact_mode(true);
+
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    META_ASSERT_TRUE(ObjectAttrHash[meta_key_route].size() == 0);
+
+    attr.value.s32 = SAI_PACKET_ACTION_DROP;
+
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    META_ASSERT_TRUE(ObjectAttrHash[meta_key_route].size() == 1);
+
+    attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    stats = meta_get_db_statistics();
+
+    META_ASSERT_TRUE(stats.objecttypes[SAI_OBJECT_TYPE_ROUTE].objects == 1);
+    META_ASSERT_TRUE(stats.objecttypes[SAI_OBJECT_TYPE_ROUTE].attributes.size() == 0);
+
+    status = meta_sai_remove_route_entry(&route_entry, &dummy_success_sai_remove_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    meta_set_compact_mode(false);
+}
+
 void test_route_entry_flow()
 {
     SWSS_LOG_ENTER();
@@ -2428,14 +2698,12 @@ void test_route_entry_flow()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .object_type = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .key = { .object_id = vr } };
-    std::string vr_key = get_object_meta_key_string(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    ObjectAttrHash[meta_key_vr] = { };
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .object_type = SAI_OBJECT_TYPE_NEXT_HOP, .key = { .object_id = hop } };
-    std::string hop_key = get_object_meta_key_string(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    ObjectAttrHash[meta_key_hop] = { };
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2579,20 +2847,17 @@ void test_trap_set()
     sai_object_id_t group = create_dummy_object_id(SAI_OBJECT_TYPE_TRAP_GROUP);
     object_reference_insert(group);
     sai_object_meta_key_t meta_key_group = { .object_type = SAI_OBJECT_TYPE_TRAP_GROUP, .key = { .object_id = group } };
-    std::string group_key = get_object_meta_key_string(meta_key_group);
-    ObjectAttrHash[group_key] = { };
+    ObjectAttrHash[meta_key_group] = { };
 
     sai_object_id_t port1 = create_dummy_object_id(SAI_OBJECT_TYPE_PORT);
     object_reference_insert(port1);
     sai_object_meta_key_t meta_key_port1 = { .object_type = SAI_OBJECT_TYPE_PORT, .key = { .object_id = port1 } };
-    std::string port1_key = get_object_meta_key_string(meta_key_port1);
-    ObjectAttrHash[port1_key] = { };
+    ObjectAttrHash[meta_key_port1] = { };
 
     sai_object_id_t port2 = create_dummy_object_id(SAI_OBJECT_TYPE_PORT);
     object_reference_insert(port2);
     sai_object_meta_key_t meta_key_port2 = { .object_type = SAI_OBJECT_TYPE_PORT, .key = { .object_id = port2 } };
-    std::string port2_key = get_object_meta_key_string(meta_key_port2);
-    ObjectAttrHash[port2_key] = { };
+    ObjectAttrHash[meta_key_port2] = { };
 
     SWSS_LOG_NOTICE("set tests");
 
@@ -2678,14 +2943,12 @@ void test_trap_get()
     sai_object_id_t port1 = create_dummy_object_id(SAI_OBJECT_TYPE_PORT);
     object_reference_insert(port1);
     sai_object_meta_key_t meta_key_port1 = { .object_type = SAI_OBJECT_TYPE_PORT, .key = { .object_id = port1 } };
-    std::string port1_key = get_object_meta_key_string(meta_key_port1);
-    ObjectAttrHash[port1_key] = { };
+    ObjectAttrHash[meta_key_port1] = { };
 
     sai_object_id_t port2 = create_dummy_object_id(SAI_OBJECT_TYPE_PORT);
     object_reference_insert(port2);
     sai_object_meta_key_t meta_key_port2 = { .object_type = SAI_OBJECT_TYPE_PORT, .key = { .object_id = port2 } };
-    std::string port2_key = get_object_meta_key_string(meta_key_port2);
-    ObjectAttrHash[port2_key] = { };
+    ObjectAttrHash[meta_key_port2] = { };
 
     sai_hostif_trap_id_t trapid = SAI_HOSTIF_TRAP_ID_LLDP;
 
@@ -2853,8 +3116,7 @@ void test_serialization_type_char()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .object_type = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .key = { .object_id = rif } };
-    std::string rif_key = get_object_meta_key_string(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    ObjectAttrHash[meta_key_rif] = { };
 
     sai_attribute_t attr, attr2, attr3;
 
@@ -3031,8 +3293,7 @@ sai_object_id_t insert_dummy_object(sai_object_type_t ot)
     sai_object_id_t oid = create_dummy_object_id(ot);
     object_reference_insert(oid);
     sai_object_meta_key_t meta_key_oid = { .object_type = ot, .key = { .object_id = oid } };
-    std::string oid_key = get_object_meta_key_string(meta_key_oid);
-    ObjectAttrHash[oid_key] = { };
+    ObjectAttrHash[meta_key_oid] = { };
 
     return oid;
 }
@@ -3225,6 +3486,14 @@ void test_construct_key()
     SWSS_LOG_NOTICE("constructed key: %s", key.c_str());
 
     META_ASSERT_TRUE(key == "SAI_PORT_ATTR_HW_LANE_LIST:1,2,3,4;");
+
+    uint32_t unsorted[4] = {3,1,4,2};
+
+    attr.value.u32list.list = unsorted;
+
+    key = construct_key(meta_key, 1, &attr);
+
+    META_ASSERT_TRUE(key == "SAI_PORT_ATTR_HW_LANE_LIST:1,2,3,4;");
 }
 
 void test_queue_create()
@@ -4176,6 +4445,158 @@ void test_numbers()
     ASSERT_TRUE(u,   0x12345678);
 }
 
+void test_object_meta_key()
+{
+    SWSS_LOG_ENTER();
+
+    SaiObjectMetaKeyHash hash;
+    SaiObjectMetaKeyEqual equal;
+
+    // unused part of ipv4 address and mask should not affect key
+
+    sai_unicast_route_entry_t route_entry;
+
+    memset(&route_entry, 0, sizeof(route_entry));
+
+    route_entry.vr_id = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.destination.addr.ip4 = htonl(0x0a000000);
+    route_entry.destination.mask.ip4 = htonl(0xff000000);
+
+    sai_object_meta_key_t a = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = route_entry } };
+
+    route_entry.destination.addr.ip6[15] = 0x11;
+    route_entry.destination.mask.ip6[15] = 0x22;
+
+    sai_object_meta_key_t b = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = route_entry } };
+
+    META_ASSERT_TRUE(equal(a, b));
+    META_ASSERT_TRUE(hash(a) == hash(b));
+
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+
+    sai_object_meta_key_t c = { .object_type = SAI_OBJECT_TYPE_ROUTE, .key = { .route_entry = route_entry } };
+
+    META_ASSERT_TRUE(!equal(a, c));
+
+    // object id keys share the same key space, like string "oid:" key
+
+    sai_object_id_t oid = create_dummy_object_id(SAI_OBJECT_TYPE_PORT);
+
+    sai_object_meta_key_t port = { .object_type = SAI_OBJECT_TYPE_PORT, .key = { .object_id = oid } };
+    sai_object_meta_key_t lag = { .object_type = SAI_OBJECT_TYPE_LAG, .key = { .object_id = oid } };
+
+    META_ASSERT_TRUE(equal(port, lag));
+    META_ASSERT_TRUE(hash(port) == hash(lag));
+
+    sai_object_meta_key_t vlan1 = { .object_type = SAI_OBJECT_TYPE_VLAN, .key = { .vlan_id = 1 } };
+    sai_object_meta_key_t vlan2 = { .object_type = SAI_OBJECT_TYPE_VLAN, .key = { .vlan_id = 2 } };
+
+    META_ASSERT_TRUE(!equal(vlan1, vlan2));
+}
+
+void test_object_type_attr_metadata()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init_db();
+
+    const auto* t = get_object_type_attr_metadata(SAI_OBJECT_TYPE_PORT);
+
+    META_ASSERT_TRUE(t != NULL);
+    META_ASSERT_TRUE(get_object_type_attr_metadata(SAI_OBJECT_TYPE_MAX) == NULL);
+
+    const auto* md = get_attribute_metadata(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_HW_LANE_LIST);
+
+    META_ASSERT_TRUE(md != NULL && md->attrid == SAI_PORT_ATTR_HW_LANE_LIST);
+    META_ASSERT_TRUE(get_attribute_metadata(SAI_OBJECT_TYPE_PORT, META_DENSE_ATTR_ID_MAX + 1) == NULL);
+
+    META_ASSERT_TRUE(t->attributes.size() == get_attributes_metadata(SAI_OBJECT_TYPE_PORT).size());
+
+    for (auto m: t->mandatoryoncreate)
+    {
+        META_ASSERT_TRUE(HAS_FLAG_MANDATORY_ON_CREATE(m->flags) && !m->isconditional());
+    }
+
+    bool found = false;
+
+    for (auto m: get_object_type_attr_metadata(SAI_OBJECT_TYPE_ROUTE)->objectids)
+    {
+        found |= (m->attrid == SAI_ROUTE_ATTR_NEXT_HOP_ID);
+    }
+
+    META_ASSERT_TRUE(found);
+}
+
+void test_copy_attr_value()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init_db();
+
+    sai_object_id_t list[4] = {
+        create_dummy_object_id(SAI_OBJECT_TYPE_PORT),
+        create_dummy_object_id(SAI_OBJECT_TYPE_PORT),
+        create_dummy_object_id(SAI_OBJECT_TYPE_PORT),
+        create_dummy_object_id(SAI_OBJECT_TYPE_PORT) };
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_LAG_ATTR_PORT_LIST;
+    attr.value.objlist.count = 4;
+    attr.value.objlist.list = list;
+
+    const auto& md = *get_attribute_metadata(SAI_OBJECT_TYPE_LAG, SAI_LAG_ATTR_PORT_LIST);
+
+    sai_attribute_t copy;
+
+    sai_copy_attr_value(md, attr, copy);
+
+    META_ASSERT_TRUE(copy.value.objlist.list != list);
+    META_ASSERT_TRUE(sai_compare_attr_value(md, attr, copy));
+    META_ASSERT_TRUE(sai_serialize_attr_value(md, attr) == sai_serialize_attr_value(md, copy));
+
+    copy.value.objlist.list[3] = SAI_NULL_OBJECT_ID;
+
+    META_ASSERT_TRUE(!sai_compare_attr_value(md, attr, copy));
+
+    sai_deserialize_free_attribute_value(md.serializationtype, copy);
+}
+
+void test_perfect_hash_deserialize()
+{
+    SWSS_LOG_ENTER();
+
+    meta_init();
+
+    for (const auto& a: AttributesIdMetadata)
+    {
+        META_ASSERT_TRUE(get_attribute_metadata_by_name(a.first) == a.second);
+
+        sai_attr_id_t attrid;
+
+        sai_deserialize_attr_id(a.first, attrid);
+
+        META_ASSERT_TRUE(attrid == a.second->attrid);
+    }
+
+    META_ASSERT_TRUE(get_attribute_metadata_by_name("SAI_ROUTE_ATTR_FOO") == NULL);
+    META_ASSERT_TRUE(get_attribute_metadata_by_name("") == NULL);
+
+    const sai_enum_metadata_t* meta = &metadata_enum_sai_hostif_trap_type_t;
+
+    META_ASSERT_TRUE(get_enum_values_perfect_hash(meta) != NULL);
+
+    for (size_t i = 0; i < meta->valuescount; ++i)
+    {
+        int32_t value;
+
+        sai_deserialize_enum(meta->valuesnames[i], meta, value);
+
+        META_ASSERT_TRUE(value == meta->values[i]);
+    }
+}
+
 int main()
 {
     swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
@@ -4226,6 +4647,10 @@ int main()
     test_route_entry_set();
     test_route_entry_get();
     test_route_entry_flow();
+    test_route_entry_bulk_set();
+    test_fdb_event_concurrent();
+    test_object_reverse_references();
+    test_meta_db_statistics();
 
     test_trap_set();
     test_trap_get();
@@ -4246,5 +4671,10 @@ int main()
 
     test_priority_group();
 
+    test_object_meta_key();
+    test_object_type_attr_metadata();
+    test_copy_attr_value();
+    test_perfect_hash_deserialize();
+
     std::cout << "SUCCESS" << std::endl;
 }
@@ -997,6 +997,10 @@ void performNotifySyncd(const std::string& request, const std::string response)
     {
         attr.value.s32 = SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW;
     }
+    else if (requestAction == SYNCD_APPLY_VIEW_DRY_RUN)
+    {
+        attr.value.s32 = SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW_DRY_RUN;
+    }
     else
     {
         SWSS_LOG_ERROR("invalid syncd notify request: %s", request.c_str());
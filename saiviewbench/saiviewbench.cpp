@@ -0,0 +1,662 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include <getopt.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "swss/logger.h"
+#include "swss/json.hpp"
+#include "sairedis.h"
+
+using json = nlohmann::json;
+
+/*
+ * Apply view benchmark.
+ *
+ * Generates two synthetic views (routes, neighbors, next hops, next hop
+ * groups, ACL rules) and sends them to running syncd (built against vslib)
+ * as two consecutive init/apply view sequences, where second view differs
+ * from first one by configured churn. Time of second apply view is measured
+ * and report returned by syncd (phase times, ASIC operations and peak RSS)
+ * is printed.
+ */
+
+const char *test_profile_get_value (
+        _In_ sai_switch_profile_id_t profile_id,
+        _In_ const char *variable)
+{
+    SWSS_LOG_ENTER();
+
+    return NULL;
+}
+
+int test_profile_get_next_value (
+        _In_ sai_switch_profile_id_t profile_id,
+        _Out_ const char **variable,
+        _Out_ const char **value)
+{
+    SWSS_LOG_ENTER();
+
+    return -1;
+}
+
+const service_method_table_t test_services = {
+    test_profile_get_value,
+    test_profile_get_next_value
+};
+
+void on_switch_state_change(
+        _In_ sai_switch_oper_status_t switch_oper_status)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_fdb_event(
+        _In_ uint32_t count,
+        _In_ sai_fdb_event_notification_data_t *data)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_port_state_change(
+        _In_ uint32_t count,
+        _In_ sai_port_oper_status_notification_t *data)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_port_event(
+        _In_ uint32_t count,
+        _In_ sai_port_event_notification_t *data)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_switch_shutdown_request() __attribute__ ((noreturn));
+void on_switch_shutdown_request()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_ERROR("got shutdown request, syncd failed!");
+    exit(EXIT_FAILURE);
+}
+
+void on_packet_event(
+        _In_ const void *buffer,
+        _In_ sai_size_t buffer_size,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+}
+
+sai_switch_notification_t switch_notifications
+{
+    on_switch_state_change,
+        on_fdb_event,
+        on_port_state_change,
+        on_port_event,
+        on_switch_shutdown_request,
+        on_packet_event
+};
+
+#define EXIT_ON_ERROR(x)\
+{\
+    sai_status_t s = (x);\
+    if (s != SAI_STATUS_SUCCESS)\
+    {\
+        SWSS_LOG_ERROR("fail status %d on: %s", s, #x);\
+        std::cerr << "failed: " << #x << std::endl;\
+        exit(EXIT_FAILURE);\
+    }\
+}
+
+sai_switch_api_t             *sai_switch_api;
+sai_router_interface_api_t   *sai_router_interface_api;
+sai_neighbor_api_t           *sai_neighbor_api;
+sai_next_hop_api_t           *sai_next_hop_api;
+sai_next_hop_group_api_t     *sai_next_hop_group_api;
+sai_route_api_t              *sai_route_api;
+sai_acl_api_t                *sai_acl_api;
+
+struct BenchConfig
+{
+    uint32_t routes = 10000;
+    uint32_t neighbors = 256;
+    uint32_t nextHops = 256;
+    uint32_t nextHopGroups = 64;
+    uint32_t nextHopGroupSize = 4;
+    uint32_t aclRules = 512;
+    uint32_t churn = 10;
+    uint32_t seed = 1;
+};
+
+BenchConfig g_config;
+
+/**
+ * @brief Objects selected to be different in second view.
+ *
+ * Each object is churned with probability of configured churn percent,
+ * selection depends only on seed, so runs are repeatable.
+ */
+struct BenchChurn
+{
+    std::vector<bool> routes;
+    std::vector<bool> neighbors;
+    std::vector<bool> nextHopGroups;
+    std::vector<bool> aclRules;
+};
+
+std::vector<bool> selectChurn(
+        _In_ std::mt19937 &gen,
+        _In_ uint32_t count)
+{
+    SWSS_LOG_ENTER();
+
+    std::uniform_int_distribution<uint32_t> dist(0, 99);
+
+    std::vector<bool> churn(count);
+
+    for (uint32_t idx = 0; idx < count; ++idx)
+    {
+        churn[idx] = dist(gen) < g_config.churn;
+    }
+
+    return churn;
+}
+
+sai_ip_address_t makeIpv4(
+        _In_ uint32_t address)
+{
+    SWSS_LOG_ENTER();
+
+    sai_ip_address_t ip;
+
+    ip.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    ip.addr.ip4 = htonl(address);
+
+    return ip;
+}
+
+void setMac(
+        _Out_ sai_mac_t mac,
+        _In_ uint32_t value)
+{
+    SWSS_LOG_ENTER();
+
+    mac[0] = 0x02;
+    mac[1] = 0x00;
+    mac[2] = (uint8_t)(value >> 24);
+    mac[3] = (uint8_t)(value >> 16);
+    mac[4] = (uint8_t)(value >> 8);
+    mac[5] = (uint8_t)(value);
+}
+
+void notifySyncd(
+        _In_ sai_redis_notify_syncd_t op)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_NOTIFY_SYNCD;
+    attr.value.s32 = op;
+
+    EXIT_ON_ERROR(sai_switch_api->set_switch_attribute(&attr));
+}
+
+/**
+ * @brief Create view using SAI API.
+ *
+ * When churned is false, view contains base objects, otherwise selected
+ * objects are modified: neighbors get different MAC, next hop groups get
+ * members in reversed order and one member replaced, routes point to
+ * different next hop or are replaced by different prefix, and ACL rules get
+ * different priority and destination.
+ */
+void createView(
+        _In_ const BenchChurn &churn,
+        _In_ bool churned)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    std::vector<sai_object_id_t> ports(1024);
+
+    attr.id = SAI_SWITCH_ATTR_PORT_LIST;
+    attr.value.objlist.count = (uint32_t)ports.size();
+    attr.value.objlist.list = ports.data();
+
+    EXIT_ON_ERROR(sai_switch_api->get_switch_attribute(1, &attr));
+
+    ports.resize(attr.value.objlist.count);
+
+    attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+
+    EXIT_ON_ERROR(sai_switch_api->get_switch_attribute(1, &attr));
+
+    sai_object_id_t vr = attr.value.oid;
+
+    if (ports.empty())
+    {
+        SWSS_LOG_ERROR("switch has no ports");
+        exit(EXIT_FAILURE);
+    }
+
+    /*
+     * One router interface per port used by neighbors.
+     */
+
+    uint32_t rifCount = std::min<uint32_t>((uint32_t)ports.size(), std::max<uint32_t>(g_config.neighbors, 1));
+
+    std::vector<sai_object_id_t> rifs(rifCount);
+
+    for (uint32_t idx = 0; idx < rifCount; ++idx)
+    {
+        sai_attribute_t attrs[4];
+
+        attrs[0].id = SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID;
+        attrs[0].value.oid = vr;
+
+        attrs[1].id = SAI_ROUTER_INTERFACE_ATTR_TYPE;
+        attrs[1].value.s32 = SAI_ROUTER_INTERFACE_TYPE_PORT;
+
+        attrs[2].id = SAI_ROUTER_INTERFACE_ATTR_PORT_ID;
+        attrs[2].value.oid = ports[idx];
+
+        attrs[3].id = SAI_ROUTER_INTERFACE_ATTR_SRC_MAC_ADDRESS;
+        setMac(attrs[3].value.mac, 0xffff0000);
+
+        EXIT_ON_ERROR(sai_router_interface_api->create_router_interface(&rifs[idx], 4, attrs));
+    }
+
+    for (uint32_t idx = 0; idx < g_config.neighbors; ++idx)
+    {
+        sai_neighbor_entry_t ne;
+
+        ne.rif_id = rifs[idx % rifCount];
+        ne.ip_address = makeIpv4(0x0a000000 + idx + 1);
+
+        attr.id = SAI_NEIGHBOR_ATTR_DST_MAC_ADDRESS;
+        setMac(attr.value.mac, (churned && churn.neighbors[idx]) ? idx + 0x10000 : idx);
+
+        EXIT_ON_ERROR(sai_neighbor_api->create_neighbor_entry(&ne, 1, &attr));
+    }
+
+    std::vector<sai_object_id_t> nextHops(g_config.nextHops);
+
+    for (uint32_t idx = 0; idx < g_config.nextHops; ++idx)
+    {
+        sai_attribute_t attrs[3];
+
+        attrs[0].id = SAI_NEXT_HOP_ATTR_TYPE;
+        attrs[0].value.s32 = SAI_NEXT_HOP_IP;
+
+        attrs[1].id = SAI_NEXT_HOP_ATTR_IP;
+        attrs[1].value.ipaddr = makeIpv4(0x0a000000 + (idx % std::max<uint32_t>(g_config.neighbors, 1)) + 1);
+
+        attrs[2].id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+        attrs[2].value.oid = rifs[idx % rifCount];
+
+        EXIT_ON_ERROR(sai_next_hop_api->create_next_hop(&nextHops[idx], 3, attrs));
+    }
+
+    std::vector<sai_object_id_t> groups(nextHops.empty() ? 0 : g_config.nextHopGroups);
+
+    for (uint32_t idx = 0; idx < groups.size(); ++idx)
+    {
+        std::vector<sai_object_id_t> members;
+
+        for (uint32_t m = 0; m < g_config.nextHopGroupSize; ++m)
+        {
+            members.push_back(nextHops[(idx + m) % nextHops.size()]);
+        }
+
+        if (churned && churn.nextHopGroups[idx])
+        {
+            std::reverse(members.begin(), members.end());
+
+            members[0] = nextHops[(idx + g_config.nextHopGroupSize) % nextHops.size()];
+        }
+
+        sai_attribute_t attrs[2];
+
+        attrs[0].id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+        attrs[0].value.s32 = SAI_NEXT_HOP_GROUP_ECMP;
+
+        attrs[1].id = SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_LIST;
+        attrs[1].value.objlist.count = (uint32_t)members.size();
+        attrs[1].value.objlist.list = members.data();
+
+        EXIT_ON_ERROR(sai_next_hop_group_api->create_next_hop_group(&groups[idx], 2, attrs));
+    }
+
+    if (!nextHops.empty())
+    {
+        for (uint32_t idx = 0; idx < g_config.routes; ++idx)
+        {
+            bool changed = churned && churn.routes[idx];
+
+            sai_unicast_route_entry_t re;
+
+            re.vr_id = vr;
+            re.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+
+            /*
+             * Half of churned routes is replaced by different prefix, other
+             * half points to different next hop.
+             */
+
+            uint32_t prefix = 0x14000000 + idx;
+
+            if (changed && (idx % 2))
+            {
+                prefix += 0x01000000;
+            }
+
+            re.destination.addr.ip4 = htonl(prefix);
+            re.destination.mask.ip4 = htonl(0xffffffff);
+
+            uint32_t target = changed ? idx + 1 : idx;
+
+            attr.id = SAI_ROUTE_ATTR_NEXT_HOP_ID;
+            attr.value.oid = (!groups.empty() && (target % 2))
+                ? groups[target % groups.size()]
+                : nextHops[target % nextHops.size()];
+
+            EXIT_ON_ERROR(sai_route_api->create_route(&re, 1, &attr));
+        }
+    }
+
+    if (g_config.aclRules == 0)
+    {
+        return;
+    }
+
+    sai_object_id_t table;
+
+    {
+        sai_attribute_t attrs[3];
+
+        attrs[0].id = SAI_ACL_TABLE_ATTR_STAGE;
+        attrs[0].value.s32 = SAI_ACL_STAGE_INGRESS;
+
+        attrs[1].id = SAI_ACL_TABLE_ATTR_PRIORITY;
+        attrs[1].value.u32 = 10;
+
+        attrs[2].id = SAI_ACL_TABLE_ATTR_FIELD_DST_IP;
+        attrs[2].value.booldata = true;
+
+        EXIT_ON_ERROR(sai_acl_api->create_acl_table(&table, 3, attrs));
+    }
+
+    for (uint32_t idx = 0; idx < g_config.aclRules; ++idx)
+    {
+        bool changed = churned && churn.aclRules[idx];
+
+        sai_attribute_t attrs[4];
+
+        attrs[0].id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
+        attrs[0].value.oid = table;
+
+        attrs[1].id = SAI_ACL_ENTRY_ATTR_PRIORITY;
+        attrs[1].value.u32 = changed ? idx + 1000000 : idx + 1;
+
+        attrs[2].id = SAI_ACL_ENTRY_ATTR_FIELD_DST_IP;
+        attrs[2].value.aclfield.enable = true;
+        attrs[2].value.aclfield.data.ip4 = htonl(0x1e000000 + (changed ? idx + 0x10000 : idx));
+        attrs[2].value.aclfield.mask.ip4 = htonl(0xffffffff);
+
+        attrs[3].id = SAI_ACL_ENTRY_ATTR_PACKET_ACTION;
+        attrs[3].value.aclaction.enable = true;
+        attrs[3].value.aclaction.parameter.s32 = SAI_PACKET_ACTION_DROP;
+
+        sai_object_id_t entry;
+
+        EXIT_ON_ERROR(sai_acl_api->create_acl_entry(&entry, 4, attrs));
+    }
+}
+
+double applyView(
+        _In_ const BenchChurn &churn,
+        _In_ bool churned)
+{
+    SWSS_LOG_ENTER();
+
+    notifySyncd(SAI_REDIS_NOTIFY_SYNCD_INIT_VIEW);
+
+    auto start = std::chrono::steady_clock::now();
+
+    createView(churn, churned);
+
+    auto created = std::chrono::steady_clock::now();
+
+    notifySyncd(SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW);
+
+    auto applied = std::chrono::steady_clock::now();
+
+    std::cout << (churned ? "second" : "first") << " view created in "
+        << std::chrono::duration<double>(created - start).count() << " s, applied in "
+        << std::chrono::duration<double>(applied - created).count() << " s" << std::endl;
+
+    return std::chrono::duration<double>(applied - created).count();
+}
+
+void printApplyViewReport()
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_APPLY_VIEW_REPORT;
+    attr.value.s8list.count = 0;
+    attr.value.s8list.list = NULL;
+
+    sai_status_t status = sai_switch_api->get_switch_attribute(1, &attr);
+
+    if (status != SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        EXIT_ON_ERROR(status);
+    }
+
+    std::vector<int8_t> buffer(attr.value.s8list.count);
+
+    attr.value.s8list.list = buffer.data();
+
+    EXIT_ON_ERROR(sai_switch_api->get_switch_attribute(1, &attr));
+
+    json report = json::parse((const char*)buffer.data());
+
+    if (report.empty())
+    {
+        std::cerr << "apply view report not received from syncd" << std::endl;
+
+        exit(EXIT_FAILURE);
+    }
+
+    std::cout << "syncd apply view report:" << std::endl;
+
+    for (auto it = report.begin(); it != report.end(); ++it)
+    {
+        std::cout << "    " << it.key() << ": " << it.value().get<std::string>() << std::endl;
+    }
+}
+
+void printUsage()
+{
+    std::cout << "Usage: saiviewbench [-h] [options]" << std::endl << std::endl;
+    std::cout << "    -r --routes N:" << std::endl;
+    std::cout << "        Number of routes (default " << g_config.routes << ")" << std::endl << std::endl;
+    std::cout << "    -n --neighbors N:" << std::endl;
+    std::cout << "        Number of neighbors (default " << g_config.neighbors << ")" << std::endl << std::endl;
+    std::cout << "    -x --nextHops N:" << std::endl;
+    std::cout << "        Number of next hops (default " << g_config.nextHops << ")" << std::endl << std::endl;
+    std::cout << "    -g --nextHopGroups N:" << std::endl;
+    std::cout << "        Number of next hop groups (default " << g_config.nextHopGroups << ")" << std::endl << std::endl;
+    std::cout << "    -m --nextHopGroupSize N:" << std::endl;
+    std::cout << "        Number of next hops in group (default " << g_config.nextHopGroupSize << ")" << std::endl << std::endl;
+    std::cout << "    -a --aclRules N:" << std::endl;
+    std::cout << "        Number of ACL rules (default " << g_config.aclRules << ")" << std::endl << std::endl;
+    std::cout << "    -c --churn P:" << std::endl;
+    std::cout << "        Percent of objects changed in second view (default " << g_config.churn << ")" << std::endl << std::endl;
+    std::cout << "    -s --seed N:" << std::endl;
+    std::cout << "        Seed for selecting changed objects (default " << g_config.seed << ")" << std::endl << std::endl;
+    std::cout << "    -d --enableDebug:" << std::endl;
+    std::cout << "        Enable syslog debug messages" << std::endl << std::endl;
+    std::cout << "    -h --help:" << std::endl;
+    std::cout << "        Print out this message" << std::endl << std::endl;
+}
+
+void handleCmdLine(int argc, char **argv)
+{
+    SWSS_LOG_ENTER();
+
+    while(true)
+    {
+        static struct option long_options[] =
+        {
+            { "routes",           required_argument, 0, 'r' },
+            { "neighbors",        required_argument, 0, 'n' },
+            { "nextHops",         required_argument, 0, 'x' },
+            { "nextHopGroups",    required_argument, 0, 'g' },
+            { "nextHopGroupSize", required_argument, 0, 'm' },
+            { "aclRules",         required_argument, 0, 'a' },
+            { "churn",            required_argument, 0, 'c' },
+            { "seed",             required_argument, 0, 's' },
+            { "enableDebug",      no_argument,       0, 'd' },
+            { "help",             no_argument,       0, 'h' },
+            { 0,                  0,                 0,  0  }
+        };
+
+        const char* const optstring = "r:n:x:g:m:a:c:s:dh";
+
+        int option_index;
+
+        int c = getopt_long(argc, argv, optstring, long_options, &option_index);
+
+        if (c == -1)
+            break;
+
+        switch (c)
+        {
+            case 'r':
+                g_config.routes = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'n':
+                g_config.neighbors = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'x':
+                g_config.nextHops = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'g':
+                g_config.nextHopGroups = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'm':
+                g_config.nextHopGroupSize = (uint32_t)std::max<unsigned long>(std::stoul(optarg), 1);
+                break;
+
+            case 'a':
+                g_config.aclRules = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'c':
+                g_config.churn = (uint32_t)std::min<unsigned long>(std::stoul(optarg), 100);
+                break;
+
+            case 's':
+                g_config.seed = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'd':
+                swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
+                break;
+
+            case 'h':
+                printUsage();
+                exit(EXIT_SUCCESS);
+
+            case '?':
+                SWSS_LOG_WARN("unknown option %c", optopt);
+                printUsage();
+                exit(EXIT_FAILURE);
+
+            default:
+                SWSS_LOG_ERROR("getopt_long failure");
+                exit(EXIT_FAILURE);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
+
+    SWSS_LOG_ENTER();
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_NOTICE);
+
+    handleCmdLine(argc, argv);
+
+    std::mt19937 gen(g_config.seed);
+
+    BenchChurn churn;
+
+    churn.routes        = selectChurn(gen, g_config.routes);
+    churn.neighbors     = selectChurn(gen, g_config.neighbors);
+    churn.nextHopGroups = selectChurn(gen, g_config.nextHopGroups);
+    churn.aclRules      = selectChurn(gen, g_config.aclRules);
+
+    EXIT_ON_ERROR(sai_api_initialize(0, (const service_method_table_t *)&test_services));
+
+    sai_api_query(SAI_API_SWITCH,           (void**)&sai_switch_api);
+    sai_api_query(SAI_API_ROUTER_INTERFACE, (void**)&sai_router_interface_api);
+    sai_api_query(SAI_API_NEIGHBOR,         (void**)&sai_neighbor_api);
+    sai_api_query(SAI_API_NEXT_HOP,         (void**)&sai_next_hop_api);
+    sai_api_query(SAI_API_NEXT_HOP_GROUP,   (void**)&sai_next_hop_group_api);
+    sai_api_query(SAI_API_ROUTE,            (void**)&sai_route_api);
+    sai_api_query(SAI_API_ACL,              (void**)&sai_acl_api);
+
+    EXIT_ON_ERROR(sai_switch_api->initialize_switch(0, "", "", &switch_notifications));
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_USE_TEMP_VIEW;
+    attr.value.booldata = true;
+
+    EXIT_ON_ERROR(sai_switch_api->set_switch_attribute(&attr));
+
+    /*
+     * First view brings syncd to known state, second view is the measured
+     * transition.
+     */
+
+    applyView(churn, false);
+
+    double seconds = applyView(churn, true);
+
+    std::cout << "apply view with " << g_config.churn << "% churn took " << seconds << " s" << std::endl;
+
+    printApplyViewReport();
+
+    sai_switch_api->shutdown_switch(false);
+
+    sai_api_uninitialize();
+
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <map>
 #include "syncd.h"
+#include "syncd_redis_pipeline.h"
+#include "syncd_warm_snapshot.h"
 #include "sairedis.h"
 #include "swss/tokenize.h"
 #include <limits.h>
@@ -961,14 +963,14 @@ sai_status_t handle_trap(
     }
 }
 
-void sendResponse(sai_status_t status)
+void sendResponse(
+        _In_ sai_status_t status,
+        _In_ const std::vector<swss::FieldValueTuple> &entry = std::vector<swss::FieldValueTuple>())
 {
     SWSS_LOG_ENTER();
 
     std::string str_status = sai_serialize_status(status);
 
-    std::vector<swss::FieldValueTuple> entry;
-
     SWSS_LOG_NOTICE("sending response: %s", str_status.c_str());
 
     getResponse->set(str_status, entry, "notify");
@@ -1031,6 +1033,10 @@ sai_status_t notifySyncd(const std::string& op)
 
             SWSS_LOG_NOTICE("setting very first run to FALSE, op = %s", op.c_str());
         }
+        else if (op == SYNCD_APPLY_VIEW_DRY_RUN)
+        {
+            SWSS_LOG_NOTICE("nothing to compare on very first run, op = %s", op.c_str());
+        }
         else
         {
             SWSS_LOG_ERROR("unknown operation: %s", op.c_str());
@@ -1065,9 +1071,11 @@ sai_status_t notifySyncd(const std::string& op)
 
         SWSS_LOG_WARN("syncd received APPLY VIEW, will translate");
 
-        sai_status_t status = syncdApplyView();
+        std::vector<swss::FieldValueTuple> report;
+
+        sai_status_t status = syncdApplyView(report);
 
-        sendResponse(status);
+        sendResponse(status, report);
 
         if (status == SAI_STATUS_SUCCESS)
         {
@@ -1082,6 +1090,21 @@ sai_status_t notifySyncd(const std::string& op)
             local_vid_to_rid.clear();
         }
     }
+    else if (op == SYNCD_APPLY_VIEW_DRY_RUN)
+    {
+        /*
+         * Dry run don't change ASIC nor redis database, so we stay in
+         * current mode and temporary view can still be populated.
+         */
+
+        SWSS_LOG_NOTICE("syncd received APPLY VIEW dry run, will compare views");
+
+        std::vector<swss::FieldValueTuple> report;
+
+        sai_status_t status = syncdApplyViewDryRun(report);
+
+        sendResponse(status, report);
+    }
     else
     {
         SWSS_LOG_ERROR("unknown operation: %s", op.c_str());
@@ -1400,6 +1423,18 @@ sai_status_t processEvent(swss::ConsumerTable &consumer)
 
     SWSS_LOG_INFO("key: %s op: %s", key.c_str(), op.c_str());
 
+    /*
+     * Apply view compares with whole current view, and bulk operations are
+     * not inspected, so reconcile is finished before them.
+     */
+
+    if (isFastBootReconcilePending() && (op == "notify" || op == "bulkset"))
+    {
+        SWSS_LOG_NOTICE("finishing fast boot reconcile before processing %s %s", op.c_str(), key.c_str());
+
+        fastBootReconcile(SIZE_MAX);
+    }
+
     sai_common_api_t api = SAI_COMMON_API_MAX;
 
     if (op == "create")
@@ -1440,6 +1475,21 @@ sai_status_t processEvent(swss::ConsumerTable &consumer)
     sai_attribute_t *attr_list = list.get_attr_list();
     uint32_t attr_count = list.get_attr_count();
 
+    /*
+     * Objects not yet reconciled after fast boot still have old RIDs in
+     * redis, so reconcile is finished before operation which touches them.
+     * Operations in init view mode only modify temporary view.
+     */
+
+    if (isFastBootReconcilePending() &&
+            !(isInitViewMode() && api != SAI_COMMON_API_GET) &&
+            isFastBootDeferredObjectUsed(object_type, str_object_id, api, attr_count, attr_list))
+    {
+        SWSS_LOG_NOTICE("finishing fast boot reconcile before processing %s %s", op.c_str(), key.c_str());
+
+        fastBootReconcile(SIZE_MAX);
+    }
+
     if (isInitViewMode())
     {
         return processEventInInitViewMode(object_type, str_object_id, api, attr_count, attr_list);
@@ -1782,6 +1832,73 @@ bool handleRestartQuery(swss::NotificationConsumer &restartQuery)
     return false;
 }
 
+std::shared_ptr<WarmBootSnapshot> g_warmBootSnapshot;
+
+void loadWarmBootSnapshot(
+        _In_ const std::string &warmBootReadFile)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER("load warm boot snapshot");
+
+    std::string path = getWarmBootSnapshotPath(warmBootReadFile);
+
+    auto snapshot = std::make_shared<WarmBootSnapshot>();
+
+    bool loaded = snapshot->load(path);
+
+    /*
+     * Snapshot and it's token are used only once, if syncd will be started
+     * again without warm shutdown, state must be read from redis.
+     */
+
+    unlink(path.c_str());
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    RedisPipeline pipeline(&db);
+
+    std::string token;
+
+    pipeline.push({ "GET", WARM_BOOT_SNAPSHOT_TOKEN },
+            [&token](const redisReply *reply)
+            {
+                if (reply->type == REDIS_REPLY_STRING)
+                {
+                    token = std::string(reply->str, reply->len);
+                }
+            });
+
+    pipeline.push({ "DEL", WARM_BOOT_SNAPSHOT_TOKEN });
+
+    pipeline.flush();
+
+    if (!loaded)
+    {
+        SWSS_LOG_WARN("warm boot snapshot not loaded, state will be read from redis");
+
+        return;
+    }
+
+    if (token != snapshot->getToken())
+    {
+        SWSS_LOG_WARN("warm boot snapshot token %s differs from redis token '%s', state will be read from redis",
+                snapshot->getToken().c_str(),
+                token.c_str());
+
+        return;
+    }
+
+    const warm_boot_snapshot_object_id_pair_t *pairs = snapshot->getVidToRidPairs();
+
+    for (size_t idx = 0; idx < snapshot->getObjectIdCount(); ++idx)
+    {
+        save_rid_and_vid_to_local(pairs[idx].value, pairs[idx].key);
+    }
+
+    g_warmBootSnapshot = snapshot;
+}
+
 bool isVeryFirstRun()
 {
     std::lock_guard<std::mutex> lock(g_mutex);
@@ -1879,9 +1996,11 @@ int main(int argc, char **argv)
 
     g_veryFirstRun = isVeryFirstRun();
 
+    const char *warmBootReadFile = NULL;
+
     if (options.startType == SAI_WARM_BOOT)
     {
-        const char *warmBootReadFile = profile_get_value(0, SAI_KEY_WARM_BOOT_READ_FILE);
+        warmBootReadFile = profile_get_value(0, SAI_KEY_WARM_BOOT_READ_FILE);
 
         SWSS_LOG_NOTICE("using warmBootReadFile: '%s'", warmBootReadFile);
 
@@ -1903,6 +2022,22 @@ int main(int argc, char **argv)
         options.startType = SAI_COLD_BOOT;
     }
 
+    if (options.startType == SAI_WARM_BOOT)
+    {
+        // warm start is forced to cold above when read file is not specified
+
+        loadWarmBootSnapshot(warmBootReadFile);
+    }
+    else
+    {
+        /*
+         * State in redis will change in this run, so snapshot written by
+         * previous warm shutdown must not be used on next warm start.
+         */
+
+        g_redisClient->del(WARM_BOOT_SNAPSHOT_TOKEN);
+    }
+
     gProfileMap[SAI_KEY_BOOT_TYPE] = std::to_string(options.startType);
 
     sai_status_t status = sai_api_initialize(0, (service_method_table_t*)&test_services);
@@ -1952,9 +2087,18 @@ int main(int argc, char **argv)
     try
     {
         SWSS_LOG_NOTICE("before onSyncdStart");
-        onSyncdStart(options.startType == SAI_WARM_BOOT);
+        onSyncdStart(options.startType);
         SWSS_LOG_NOTICE("after onSyncdStart");
 
+        startFastBootReconcileThread();
+
+        /*
+         * Translation maps from snapshot are already in local db, and redis
+         * will be modified from now on, so snapshot can't be used anymore.
+         */
+
+        g_warmBootSnapshot = nullptr;
+
         if (options.disableCountersThread == false)
         {
             SWSS_LOG_NOTICE("starting counters thread");
@@ -1998,6 +2142,8 @@ int main(int argc, char **argv)
         exit_and_notify(EXIT_FAILURE);
     }
 
+    endFastBootReconcileThread();
+
     endCountersThread();
 
     if (warmRestartHint)
@@ -2012,6 +2158,17 @@ int main(int argc, char **argv)
 
             warmRestartHint = false;
         }
+        else
+        {
+            std::string snapshotPath = getWarmBootSnapshotPath(warmBootWriteFile);
+
+            if (!WarmBootSnapshot::write(snapshotPath))
+            {
+                SWSS_LOG_WARN("failed to write warm boot snapshot, state will be read from redis on warm start");
+
+                unlink(snapshotPath.c_str());
+            }
+        }
     }
 
     sai_switch_api->shutdown_switch(warmRestartHint);
@@ -8,6 +8,9 @@
 #include <mutex>
 #include <thread>
 #include <set>
+#include <map>
+#include <memory>
+#include <functional>
 
 #include <unistd.h>
 #include <execinfo.h>
@@ -51,6 +54,8 @@ extern "C" {
 #define DEFAULT_TRAP_GROUP_ID       "DEFAULT_TRAP_GROUP_ID"
 #define DEFAULT_STP_INSTANCE_ID     "DEFAULT_STP_INSTANCE_ID"
 #define CPU_PORT_ID                 "CPU_PORT_ID"
+#define DISCOVERY_SNAPSHOT          "DISCOVERY_SNAPSHOT"
+#define WARM_BOOT_SNAPSHOT_TOKEN    "WARM_BOOT_SNAPSHOT_TOKEN"
 
 #define SAI_COLD_BOOT               0
 #define SAI_WARM_BOOT               1
@@ -67,14 +72,40 @@ extern std::set<sai_object_id_t> g_defaultPriorityGroupsRids;
 extern std::set<sai_object_id_t> g_defaultSchedulerGroupsRids;
 extern std::set<sai_object_id_t> g_defaultQueuesRids;
 extern std::set<sai_object_id_t> g_defaultPortsRids;
-
-void onSyncdStart(bool warmStart);
-void hardReinit();
+extern std::map<std::string, std::string> gProfileMap;
+
+class WarmBootSnapshot;
+
+/*
+ * Snapshot loaded on warm start, it's released after syncd start is
+ * processed, if null, state is read from redis.
+ */
+extern std::shared_ptr<WarmBootSnapshot> g_warmBootSnapshot;
+
+/*
+ * On fast boot, deferred objects are created in batches of this size, with
+ * interval between batches, to bound load put on SDK by reconcile.
+ */
+#define FAST_BOOT_RECONCILE_BATCH_SIZE          256
+#define FAST_BOOT_RECONCILE_BATCH_INTERVAL_MS   10
+
+void onSyncdStart(int startType);
+void hardReinit(bool fastBoot);
+
+bool isFastBootReconcilePending();
+bool isFastBootDeferredObjectUsed(
+        _In_ sai_object_type_t objectType,
+        _In_ const std::string &strObjectId,
+        _In_ sai_common_api_t api,
+        _In_ uint32_t attrCount,
+        _In_ sai_attribute_t *attrList);
+void fastBootReconcile(size_t maxTasks);
+void startFastBootReconcileThread();
+void endFastBootReconcileThread();
 
 sai_object_id_t replaceVidToRid(const sai_object_id_t &virtual_object_id);
 std::unordered_map<sai_object_id_t, sai_object_id_t> redisGetVidToRidMap();
 std::unordered_map<sai_object_id_t, sai_object_id_t> redisGetRidToVidMap();
-std::vector<std::string> redisGetAsicStateKeys();
 sai_object_id_t redisGetDefaultVirtualRouterId();
 sai_object_id_t redisGetDefaultTrapGroupId();
 sai_object_id_t redisGetDefaultStpInstanceId();
@@ -90,6 +121,10 @@ extern swss::RedisClient   *g_redisClient;
 sai_object_id_t redis_create_virtual_object_id(
         _In_ sai_object_type_t object_type);
 
+void save_rid_and_vid_to_local(
+        _In_ sai_object_id_t rid,
+        _In_ sai_object_id_t vid);
+
 sai_object_id_t translate_rid_to_vid(
         _In_ sai_object_id_t rid);
 
@@ -164,7 +199,40 @@ sai_object_type_t getObjectTypeFromVid(sai_object_id_t sai_object_id);
 void start_cli();
 void stop_cli();
 
+void parallelFor(
+        _In_ size_t count,
+        _In_ const std::function<void(size_t)> &fn);
+
+/**
+ * @brief Check if both lists contain the same object ids regardless of
+ * order.
+ *
+ * Lists are compared as multisets, so NULL and duplicated object ids must
+ * appear the same number of times on both lists.
+ */
+bool isEqualObjectIdMultiset(
+        _In_ std::vector<sai_object_id_t> first,
+        _In_ std::vector<sai_object_id_t> second);
+
+/**
+ * @brief Select previous RIDs which can be removed from RIDTOVID.
+ *
+ * Previous RID can be reused by SDK for other object created in this boot,
+ * so RID is selected only when it's current RIDTOVID value is still VID
+ * which had this RID in previous boot.
+ *
+ * @param vidAndPreviousRid Pairs of VID and it's RID from previous boot.
+ * @param currentVids Current RIDTOVID value of each previous RID, empty when
+ * entry does not exist.
+ */
+std::vector<sai_object_id_t> selectStaleRids(
+        _In_ const std::vector<std::pair<sai_object_id_t, sai_object_id_t>> &vidAndPreviousRid,
+        _In_ const std::vector<std::string> &currentVids);
+
 sai_status_t applyViewTransition();
-sai_status_t syncdApplyView();
+sai_status_t syncdApplyView(
+        _Out_ std::vector<swss::FieldValueTuple> &report);
+sai_status_t syncdApplyViewDryRun(
+        _Out_ std::vector<swss::FieldValueTuple> &report);
 
 #endif // __SYNCD_H__
@@ -3,8 +3,17 @@
 #include "swss/table.h"
 #include "swss/logger.h"
 #include "swss/dbconnector.h"
+#include "syncd_redis_pipeline.h"
 
 #include <algorithm>
+#include <functional>
+#include <exception>
+#include <iterator>
+#include <unordered_set>
+#include <chrono>
+#include <atomic>
+
+#include <sys/resource.h>
 
 /*
  * NOTE: all methods taking current and temporary view could be moved to
@@ -63,23 +72,31 @@ class SaiAttr
         SaiAttr(/*{{{*/
                 _In_ const std::string &str_attr_id,
                 _In_ const std::string &str_attr_value):
-            m_str_attr_id(str_attr_id),
+            m_str_attr_id(NULL),
             m_str_attr_value(str_attr_value),
-            m_meta(NULL)
+            m_meta(NULL),
+            m_attr(NULL)
         {
             SWSS_LOG_ENTER();
 
             /*
-             * We perform deserialize here to have attribute value when we need
-             * it, this can include allocated lists, so on destructor we ned to
-             * free this memory.
+             * Attribute id string is not copied, we point to the key of
+             * metadata attribute id map, which lives as long as metadata, so
+             * there is only one copy of each attribute id string no matter
+             * how many objects are in the views.
              */
 
-            sai_deserialize_attr_id(str_attr_id, &m_meta);
+            auto it = AttributesIdMetadata.find(str_attr_id);
+
+            if (it == AttributesIdMetadata.end())
+            {
+                SWSS_LOG_ERROR("invalid attr id: %s", str_attr_id.c_str());
 
-            m_attr.id = m_meta->attrid;
+                throw std::runtime_error("invalid attr id");
+            }
 
-            sai_deserialize_attr_value(str_attr_value, *m_meta, m_attr, false);
+            m_str_attr_id = &it->first;
+            m_meta = it->second;
 
             m_is_object_id_attr = m_meta->allowedobjecttypes.size() > 0;
         }/*}}}*/
@@ -88,17 +105,76 @@ class SaiAttr
         {
             SWSS_LOG_ENTER();
 
-            sai_deserialize_free_attribute_value(m_meta->serializationtype, m_attr);
+            sai_attribute_t *attr = m_attr.load();
+
+            if (attr != NULL)
+            {
+                sai_deserialize_free_attribute_value(m_meta->serializationtype, *attr);
+
+                delete attr;
+            }
         }/*}}}*/
 
         sai_attribute_t* getRWSaiAttr()/*{{{*/
         {
-            return &m_attr;
+            return materialize();
         }/*}}}*/
 
         const sai_attribute_t* getSaiAttr() const/*{{{*/
         {
-            return &m_attr;
+            return materialize();
+        }/*}}}*/
+
+        bool isMaterialized() const/*{{{*/
+        {
+            return m_attr.load(std::memory_order_acquire) != NULL;
+        }/*}}}*/
+
+        /**
+         * @brief Create copy of this attribute.
+         *
+         * If value is already deserialized, it's deep copied directly
+         * instead of deserializing it again from string. Value pointer is
+         * loaded once, so it's either fully deserialized or not set, even
+         * when other thread is materializing this attribute.
+         */
+        std::shared_ptr<SaiAttr> clone() const/*{{{*/
+        {
+            SWSS_LOG_ENTER();
+
+            auto attr = std::make_shared<SaiAttr>(*m_str_attr_id, m_str_attr_value);
+
+            const sai_attribute_t *value = m_attr.load(std::memory_order_acquire);
+
+            if (value != NULL)
+            {
+                sai_attribute_t *copy = new sai_attribute_t();
+
+                copy->id = value->id;
+
+                sai_copy_attr_value(*m_meta, *value, *copy);
+
+                attr->m_attr.store(copy, std::memory_order_release);
+            }
+
+            return attr;
+        }/*}}}*/
+
+        /**
+         * @brief Get estimated memory used by this attribute in bytes.
+         *
+         * Allocated lists of materialized value are not taken into account.
+         */
+        size_t getEstimatedMemoryUsage() const/*{{{*/
+        {
+            size_t bytes = sizeof(SaiAttr) + m_str_attr_value.capacity();
+
+            if (isMaterialized())
+            {
+                bytes += sizeof(sai_attribute_t);
+            }
+
+            return bytes;
         }/*}}}*/
 
         bool isObjectIdAttr() const/*{{{*/
@@ -108,7 +184,7 @@ class SaiAttr
 
         const std::string& getStrAttrId() const/*{{{*/
         {
-            return m_str_attr_id;
+            return *m_str_attr_id;
         }/*}}}*/
 
         const std::string& getStrAttrValue() const/*{{{*/
@@ -123,7 +199,7 @@ class SaiAttr
 
         void UpdateValue()/*{{{*/
         {
-            m_str_attr_value = sai_serialize_attr_value(*m_meta, m_attr);
+            m_str_attr_value = sai_serialize_attr_value(*m_meta, *materialize());
         }/*}}}*/
 
         /**
@@ -138,7 +214,17 @@ class SaiAttr
         {
             SWSS_LOG_ENTER();
 
-            const sai_attribute_t &attr = m_attr;
+            if (!m_is_object_id_attr)
+            {
+                /*
+                 * No need to deserialize value when attribute can't contain
+                 * any object id.
+                 */
+
+                return std::vector<sai_object_id_t>();
+            }
+
+            const sai_attribute_t &attr = *getSaiAttr();
 
             uint32_t count = 0;
 
@@ -220,14 +306,88 @@ class SaiAttr
         SaiAttr(const SaiAttr&);
         SaiAttr& operator=(const SaiAttr&);
 
-        const std::string m_str_attr_id;
+        /**
+         * @brief Deserialize attribute value on first use.
+         *
+         * Most of the attributes in the views are only compared by their
+         * serialized value, so we deserialize value (which can include
+         * allocated lists) only when it's actually needed. Candidates can be
+         * compared from multiple threads, so value is allocated and published
+         * with compare exchange, thread which loses the race frees it's copy.
+         */
+        sai_attribute_t* materialize() const/*{{{*/
+        {
+            sai_attribute_t *attr = m_attr.load(std::memory_order_acquire);
+
+            if (attr != NULL)
+            {
+                return attr;
+            }
+
+            attr = new sai_attribute_t();
+
+            attr->id = m_meta->attrid;
+
+            sai_deserialize_attr_value(m_str_attr_value, *m_meta, *attr, false);
+
+            sai_attribute_t *expected = NULL;
+
+            if (m_attr.compare_exchange_strong(expected, attr, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return attr;
+            }
+
+            sai_deserialize_free_attribute_value(m_meta->serializationtype, *attr);
+
+            delete attr;
+
+            return expected;
+        }/*}}}*/
+
+        const std::string* m_str_attr_id;
         std::string m_str_attr_value;
 
         const sai_attr_metadata_t* m_meta;
-        sai_attribute_t m_attr;
         bool m_is_object_id_attr;
+
+        /*
+         * Deserialized value, allocated on first use, most of attributes
+         * are never deserialized, so they only pay for this pointer.
+         */
+        mutable std::atomic<sai_attribute_t*> m_attr;
 };
 
+/**
+ * @brief Get serialized object type from table built on first use.
+ *
+ * Table is initialized in thread safe way, since views are loaded by
+ * multiple threads.
+ */
+const std::string& getInternedStrObjectType(/*{{{*/
+        _In_ sai_object_type_t object_type)
+{
+    static const std::vector<std::string> names = []()
+    {
+        std::vector<std::string> v;
+
+        for (int ot = SAI_OBJECT_TYPE_NULL; ot < SAI_OBJECT_TYPE_MAX; ++ot)
+        {
+            v.push_back(sai_serialize_object_type((sai_object_type_t)ot));
+        }
+
+        return v;
+    }();
+
+    if (object_type < SAI_OBJECT_TYPE_NULL || (size_t)object_type >= names.size())
+    {
+        SWSS_LOG_ERROR("invalid object type %d", object_type);
+
+        throw std::runtime_error("invalid object type");
+    }
+
+    return names[object_type];
+}/*}}}*/
+
 class SaiObj
 {
     public:
@@ -236,14 +396,25 @@ class SaiObj
             oidObject(false),
             createdObject(false),
             defaultObject(false),
-            m_object_status(SAI_OBJECT_STATUS_NOT_PROCESSED)
+            m_object_status(SAI_OBJECT_STATUS_NOT_PROCESSED),
+            m_contentHash(0),
+            m_hasContentHash(false)
         {
         }/*}}}*/
 
         // TODO move to methods
-        std::string str_object_type;
         std::string str_object_id;
 
+        /**
+         * @brief Get serialized object type.
+         *
+         * String is interned, all objects of the same type share single copy.
+         */
+        const std::string& getStrObjectType() const/*{{{*/
+        {
+            return getInternedStrObjectType(meta_key.object_type);
+        }/*}}}*/
+
         sai_object_meta_key_t meta_key;
 
         bool oidObject;
@@ -311,7 +482,30 @@ class SaiObj
         void setAttr(/*{{{*/
                 _In_ std::shared_ptr<SaiAttr> a)
         {
-            m_attrs[a->getSaiAttr()->id] = a;
+            m_attrs[a->getAttrMetadata()->attrid] = a;
+
+            m_hasContentHash = false;
+        }/*}}}*/
+
+        void setContentHash(/*{{{*/
+                _In_ size_t hash)
+        {
+            m_contentHash = hash;
+            m_hasContentHash = true;
+        }/*}}}*/
+
+        /**
+         * @brief Get cached content hash.
+         *
+         * Returns false if hash was not computed or object attributes were
+         * modified since then.
+         */
+        bool getContentHash(/*{{{*/
+                _Out_ size_t &hash) const
+        {
+            hash = m_contentHash;
+
+            return m_hasContentHash;
         }/*}}}*/
 
         bool hasAttr(/*{{{*/
@@ -341,6 +535,10 @@ class SaiObj
 
         sai_object_status_t m_object_status;
 
+        size_t m_contentHash;
+
+        bool m_hasContentHash;
+
         std::unordered_map<sai_attr_id_t, std::shared_ptr<SaiAttr>> m_attrs;
 
         SaiObj(const SaiObj&);
@@ -351,171 +549,451 @@ typedef std::unordered_map<sai_object_id_t, sai_object_id_t> ObjectIdMap;
 typedef std::unordered_map<std::string, std::shared_ptr<SaiObj>> StrObjectIdToSaiObjectHash;
 typedef std::unordered_map<sai_object_id_t, std::shared_ptr<SaiObj>> ObjectIdToSaiObjectHash;
 
-class AsicView
+/*
+ * Non object id entries are indexed by their struct instead of serialized
+ * string, so lookup don't require serialization and index don't keep another
+ * copy of key string. Only bytes relevant for given address family are taken
+ * into account, since rest of ip address union may not be initialized.
+ */
+
+inline size_t hashCombine(/*{{{*/
+        _In_ size_t seed,
+        _In_ size_t value)
 {
-    public:
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}/*}}}*/
 
-        AsicView()/*{{{*/
-        {
-            // empty intentionally
-        }/*}}}*/
+inline size_t hashBytes(/*{{{*/
+        _In_ size_t seed,
+        _In_ const uint8_t *bytes,
+        _In_ size_t length)
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        seed = hashCombine(seed, bytes[idx]);
+    }
 
-        // TODO should this be static method that returns AsicViewObject?
-        void fromDump(/*{{{*/
-                _In_ const swss::TableDump &dump)
-        {
-            SWSS_LOG_ENTER();
+    return seed;
+}/*}}}*/
 
-            /*
-             * Input should be also existing obejcts, so they could be created
-             * here right away but we would need VIDs as well.
-             */
+inline size_t hashIpAddress(/*{{{*/
+        _In_ size_t seed,
+        _In_ sai_ip_addr_family_t family,
+        _In_ const sai_ip_addr_t &addr)
+{
+    seed = hashCombine(seed, family);
 
-            for (const auto &key: dump)
-            {
-                auto start = key.first.find_first_of(":");
+    if (family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return hashCombine(seed, addr.ip4);
+    }
 
-                if (start == std::string::npos)
-                {
-                    SWSS_LOG_ERROR("failed to find colon in %s", key.first.c_str());
+    return hashBytes(seed, addr.ip6, sizeof(addr.ip6));
+}/*}}}*/
 
-                    throw std::runtime_error("failed to find colon inside key");
-                }
+inline bool equalIpAddress(/*{{{*/
+        _In_ sai_ip_addr_family_t family,
+        _In_ const sai_ip_addr_t &a,
+        _In_ const sai_ip_addr_t &b)
+{
+    if (family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.ip4 == b.ip4;
+    }
 
-                std::shared_ptr<SaiObj> o = std::make_shared<SaiObj>();
+    return memcmp(a.ip6, b.ip6, sizeof(a.ip6)) == 0;
+}/*}}}*/
 
-                o->str_object_type  = key.first.substr(0, start);
-                o->str_object_id    = key.first.substr(start + 1);
+struct RouteEntryHash/*{{{*/
+{
+    size_t operator()(const sai_unicast_route_entry_t &re) const
+    {
+        size_t seed = std::hash<sai_object_id_t>()(re.vr_id);
 
-                sai_deserialize_object_type(o->str_object_type, o->meta_key.object_type);
+        seed = hashIpAddress(seed, re.destination.addr_family, re.destination.addr);
 
-                switch (o->meta_key.object_type)
-                {
-                    case SAI_OBJECT_TYPE_SWITCH:
-                        soSwitches[o->str_object_id] = o;
-                        break;
+        return hashIpAddress(seed, re.destination.addr_family, re.destination.mask);
+    }
 
-                    case SAI_OBJECT_TYPE_FDB:
-                        sai_deserialize_fdb_entry(o->str_object_id, o->meta_key.key.fdb_entry);
-                        soFdbs[o->str_object_id] = o;
-                        break;
+    bool operator()(const sai_unicast_route_entry_t &a, const sai_unicast_route_entry_t &b) const
+    {
+        return a.vr_id == b.vr_id &&
+            a.destination.addr_family == b.destination.addr_family &&
+            equalIpAddress(a.destination.addr_family, a.destination.addr, b.destination.addr) &&
+            equalIpAddress(a.destination.addr_family, a.destination.mask, b.destination.mask);
+    }
+};/*}}}*/
 
-                    case SAI_OBJECT_TYPE_NEIGHBOR:
-                        sai_deserialize_neighbor_entry(o->str_object_id, o->meta_key.key.neighbor_entry);
-                        soNeighbors[o->str_object_id] = o;
+struct NeighborEntryHash/*{{{*/
+{
+    size_t operator()(const sai_neighbor_entry_t &ne) const
+    {
+        size_t seed = std::hash<sai_object_id_t>()(ne.rif_id);
 
-                        /*
-                         * Since neighbor struct object contains RIF ID, we
-                         * need to increase vid reference With new metadata for
-                         * SAI 1.0 this can be done in generic way for all non
-                         * object ids.
-                         */
+        return hashIpAddress(seed, ne.ip_address.addr_family, ne.ip_address.addr);
+    }
 
-                        m_vidReference[o->meta_key.key.neighbor_entry.rif_id] += 1;
+    bool operator()(const sai_neighbor_entry_t &a, const sai_neighbor_entry_t &b) const
+    {
+        return a.rif_id == b.rif_id &&
+            a.ip_address.addr_family == b.ip_address.addr_family &&
+            equalIpAddress(a.ip_address.addr_family, a.ip_address.addr, b.ip_address.addr);
+    }
+};/*}}}*/
 
-                        break;
+struct FdbEntryHash/*{{{*/
+{
+    size_t operator()(const sai_fdb_entry_t &fe) const
+    {
+        size_t seed = std::hash<uint32_t>()(fe.vlan_id);
 
-                    case SAI_OBJECT_TYPE_ROUTE:
-                        sai_deserialize_route_entry(o->str_object_id, o->meta_key.key.route_entry);
-                        soRoutes[o->str_object_id] = o;
+        return hashBytes(seed, fe.mac_address, sizeof(fe.mac_address));
+    }
 
-                        /*
-                         * Since route struct object contains VR ID, we need to
-                         * increase vid reference.
-                         */
+    bool operator()(const sai_fdb_entry_t &a, const sai_fdb_entry_t &b) const
+    {
+        return a.vlan_id == b.vlan_id &&
+            memcmp(a.mac_address, b.mac_address, sizeof(a.mac_address)) == 0;
+    }
+};/*}}}*/
 
-                        m_vidReference[o->meta_key.key.route_entry.vr_id] += 1;
+typedef std::unordered_map<sai_unicast_route_entry_t, std::shared_ptr<SaiObj>, RouteEntryHash, RouteEntryHash> RouteEntryToSaiObjectHash;
+typedef std::unordered_map<sai_neighbor_entry_t, std::shared_ptr<SaiObj>, NeighborEntryHash, NeighborEntryHash> NeighborEntryToSaiObjectHash;
+typedef std::unordered_map<sai_fdb_entry_t, std::shared_ptr<SaiObj>, FdbEntryHash, FdbEntryHash> FdbEntryToSaiObjectHash;
 
-                        break;
+/**
+ * @brief ASIC operation generated during view transition.
+ *
+ * Operation holds in-memory object and attributes, so when operations are
+ * executed on ASIC there is no need to serialize and then deserialize them
+ * again. Attributes are captured when operation is generated, since object
+ * attributes can be replaced by later operations on the same object (each
+ * set replaces SaiAttr instance on the object, it's not modified in place).
+ */
+class AsicOperation
+{
+    public:
 
-                    case SAI_OBJECT_TYPE_VLAN:
-                        sai_deserialize_vlan_id(o->str_object_id, o->meta_key.key.vlan_id);
-                        soVlans[o->str_object_id] = o;
-                        break;
+        AsicOperation(/*{{{*/
+                _In_ sai_common_api_t api,
+                _In_ const std::shared_ptr<SaiObj> &obj,
+                _In_ const std::vector<std::shared_ptr<SaiAttr>> &attrs):
+            m_api(api),
+            m_obj(obj),
+            m_attrs(attrs)
+        {
+        }/*}}}*/
 
-                    case SAI_OBJECT_TYPE_TRAP:
-                        sai_deserialize_hostif_trap_id(o->str_object_id, o->meta_key.key.trap_id);
-                        soTraps[o->str_object_id] = o;
-                        break;
+        sai_common_api_t getApi() const/*{{{*/
+        {
+            return m_api;
+        }/*}}}*/
 
-                    default:
-                        sai_deserialize_object_id(o->str_object_id, o->meta_key.key.object_id);
-                        soOids[o->str_object_id] = o;
-                        oOids[o->meta_key.key.object_id] = o;
+        const std::shared_ptr<SaiObj>& getObj() const/*{{{*/
+        {
+            return m_obj;
+        }/*}}}*/
+
+        const std::vector<std::shared_ptr<SaiAttr>>& getAttrs() const/*{{{*/
+        {
+            return m_attrs;
+        }/*}}}*/
 
-                        /*
-                         * From SAI 1.0 this will be in metadata.
-                         */
+        std::string getStrOp() const/*{{{*/
+        {
+            switch (m_api)
+            {
+                case SAI_COMMON_API_CREATE:
+                    return "create";
 
-                        o->oidObject = true;
+                case SAI_COMMON_API_REMOVE:
+                    return "remove";
 
-                        /*
-                         * Here is only object VID declaration, since we don't
-                         * know what objects were processed previously but on
-                         * some of previous object attributes this VID could be
-                         * used, so value can be already greater than zero, but
-                         * here we need to just mark that vid exists in
-                         * vidReference is it has not been set yet at all.
-                         */
+                case SAI_COMMON_API_SET:
+                    return "set";
 
-                        m_vidReference[o->meta_key.key.object_id] += 0;
+                default:
+                    return "unknown";
+            }
+        }/*}}}*/
 
-                        break;
-                }
+        std::string getStrKey() const/*{{{*/
+        {
+            return m_obj->getStrObjectType() + ":" + m_obj->str_object_id;
+        }/*}}}*/
 
-                soAll[o->str_object_id] = o;
-                sotAll[o->meta_key.object_type][o->str_object_id] = o;
+    private:
 
-                populateAttributes(o, key.second);
-            }
+        AsicOperation(const AsicOperation&);
+        AsicOperation& operator=(const AsicOperation&);
 
-            /*
-             * If tere is no switch, then create one by default with all empty
-             * values.
-             */
+        sai_common_api_t m_api;
 
-            if (soSwitches.size() == 0)
+        std::shared_ptr<SaiObj> m_obj;
+
+        std::vector<std::shared_ptr<SaiAttr>> m_attrs;
+};
+
+/*
+ * Attribute id used in reverse references when object id is referenced from
+ * non object id struct key instead of attribute.
+ */
+
+#define KEY_REFERENCE_ATTR_ID ((sai_attr_id_t)-1)
+
+class AsicView
+{
+    public:
+
+        AsicView()/*{{{*/
+        {
+            // empty intentionally
+        }/*}}}*/
+
+        // TODO should this be static method that returns AsicViewObject?
+        /**
+         * @brief Create object from redis key and attribute fields.
+         *
+         * This method don't modify view, so it can be called from multiple
+         * threads to parse objects in parallel, object then needs to be
+         * added to view by addObject.
+         */
+        static std::shared_ptr<SaiObj> parseObject(/*{{{*/
+                _In_ const std::string &key,
+                _In_ const std::vector<std::pair<std::string, std::string>> &fields)
+        {
+            SWSS_LOG_ENTER();
+
+            auto start = key.find_first_of(":");
+
+            if (start == std::string::npos)
             {
-                const auto &o = createSwitchObject();
+                SWSS_LOG_ERROR("failed to find colon in %s", key.c_str());
 
-                soAll[o->str_object_id] = o;
-                soSwitches[o->str_object_id] = o;
-                sotAll[o->meta_key.object_type][o->str_object_id] = o;
+                throw std::runtime_error("failed to find colon inside key");
             }
 
+            std::shared_ptr<SaiObj> o = std::make_shared<SaiObj>();
+
+            o->str_object_id    = key.substr(start + 1);
+
+            sai_deserialize_object_type(key.substr(0, start), o->meta_key.object_type);
+
+            switch (o->meta_key.object_type)
             {
-                // VLAN 1 also needs to be present
+                case SAI_OBJECT_TYPE_SWITCH:
+                    break;
 
-                std::shared_ptr<SaiObj> o = std::make_shared<SaiObj>();
+                case SAI_OBJECT_TYPE_FDB:
+                    sai_deserialize_fdb_entry(o->str_object_id, o->meta_key.key.fdb_entry);
+                    break;
 
-                o->str_object_type  = sai_serialize_object_type(SAI_OBJECT_TYPE_VLAN);
-                o->str_object_id    = sai_serialize_vlan_id(1);
+                case SAI_OBJECT_TYPE_NEIGHBOR:
+                    sai_deserialize_neighbor_entry(o->str_object_id, o->meta_key.key.neighbor_entry);
+                    break;
 
-                o->meta_key.object_type = SAI_OBJECT_TYPE_VLAN;
-                o->meta_key.key.vlan_id = 1;
+                case SAI_OBJECT_TYPE_ROUTE:
+                    sai_deserialize_route_entry(o->str_object_id, o->meta_key.key.route_entry);
+                    break;
+
+                case SAI_OBJECT_TYPE_VLAN:
+                    sai_deserialize_vlan_id(o->str_object_id, o->meta_key.key.vlan_id);
+                    break;
+
+                case SAI_OBJECT_TYPE_TRAP:
+                    sai_deserialize_hostif_trap_id(o->str_object_id, o->meta_key.key.trap_id);
+                    break;
+
+                default:
+                    sai_deserialize_object_id(o->str_object_id, o->meta_key.key.object_id);
 
-                if (soVlans.find(o->str_object_id) == soVlans.end())
-                {
                     /*
-                     * Vlan 1 don't exist in current view, save it as default
+                     * From SAI 1.0 this will be in metadata.
                      */
 
-                    soVlans[o->str_object_id] = o;
-                    soAll[o->str_object_id] = o;
-                    sotAll[o->meta_key.object_type][o->str_object_id] = o;
-                }
+                    o->oidObject = true;
+
+                    break;
             }
 
+            for (const auto &field: fields)
             {
-                // create all default traps in both views
+                std::shared_ptr<SaiAttr> a = std::make_shared<SaiAttr>(field.first, field.second);
 
-                for (int index = 0; metadata_enum_sai_hostif_trap_type_t.valuesnames[index] != NULL; ++index)
+                if (a->isObjectIdAttr())
                 {
-                    sai_hostif_trap_id_t trap_id = (sai_hostif_trap_id_t)metadata_enum_sai_hostif_trap_type_t.values[index];
+                    /*
+                     * Deserialize object id attributes right away, since
+                     * they will be needed for reference count anyway, and
+                     * here we can do that on worker thread.
+                     */
+
+                    a->getSaiAttr();
+                }
+
+                o->setAttr(a);
+            }
+
+            return o;
+        }/*}}}*/
+
+        /**
+         * @brief Add object parsed by parseObject to view.
+         */
+        void addObject(/*{{{*/
+                _In_ const std::shared_ptr<SaiObj> &o)
+        {
+            SWSS_LOG_ENTER();
+
+            /*
+             * Input should be also existing obejcts, so they could be created
+             * here right away but we would need VIDs as well.
+             */
+
+            if (soAll.find(o->str_object_id) != soAll.end())
+            {
+                /*
+                 * Adding object again would bind VID references of it's
+                 * attributes second time.
+                 */
+
+                SWSS_LOG_ERROR("object %s:%s already exists in view",
+                        o->getStrObjectType().c_str(),
+                        o->str_object_id.c_str());
+
+                throw std::runtime_error("object already exists in view");
+            }
+
+            switch (o->meta_key.object_type)
+            {
+                case SAI_OBJECT_TYPE_SWITCH:
+                    soSwitches[o->str_object_id] = o;
+                    break;
+
+                case SAI_OBJECT_TYPE_FDB:
+                    soFdbs[o->meta_key.key.fdb_entry] = o;
+                    break;
+
+                case SAI_OBJECT_TYPE_NEIGHBOR:
+                    soNeighbors[o->meta_key.key.neighbor_entry] = o;
+
+                    /*
+                     * Since neighbor struct object contains RIF ID, we
+                     * need to increase vid reference With new metadata for
+                     * SAI 1.0 this can be done in generic way for all non
+                     * object ids.
+                     */
+
+                    m_vidReference[o->meta_key.key.neighbor_entry.rif_id] += 1;
+
+                    break;
+
+                case SAI_OBJECT_TYPE_ROUTE:
+                    soRoutes[o->meta_key.key.route_entry] = o;
+
+                    /*
+                     * Since route struct object contains VR ID, we need to
+                     * increase vid reference.
+                     */
+
+                    m_vidReference[o->meta_key.key.route_entry.vr_id] += 1;
+
+                    break;
+
+                case SAI_OBJECT_TYPE_VLAN:
+                    soVlans[o->str_object_id] = o;
+                    break;
+
+                case SAI_OBJECT_TYPE_TRAP:
+                    soTraps[o->str_object_id] = o;
+                    break;
+
+                default:
+                    oOids[o->meta_key.key.object_id] = o;
+
+                    /*
+                     * Here is only object VID declaration, since we don't
+                     * know what objects were processed previously but on
+                     * some of previous object attributes this VID could be
+                     * used, so value can be already greater than zero, but
+                     * here we need to just mark that vid exists in
+                     * vidReference is it has not been set yet at all.
+                     */
+
+                    m_vidReference[o->meta_key.key.object_id] += 0;
+
+                    break;
+            }
+
+            soAll[o->str_object_id] = o;
+            m_objectTypeIndex[o->meta_key.object_type].insert(o);
+
+            for (const auto &ita: o->getAllAttributes())
+            {
+                for (auto const &vid: ita.second->getOidListFromAttribute())
+                {
+                    if (vid != SAI_NULL_OBJECT_ID)
+                    {
+                        m_vidReference[vid] += 1;
+                    }
+                }
+            }
+        }/*}}}*/
+
+        /**
+         * @brief Add default objects which may not be present in redis.
+         *
+         * Must be called after all objects from redis were added.
+         */
+        void addDefaultObjects()/*{{{*/
+        {
+            SWSS_LOG_ENTER();
+
+            /*
+             * If tere is no switch, then create one by default with all empty
+             * values.
+             */
+
+            if (soSwitches.size() == 0)
+            {
+                const auto &o = createSwitchObject();
+
+                soAll[o->str_object_id] = o;
+                soSwitches[o->str_object_id] = o;
+                m_objectTypeIndex[o->meta_key.object_type].insert(o);
+            }
+
+            {
+                // VLAN 1 also needs to be present
+
+                std::shared_ptr<SaiObj> o = std::make_shared<SaiObj>();
+
+                o->str_object_id    = sai_serialize_vlan_id(1);
+
+                o->meta_key.object_type = SAI_OBJECT_TYPE_VLAN;
+                o->meta_key.key.vlan_id = 1;
+
+                if (soVlans.find(o->str_object_id) == soVlans.end())
+                {
+                    /*
+                     * Vlan 1 don't exist in current view, save it as default
+                     */
+
+                    soVlans[o->str_object_id] = o;
+                    soAll[o->str_object_id] = o;
+                    m_objectTypeIndex[o->meta_key.object_type].insert(o);
+                }
+            }
+
+            {
+                // create all default traps in both views
+
+                for (int index = 0; metadata_enum_sai_hostif_trap_type_t.valuesnames[index] != NULL; ++index)
+                {
+                    sai_hostif_trap_id_t trap_id = (sai_hostif_trap_id_t)metadata_enum_sai_hostif_trap_type_t.values[index];
 
                     std::shared_ptr<SaiObj> o = std::make_shared<SaiObj>();
 
-                    o->str_object_type  = sai_serialize_object_type(SAI_OBJECT_TYPE_TRAP);
                     o->str_object_id    = sai_serialize_hostif_trap_id(trap_id);
 
                     o->meta_key.object_type = SAI_OBJECT_TYPE_TRAP;
@@ -525,7 +1003,7 @@ class AsicView
                     {
                         soTraps[o->str_object_id] = o;
                         soAll[o->str_object_id] = o;
-                        sotAll[o->meta_key.object_type][o->str_object_id] = o;
+                        m_objectTypeIndex[o->meta_key.object_type].insert(o);
                     }
                 }
             }
@@ -540,10 +1018,9 @@ class AsicView
 
             std::shared_ptr<SaiObj> o = std::make_shared<SaiObj>();
 
-            o->str_object_type  = str_object_type;
             o->str_object_id    = str_object_id;
 
-            sai_deserialize_object_type(o->str_object_type, o->meta_key.object_type);
+            sai_deserialize_object_type(str_object_type, o->meta_key.object_type);
 
             sai_deserialize_hostif_trap_id(o->str_object_id, o->meta_key.key.trap_id);
             soTraps[o->str_object_id] = o;
@@ -556,7 +1033,7 @@ class AsicView
             }
 
             soAll[o->str_object_id] = o;
-            sotAll[o->meta_key.object_type][o->str_object_id] = o;
+            m_objectTypeIndex[o->meta_key.object_type].insert(o);
 
             return o;
         }/*}}}*/
@@ -663,16 +1140,28 @@ class AsicView
 
         // TODO convert to something like nonObjectIdMap
         StrObjectIdToSaiObjectHash soSwitches;
-        StrObjectIdToSaiObjectHash soFdbs;
-        StrObjectIdToSaiObjectHash soNeighbors;
-        StrObjectIdToSaiObjectHash soRoutes;
+        FdbEntryToSaiObjectHash soFdbs;
+        NeighborEntryToSaiObjectHash soNeighbors;
+        RouteEntryToSaiObjectHash soRoutes;
         StrObjectIdToSaiObjectHash soVlans;
         StrObjectIdToSaiObjectHash soTraps;
-        StrObjectIdToSaiObjectHash soOids;
+
+        /*
+         * Primary index of all objects, object id objects are also indexed
+         * by VID in oOids.
+         */
+
         StrObjectIdToSaiObjectHash soAll;
 
     private:
-        std::map<sai_object_type_t, StrObjectIdToSaiObjectHash> sotAll;
+
+        /*
+         * Secondary index of objects by object type, it's not keeping
+         * another copy of object id strings.
+         */
+
+        std::map<sai_object_type_t, std::unordered_set<std::shared_ptr<SaiObj>>> m_objectTypeIndex;
+
     public:
 
         ObjectIdToSaiObjectHash oOids;
@@ -699,17 +1188,14 @@ class AsicView
             std::vector<std::shared_ptr<SaiObj>> list;
 
             // we need to use find, since object type may not exist
-            auto it = sotAll.find(object_type);
+            auto it = m_objectTypeIndex.find(object_type);
 
-            if (it == sotAll.end())
+            if (it == m_objectTypeIndex.end())
             {
                 return list;
             }
 
-            for (const auto &p: it->second)
-            {
-                list.push_back(p.second);
-            }
+            list.assign(it->second.begin(), it->second.end());
 
             return list;
         }/*}}}*/
@@ -729,18 +1215,18 @@ class AsicView
             std::vector<std::shared_ptr<SaiObj>> list;
 
             // we need to use find, since object type may not exist
-            auto it = sotAll.find(object_type);
+            auto it = m_objectTypeIndex.find(object_type);
 
-            if (it == sotAll.end())
+            if (it == m_objectTypeIndex.end())
             {
                 return list;
             }
 
-            for (const auto &p: it->second)
+            for (const auto &o: it->second)
             {
-                if (p.second->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+                if (o->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
                 {
-                    list.push_back(p.second);
+                    list.push_back(o);
                 }
             }
 
@@ -788,13 +1274,11 @@ class AsicView
 
             std::shared_ptr<SaiObj> o = std::make_shared<SaiObj>();
 
-            o->str_object_type  = sai_serialize_object_type(object_type);
             o->str_object_id    = sai_serialize_object_id(vid);
 
             o->meta_key.object_type = object_type;
             o->meta_key.key.object_id = vid;
 
-            soOids[o->str_object_id] = o;
             oOids[o->meta_key.key.object_id] = o;
 
             o->oidObject = true;
@@ -802,7 +1286,7 @@ class AsicView
             m_vidReference[o->meta_key.key.object_id] += 0;
 
             soAll[o->str_object_id] = o;
-            sotAll[o->meta_key.object_type][o->str_object_id] = o;
+            m_objectTypeIndex[o->meta_key.object_type].insert(o);
 
             ridToVid[rid] = vid;
             vidToRid[vid] = rid;
@@ -823,25 +1307,11 @@ class AsicView
              * This method will generate ASIC set operation on current existing
              * object similar like SAI REDIS is doing.
              *
-             * NOTE: in long run, this is serialize, and then we call deserialize
-             * to execute them on actual asic, maybe this is not necessary
-             * and could be optimized later.
-             *
              * TODO set on object id should do release of links (currently done
              * outside) and modify dependency tree.
              */
 
-            std::vector<swss::FieldValueTuple> entry = SaiAttributeList::serialize_attr_list(
-                    currentObj->getObjectType(),
-                    1,
-                    attr->getSaiAttr(),
-                    false);
-
-            std::string key = currentObj->str_object_type + ":" + currentObj->str_object_id;
-
-            std::shared_ptr<swss::KeyOpFieldsValuesTuple> kco = std::make_shared<swss::KeyOpFieldsValuesTuple>(key, "set", entry);
-
-            m_asicOperations.push_back(kco);
+            m_asicOperations.push_back(std::make_shared<AsicOperation>(SAI_COMMON_API_SET, currentObj, std::vector<std::shared_ptr<SaiAttr>>{ attr }));
         }/*}}}*/
 
         void asicCreateObject(/*{{{*/
@@ -852,58 +1322,29 @@ class AsicView
             if (!currentObj->oidObject)
             {
                 SWSS_LOG_ERROR("non object id not supported yet %s:%s FIXME",
-                        currentObj->str_object_type.c_str(),
+                        currentObj->getStrObjectType().c_str(),
                         currentObj->str_object_id.c_str());
 
                 throw std::runtime_error("non object id not supported yet");
             }
 
-            soOids[currentObj->str_object_id] = currentObj;
             oOids[currentObj->meta_key.key.object_id] = currentObj;
 
             m_vidReference[currentObj->meta_key.key.object_id] += 0;
 
             soAll[currentObj->str_object_id] = currentObj;
-            sotAll[currentObj->meta_key.object_type][currentObj->str_object_id] = currentObj;
+            m_objectTypeIndex[currentObj->meta_key.object_type].insert(currentObj);
 
             /*
              * This method will generate ASIC create operation on current
              * existing object similar like SAI REDIS is doing.
              *
-             * NOTE: in long run, this is serialize, and then we call
-             * deserialize to execute them on actual asic, maybe this is not
-             * necessary and could be optimized later.
-             *
              * TODO create on object id attributes should bind references to
              * used VIDs of of links (currently done outside) and modify
              * dependency tree.
              */
 
-            std::vector<swss::FieldValueTuple> entry;
-
-            for (auto const &pair: currentObj->getAllAttributes())
-            {
-                const auto &attr = pair.second;
-
-                swss::FieldValueTuple fvt(attr->getStrAttrId(), attr->getStrAttrValue());
-
-                entry.push_back(fvt);
-            }
-
-            if (entry.size() == 0)
-            {
-                // make sure that we put object into db
-                // even if there are no attributes set
-                swss::FieldValueTuple null("NULL", "NULL");
-
-                entry.push_back(null);
-            }
-
-            std::string key = currentObj->str_object_type + ":" + currentObj->str_object_id;
-
-            std::shared_ptr<swss::KeyOpFieldsValuesTuple> kco = std::make_shared<swss::KeyOpFieldsValuesTuple>(key, "create", entry);
-
-            m_asicOperations.push_back(kco);
+            m_asicOperations.push_back(std::make_shared<AsicOperation>(SAI_COMMON_API_CREATE, currentObj, getAttributesSnapshot(currentObj)));
         }/*}}}*/
 
         // TODO combine with creating object id
@@ -915,7 +1356,7 @@ class AsicView
             if (currentObj->oidObject)
             {
                 SWSS_LOG_ERROR("object id is not supported yet %s:%s FIXME",
-                        currentObj->str_object_type.c_str(),
+                        currentObj->getStrObjectType().c_str(),
                         currentObj->str_object_id.c_str());
 
                 throw std::runtime_error("object id is not supported yet");
@@ -925,12 +1366,12 @@ class AsicView
             {
                 case SAI_OBJECT_TYPE_FDB:
                     sai_deserialize_fdb_entry(currentObj->str_object_id, currentObj->meta_key.key.fdb_entry);
-                    soFdbs[currentObj->str_object_id] = currentObj;
+                    soFdbs[currentObj->meta_key.key.fdb_entry] = currentObj;
                     break;
 
                 case SAI_OBJECT_TYPE_NEIGHBOR:
                     sai_deserialize_neighbor_entry(currentObj->str_object_id, currentObj->meta_key.key.neighbor_entry);
-                    soNeighbors[currentObj->str_object_id] = currentObj;
+                    soNeighbors[currentObj->meta_key.key.neighbor_entry] = currentObj;
 
                     /*
                      * Since neighbor struct object contains RIF ID, we
@@ -945,7 +1386,7 @@ class AsicView
 
                 case SAI_OBJECT_TYPE_ROUTE:
                     sai_deserialize_route_entry(currentObj->str_object_id, currentObj->meta_key.key.route_entry);
-                    soRoutes[currentObj->str_object_id] = currentObj;
+                    soRoutes[currentObj->meta_key.key.route_entry] = currentObj;
 
                     /*
                      * Since route struct object contains VR ID, we need to
@@ -972,48 +1413,18 @@ class AsicView
             // TODO fix this
 
             soAll[currentObj->str_object_id] = currentObj;
-            sotAll[currentObj->meta_key.object_type][currentObj->str_object_id] = currentObj;
+            m_objectTypeIndex[currentObj->meta_key.object_type].insert(currentObj);
 
             /*
              * This method will generate ASIC create operation on current
              * existing object similar like SAI REDIS is doing.
              *
-             * NOTE: in long run, this is serialize, and then we call
-             * deserialize to execute them on actual asic, maybe this is not
-             * necessary and could be optimized later.
-             *
              * TODO create on object id attributes should do bind references to
              * used VIDs of of links (currently done outside) and modify
              * dependency tree.
              */
 
-            std::vector<swss::FieldValueTuple> entry;
-
-            for (auto const &pair: currentObj->getAllAttributes())
-            {
-                const auto &attr = pair.second;
-
-                swss::FieldValueTuple fvt(attr->getStrAttrId(), attr->getStrAttrValue());
-
-                entry.push_back(fvt);
-            }
-
-            if (entry.size() == 0)
-            {
-                /*
-                 * Make sure that we put object into db even if there are no
-                 * attributes set.
-                 */
-                swss::FieldValueTuple null("NULL", "NULL");
-
-                entry.push_back(null);
-            }
-
-            std::string key = currentObj->str_object_type + ":" + currentObj->str_object_id;
-
-            std::shared_ptr<swss::KeyOpFieldsValuesTuple> kco = std::make_shared<swss::KeyOpFieldsValuesTuple>(key, "create", entry);
-
-            m_asicOperations.push_back(kco);
+            m_asicOperations.push_back(std::make_shared<AsicOperation>(SAI_COMMON_API_CREATE, currentObj, getAttributesSnapshot(currentObj)));
         }/*}}}*/
 
         // TODO combine to 1 method
@@ -1025,7 +1436,7 @@ class AsicView
             if (currentObj->oidObject)
             {
                 SWSS_LOG_ERROR("object id is not supported yet %s:%s FIXME",
-                        currentObj->str_object_type.c_str(),
+                        currentObj->getStrObjectType().c_str(),
                         currentObj->str_object_id.c_str());
 
                 throw std::runtime_error("object id is not supported yet");
@@ -1035,7 +1446,7 @@ class AsicView
             {
                 case SAI_OBJECT_TYPE_FDB:
 
-                    soFdbs.erase(currentObj->str_object_id);
+                    soFdbs.erase(currentObj->meta_key.key.fdb_entry);
 
                     break;
 
@@ -1048,7 +1459,7 @@ class AsicView
                      * object ids.
                      */
 
-                    soNeighbors.erase(currentObj->str_object_id);
+                    soNeighbors.erase(currentObj->meta_key.key.neighbor_entry);
 
                     m_vidReference[currentObj->meta_key.key.neighbor_entry.rif_id] -= 1;
 
@@ -1061,7 +1472,7 @@ class AsicView
                      * decrease vid reference.
                      */
 
-                    soRoutes.erase(currentObj->str_object_id);
+                    soRoutes.erase(currentObj->meta_key.key.route_entry);
 
                     m_vidReference[currentObj->meta_key.key.route_entry.vr_id] -= 1;
 
@@ -1082,19 +1493,13 @@ class AsicView
             }
 
             soAll.erase(currentObj->str_object_id);
-            sotAll[currentObj->meta_key.object_type].erase(currentObj->str_object_id);
+            m_objectTypeIndex[currentObj->meta_key.object_type].erase(currentObj);
 
             /*
              * Generate asic commands.
              */
 
-            std::vector<swss::FieldValueTuple> entry;
-
-            std::string key = currentObj->str_object_type + ":" + currentObj->str_object_id;
-
-            std::shared_ptr<swss::KeyOpFieldsValuesTuple> kco = std::make_shared<swss::KeyOpFieldsValuesTuple>(key, "remove", entry);
-
-            m_asicOperations.push_back(kco);
+            m_asicOperations.push_back(std::make_shared<AsicOperation>(SAI_COMMON_API_REMOVE, currentObj, std::vector<std::shared_ptr<SaiAttr>>()));
         }/*}}}*/
 
         void asicRemoveObject(/*{{{*/
@@ -1105,7 +1510,7 @@ class AsicView
             if (!currentObj->oidObject)
             {
                 SWSS_LOG_ERROR("non object id is not supported yet %s:%s FIXME",
-                        currentObj->str_object_type.c_str(),
+                        currentObj->getStrObjectType().c_str(),
                         currentObj->str_object_id.c_str());
 
                 throw std::runtime_error("non object id is not supported yet");
@@ -1116,13 +1521,12 @@ class AsicView
              * that check here also as sanity check.
              */
 
-            soOids.erase(currentObj->str_object_id);
             oOids.erase(currentObj->meta_key.key.object_id);
 
             m_vidReference[currentObj->meta_key.key.object_id] -= 1;
 
             soAll.erase(currentObj->str_object_id);
-            sotAll[currentObj->meta_key.object_type].erase(currentObj->str_object_id);
+            m_objectTypeIndex[currentObj->meta_key.object_type].erase(currentObj);
 
             /*
              * Clear object also from rid/vid maps.
@@ -1149,16 +1553,10 @@ class AsicView
              * Generate asic commands.
              */
 
-            std::vector<swss::FieldValueTuple> entry;
-
-            std::string key = currentObj->str_object_type + ":" + currentObj->str_object_id;
-
-            std::shared_ptr<swss::KeyOpFieldsValuesTuple> kco = std::make_shared<swss::KeyOpFieldsValuesTuple>(key, "remove", entry);
-
-            m_asicOperations.push_back(kco);
+            m_asicOperations.push_back(std::make_shared<AsicOperation>(SAI_COMMON_API_REMOVE, currentObj, std::vector<std::shared_ptr<SaiAttr>>()));
         }/*}}}*/
 
-        const std::vector<std::shared_ptr<swss::KeyOpFieldsValuesTuple>>& asicGetOperations() const/*{{{*/
+        const std::vector<std::shared_ptr<AsicOperation>>& asicGetOperations() const/*{{{*/
         {
             SWSS_LOG_ENTER();
 
@@ -1172,97 +1570,314 @@ class AsicView
             return m_asicOperations.size();
         }/*}}}*/
 
-        bool hasRid(/*{{{*/
-                _In_ sai_object_id_t rid) const
-        {
-            return ridToVid.find(rid) != ridToVid.end();
-        }/*}}}*/
-
-        bool hasVid(/*{{{*/
-                _In_ sai_object_id_t vid) const
+        /**
+         * @brief Build reverse references index.
+         *
+         * For each VID collect objects which are referencing it, either by
+         * attribute or by non object id struct key (route VR, neighbor RIF).
+         * Index is a snapshot of links at the time of the call, it's not
+         * updated when view is modified, and it's used only by matching
+         * heuristics.
+         */
+        void buildReverseReferences()/*{{{*/
         {
-            return vidToRid.find(vid) != vidToRid.end();
-        }/*}}}*/
-
-    private:
+            SWSS_LOG_ENTER();
 
-        std::map<sai_object_id_t, int> m_vidReference;
+            m_reverseReferences.clear();
 
-        void populateAttributes(/*{{{*/
-                _In_ std::shared_ptr<SaiObj> &o,
-                _In_ const swss::TableMap &map)
-        {
-            SWSS_LOG_ENTER();
+            referrerSignatures.clear();
 
-            for (const auto &field: map)
+            for (const auto &pair: soAll)
             {
-                std::shared_ptr<SaiAttr> a = std::make_shared<SaiAttr>(field.first, field.second);
-
-                o->setAttr(a);
+                const auto &obj = pair.second;
 
-                for (auto const &vid: a->getOidListFromAttribute())
+                for (const auto &ap: obj->getAllAttributes())
                 {
-                    if (vid != SAI_NULL_OBJECT_ID)
+                    for (auto vid: ap.second->getOidListFromAttribute())
                     {
-                        m_vidReference[vid] += 1;
+                        if (vid != SAI_NULL_OBJECT_ID)
+                        {
+                            m_reverseReferences[vid].push_back(std::make_pair(obj, ap.first));
+                        }
                     }
                 }
+
+                switch (obj->getObjectType())
+                {
+                    case SAI_OBJECT_TYPE_ROUTE:
+                        m_reverseReferences[obj->meta_key.key.route_entry.vr_id].push_back(std::make_pair(obj, KEY_REFERENCE_ATTR_ID));
+                        break;
+
+                    case SAI_OBJECT_TYPE_NEIGHBOR:
+                        m_reverseReferences[obj->meta_key.key.neighbor_entry.rif_id].push_back(std::make_pair(obj, KEY_REFERENCE_ATTR_ID));
+                        break;
+
+                    default:
+                        break;
+                }
             }
         }/*}}}*/
 
-        std::shared_ptr<SaiObj> createSwitchObject()/*{{{*/
+        const std::vector<std::pair<std::shared_ptr<SaiObj>, sai_attr_id_t>>& getReverseReferences(/*{{{*/
+                _In_ sai_object_id_t vid) const
         {
             SWSS_LOG_ENTER();
 
-            /*
-             * Switch object is using default value which is zero for object id.  In
-             * SAI 1.0 it will use actual value, and this method here will not be
-             * needed.
-             */
-
-            sai_object_id_t object_id = 0;
+            static const std::vector<std::pair<std::shared_ptr<SaiObj>, sai_attr_id_t>> empty;
 
-            std::shared_ptr<SaiObj> sw = std::make_shared<SaiObj>();
+            auto it = m_reverseReferences.find(vid);
 
-            sw->str_object_id        = sai_serialize_object_id(object_id);
-            sw->str_object_type      = "SAI_OBJECT_TYPE_SWITCH";
-            sw->meta_key.object_type = SAI_OBJECT_TYPE_SWITCH;
-            sw->meta_key.key.object_id = object_id;
+            if (it == m_reverseReferences.end())
+            {
+                return empty;
+            }
 
-            return sw;
+            return it->second;
         }/*}}}*/
 
-        /*
-         * Not sure if there is sense to make this shared, ony reason is to skip
-         * copy expensive KeyOpFieldsValuesTuple objects.
+        /**
+         * @brief Log estimated memory used by this view.
+         *
+         * Estimation includes object keys, serialized attribute values and
+         * index entries, but not allocated lists of materialized attributes.
          */
+        void logMemoryUsage(/*{{{*/
+                _In_ const std::string &name) const
+        {
+            SWSS_LOG_ENTER();
 
-        std::vector<std::shared_ptr<swss::KeyOpFieldsValuesTuple>> m_asicOperations;
-
-        AsicView(const SaiAttr&);
-        AsicView& operator=(const SaiAttr&);
-};
-
-void redisGetAsicView(/*{{{*/
-        _In_ std::string tableName,
-        _In_ AsicView &view)
-{
-    SWSS_LOG_ENTER();
+            size_t bytes = 0;
+            size_t attributes = 0;
+            size_t materialized = 0;
 
-    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+            for (const auto &p: soAll)
+            {
+                const auto &o = p.second;
 
-    SWSS_LOG_NOTICE("tableName: %s", tableName.c_str());
+                bytes += sizeof(SaiObj) + o->str_object_id.capacity();
 
-    swss::Table table(&db, tableName);
+                /*
+                 * Key string of primary index and map node overhead.
+                 */
 
-    swss::TableDump dump;
+                bytes += p.first.capacity() + 2 * sizeof(void*);
 
-    table.dump(dump);
+                for (const auto &a: o->getAllAttributes())
+                {
+                    bytes += a.second->getEstimatedMemoryUsage() + 2 * sizeof(void*);
 
-    view.fromDump(dump);
+                    attributes++;
 
-    SWSS_LOG_NOTICE("objects count: %zu", view.soAll.size());
-}/*}}}*/
+                    if (a.second->isMaterialized())
+                    {
+                        materialized++;
+                    }
+                }
+            }
+
+            bytes += oOids.size() * (sizeof(sai_object_id_t) + 2 * sizeof(void*));
+            bytes += soAll.size() * (sizeof(std::shared_ptr<SaiObj>) + 2 * sizeof(void*));
+            bytes += (soFdbs.size() + soNeighbors.size() + soRoutes.size()) * (sizeof(sai_object_meta_key_t) + 2 * sizeof(void*));
+            bytes += (soSwitches.size() + soVlans.size() + soTraps.size()) * (sizeof(std::string) + 2 * sizeof(void*));
+
+            SWSS_LOG_NOTICE("%s view memory: %zu objects, %zu attributes (%zu materialized), estimated %zu kB",
+                    name.c_str(),
+                    soAll.size(),
+                    attributes,
+                    materialized,
+                    bytes / 1024);
+        }/*}}}*/
+
+        bool hasRid(/*{{{*/
+                _In_ sai_object_id_t rid) const
+        {
+            return ridToVid.find(rid) != ridToVid.end();
+        }/*}}}*/
+
+        bool hasVid(/*{{{*/
+                _In_ sai_object_id_t vid) const
+        {
+            return vidToRid.find(vid) != vidToRid.end();
+        }/*}}}*/
+
+        /**
+         * @brief Sorted referrer signatures by VID.
+         *
+         * Signatures are computed from reverse references index, so they are
+         * valid as long as index is, and they are cleared when index is
+         * rebuilt. Cache is filled only from heuristic matching, which is
+         * executed serially.
+         */
+        mutable std::unordered_map<sai_object_id_t, std::vector<std::string>> referrerSignatures;
+
+    private:
+
+        std::map<sai_object_id_t, int> m_vidReference;
+
+        std::unordered_map<sai_object_id_t, std::vector<std::pair<std::shared_ptr<SaiObj>, sai_attr_id_t>>> m_reverseReferences;
+
+        std::shared_ptr<SaiObj> createSwitchObject()/*{{{*/
+        {
+            SWSS_LOG_ENTER();
+
+            /*
+             * Switch object is using default value which is zero for object id.  In
+             * SAI 1.0 it will use actual value, and this method here will not be
+             * needed.
+             */
+
+            sai_object_id_t object_id = 0;
+
+            std::shared_ptr<SaiObj> sw = std::make_shared<SaiObj>();
+
+            sw->str_object_id        = sai_serialize_object_id(object_id);
+            sw->meta_key.object_type = SAI_OBJECT_TYPE_SWITCH;
+            sw->meta_key.key.object_id = object_id;
+
+            return sw;
+        }/*}}}*/
+
+        std::vector<std::shared_ptr<AsicOperation>> m_asicOperations;
+
+        std::vector<std::shared_ptr<SaiAttr>> getAttributesSnapshot(/*{{{*/
+                _In_ const std::shared_ptr<SaiObj> &currentObj) const
+        {
+            SWSS_LOG_ENTER();
+
+            std::vector<std::shared_ptr<SaiAttr>> attrs;
+
+            for (auto const &pair: currentObj->getAllAttributes())
+            {
+                attrs.push_back(pair.second);
+            }
+
+            return attrs;
+        }/*}}}*/
+
+        AsicView(const SaiAttr&);
+        AsicView& operator=(const SaiAttr&);
+};
+
+/**
+ * @brief Execute function for each index in range using multiple threads.
+ *
+ * Function must be safe to call concurrently. If any call throws, first
+ * exception is rethrown after all threads finish.
+ */
+void parallelFor(/*{{{*/
+        _In_ size_t count,
+        _In_ const std::function<void(size_t)> &fn)
+{
+    SWSS_LOG_ENTER();
+
+    size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), count);
+
+    if (threadCount <= 1)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            fn(idx);
+        }
+
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(threadCount);
+
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            try
+            {
+                for (size_t idx = t; idx < count; idx += threadCount)
+                {
+                    fn(idx);
+                }
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+
+    for (auto &th: threads)
+    {
+        th.join();
+    }
+
+    for (const auto &e: errors)
+    {
+        if (e)
+        {
+            std::rethrow_exception(e);
+        }
+    }
+}/*}}}*/
+
+/*
+ * Number of keys requested by single SCAN, and also maximum number of
+ * HGETALL commands pipelined at once, so only that many objects are kept in
+ * memory as raw redis replies.
+ */
+
+#define ASIC_VIEW_SCAN_BATCH_SIZE 1024
+
+void redisGetAsicView(/*{{{*/
+        _In_ std::string tableName,
+        _In_ AsicView &view)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Each view is read on it's own connection, so both views can be read at
+     * the same time. Keys are iterated using SCAN and values are fetched in
+     * pipelined HGETALL batches, so there is no full table dump in memory.
+     */
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    RedisPipeline pipeline(&db, ASIC_VIEW_SCAN_BATCH_SIZE);
+
+    SWSS_LOG_NOTICE("tableName: %s", tableName.c_str());
+
+    /*
+     * SCAN may return same key more than once, but pipeline passes each key
+     * only once, so objects are not added twice to view, which would
+     * increase reference counts of VIDs they use more than once.
+     */
+
+    pipeline.scanHashes(tableName + ":*",
+            [&](const std::vector<std::string> &keys, std::vector<RedisHashFields> &fields)
+            {
+                /*
+                 * Attributes are parsed on worker threads, only adding
+                 * objects to view indexes is done serially.
+                 */
+
+                std::vector<std::shared_ptr<SaiObj>> objects(keys.size());
+
+                parallelFor(keys.size(), [&](size_t idx)
+                {
+                    /*
+                     * Skip table name and colon.
+                     */
+
+                    objects[idx] = AsicView::parseObject(keys[idx].substr(tableName.size() + 1), fields[idx]);
+                });
+
+                for (const auto &o: objects)
+                {
+                    view.addObject(o);
+                }
+            });
+
+    view.addDefaultObjects();
+
+    SWSS_LOG_NOTICE("objects count: %zu, redis round trips: %zu", view.soAll.size(), pipeline.getRoundTrips());
+}/*}}}*/
 
 sai_status_t checkObjectsStatus(/*{{{*/
         _In_ const AsicView &view)
@@ -1278,7 +1893,7 @@ sai_status_t checkObjectsStatus(/*{{{*/
             const auto &o = *p.second;
 
             SWSS_LOG_ERROR("object was not processed: %s %s, status: %d (ref: %d)",
-                    o.str_object_type.c_str(),
+                    o.getStrObjectType().c_str(),
                     o.str_object_id.c_str(),
                     o.getObjectStatus(),
                     o.oidObject ? view.getVidReferenceCount(o.getVid()): -1);
@@ -1350,7 +1965,7 @@ void matchOids(/*{{{*/
         temporaryIt.second->setObjectStatus(SAI_OBJECT_STATUS_MATCHED);
         currentIt->second->setObjectStatus(SAI_OBJECT_STATUS_MATCHED);
 
-        SWSS_LOG_INFO("matched %s RID 0x%lx VID 0x%lx", currentIt->second->str_object_type.c_str(), rid, vid);
+        SWSS_LOG_INFO("matched %s RID 0x%lx VID 0x%lx", currentIt->second->getStrObjectType().c_str(), rid, vid);
     }
 
     SWSS_LOG_NOTICE("matched oids");
@@ -1398,183 +2013,112 @@ void checkMatchedPorts(/*{{{*/
 }/*}}}*/
 
 /**
- * @brief Check if both list contains the same objects
- *
- * Function returns TRUE only when all list contain exact the same objects
- * compared by RID values and with exact same order.
+ * @brief Translate VID list to RID list.
  *
- * TODO Currently order on the list matters, but we need to update this logic
- * so order will not matter, just values of object will need to be considered.
- * We need to have extra index of processed objects and not processed yet.  We
- * should also cover NULL case and duplicated objects.  Normally we should not
- * have duplicated object id's on the list, and we can easy check that using
- * hash.
- *
- * In case of really long list, easier way to solve this can be getting all the
- * RIDs from current view (they must exist), getting all the matched RIDs from
- * temporary list (if one of them don't exists then lists are not equal) sort
- * both list nlog(n) and then compare sequentially.
+ * NULL object id is translated to NULL. Returns false if any of VIDs don't
+ * have RID assigned in given view.
  */
-bool hasEqualObjectList(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView,
-        _In_ uint32_t current_count,
-        _In_ const sai_object_id_t *current_list,
-        _In_ uint32_t temporary_count,
-        _In_ const sai_object_id_t *temporary_list)
+bool translateVidListToRidList(/*{{{*/
+        _In_ const AsicView &view,
+        _In_ uint32_t count,
+        _In_ const sai_object_id_t *vids,
+        _Out_ std::vector<sai_object_id_t> &rids)
 {
     SWSS_LOG_ENTER();
 
-    if (current_count != temporary_count)
-    {
-        /*
-         * Length of lists are not equal, so lists are different.
-         */
-
-        return false;
-    }
+    rids.resize(count);
 
-    for (uint32_t idx = 0; idx < current_count; ++idx)
+    for (uint32_t idx = 0; idx < count; ++idx)
     {
-        sai_object_id_t currentVid = current_list[idx];
-        sai_object_id_t temporaryVid = temporary_list[idx];
+        sai_object_id_t vid = vids[idx];
 
-        if (currentVid == SAI_NULL_OBJECT_ID &&
-                temporaryVid == SAI_NULL_OBJECT_ID)
+        if (vid == SAI_NULL_OBJECT_ID)
         {
-            /*
-             * Both current and temporary are the same so we
-             * continue for next item on list.
-             */
-
+            rids[idx] = SAI_NULL_OBJECT_ID;
             continue;
         }
 
-        if (currentVid != SAI_NULL_OBJECT_ID &&
-                temporaryVid != SAI_NULL_OBJECT_ID)
+        if (getObjectTypeFromVid(vid) == SAI_OBJECT_TYPE_NULL)
         {
             /*
-             * Check for object type of both objects, they must
-             * match.  But maybe this is not necessary, since true
-             * is returned only when RIDs match, so it's more like
-             * sanity check.
+             * This case should never happen, we always should be able to
+             * extract valid object type from any VID, if this happens then we
+             * have a bug.
              */
 
-            sai_object_type_t temporaryObjectType = getObjectTypeFromVid(temporaryVid);
-            sai_object_type_t currentObjectType = getObjectTypeFromVid(currentVid);
-
-            if (temporaryObjectType == SAI_OBJECT_TYPE_NULL ||
-                    currentObjectType == SAI_OBJECT_TYPE_NULL)
-            {
-                /*
-                 * This case should never happen, we always should
-                 * be able to extract valid object type from any
-                 * VID, if this happens then we have a bug.
-                 */
-
-                SWSS_LOG_ERROR("temporary object type is %d and current object type is %d, FATAL",
-                        temporaryObjectType,
-                        currentObjectType);
+            SWSS_LOG_ERROR("VID 0x%lx returned NULL object type, FATAL", vid);
 
-                throw std::runtime_error("temporary or current object returned NULL object type, FATAL");
-            }
-
-            if (temporaryObjectType != currentObjectType)
-            {
-                /*
-                 * Compared object types are different, so they can't be equal,
-                 * so return false here. No need for checking other objects on
-                 * list.
-                 */
-
-                return false;
-            }
-
-            auto temporaryIt = temporaryView.vidToRid.find(temporaryVid);
-
-            if (temporaryIt == temporaryView.vidToRid.end())
-            {
-                /*
-                 * Temporary RID don't exist yet for this object, so it mean's
-                 * this object will be created in the future after all
-                 * comparison logic finishes.
-                 *
-                 * Here we know that this temporary object is not processed yet
-                 * but during recursive processing we know that this OID value
-                 * was already processed, and two things could happened:
-                 *
-                 * - we matched existing current object for this VID and actual
-                 *   RID was assigned, or
-                 *
-                 * - during matching we didn't matched current object so RID is
-                 *   not assigned, and this object will be created later on
-                 *   which will assign new RID
-                 *
-                 * Since we are here where RID don't exist this is the second
-                 * case, also we know that current object VID exists so his RID
-                 * also exists, so those RID's can't be equal, we need return
-                 * false here.
-                 *
-                 * Fore more strong verification we can introduce and extra
-                 * flag in SaiObj indicating that object was processed and it
-                 * needs to be created.
-                 */
-
-                SWSS_LOG_INFO("temporary RID don't exists (VID 0x%lx), attributes are not equal", temporaryVid);
+            throw std::runtime_error("VID returned NULL object type, FATAL");
+        }
 
-                return false;
-            }
+        auto it = view.vidToRid.find(vid);
 
-            /*
-             * Current VID exists, so current RID also must exists but let's
-             * put sanity check here just in case if we mess something up, this
-             * should never happen.
-             */
+        if (it == view.vidToRid.end())
+        {
+            return false;
+        }
 
-            auto currentIt = currentView.vidToRid.find(currentVid);
+        rids[idx] = it->second;
+    }
 
-            if (currentIt == currentView.vidToRid.end())
-            {
-                SWSS_LOG_ERROR("current VID 0x%lx exists but current RID is missing, FATAL", currentVid);
+    return true;
+}/*}}}*/
 
-                throw std::runtime_error("current VID exists, but current RID is missing, FATAL");
-            }
+/**
+ * @brief Check if both list contains the same objects
+ *
+ * Function returns TRUE only when both lists contain exact the same objects
+ * compared by RID values, order on the list don't matter. Lists are compared
+ * as multisets, so NULL objects and duplicated objects must appear the same
+ * number of times on both lists.
+ *
+ * All RIDs from current list must exist. If any of temporary list objects
+ * don't have RID yet, that object will be created, so lists can't be equal.
+ * Since RIDs are unique, equal RIDs means also equal object types.
+ */
+bool hasEqualObjectList(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ uint32_t current_count,
+        _In_ const sai_object_id_t *current_list,
+        _In_ uint32_t temporary_count,
+        _In_ const sai_object_id_t *temporary_list)
+{
+    SWSS_LOG_ENTER();
 
-            sai_object_id_t temporaryRid = temporaryIt->second;
-            sai_object_id_t currentRid = currentIt->second;
+    if (current_count != temporary_count)
+    {
+        /*
+         * Length of lists are not equal, so lists are different.
+         */
 
-            /*
-             * If RID's are equal, then object attribute values are equal as well.
-             */
+        return false;
+    }
 
-            if (temporaryRid == currentRid)
-            {
-                continue;
-            }
+    std::vector<sai_object_id_t> currentRids;
+    std::vector<sai_object_id_t> temporaryRids;
 
-            /*
-             * If RIDs are different, then list are not equal.
-             */
+    if (!translateVidListToRidList(currentView, current_count, current_list, currentRids))
+    {
+        SWSS_LOG_ERROR("current VID exists but current RID is missing, FATAL");
 
-            return false;
-        }
+        throw std::runtime_error("current VID exists, but current RID is missing, FATAL");
+    }
 
+    if (!translateVidListToRidList(temporaryView, temporary_count, temporary_list, temporaryRids))
+    {
         /*
-         * If we are here that means one of attributes value OIDs
-         * is NULL and other is not, so they are not equal we need
-         * to return false.
+         * Temporary RID don't exist yet for some object, so it mean's this
+         * object will be created in the future after all comparison logic
+         * finishes, and it can't be equal to any current object.
          */
 
+        SWSS_LOG_INFO("temporary RID don't exists, attributes are not equal");
+
         return false;
     }
 
-    /*
-     * We processed all objects on both lists, and they all are equal so both
-     * list are equal even if they are empty. We need to return true in this
-     * case.
-     */
-
-    return true;
+    return isEqualObjectIdMultiset(std::move(currentRids), std::move(temporaryRids));
 }/*}}}*/
 
 /**
@@ -1743,653 +2287,603 @@ bool isOidOnAttrValue(/*{{{*/
     return false;
 }/*}}}*/
 
-std::shared_ptr<SaiObj> findCurrentBestMatchForGenericObjectUsingHeuristic(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> temporaryObj,
-        _In_ const std::vector<sai_object_compare_info_t> &candidateObjects)
+/**
+ * @brief Compute canonical content hash of object attributes.
+ *
+ * Object id attributes are hashed by sorted RID values, so objects from
+ * current and temporary view referencing the same objects have the same hash
+ * even if VIDs or order on the list are different. Attributes are combined
+ * independently of their order.
+ *
+ * Returns false if any referenced VID has no RID yet, which means that
+ * referenced object will be created, so object can't be equal to any
+ * existing current object.
+ */
+bool computeContentHash(/*{{{*/
+        _In_ const AsicView &view,
+        _In_ const SaiObj &obj,
+        _Out_ size_t &hash)
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * This method will select heuristic method for best current object
-     * matching for given temporary object based on object type.  If heuristic
-     * don't exists yet, then current object will be choosen at random.
-     */
-
-    sai_object_type_t object_type = temporaryObj->getObjectType();
-
-    /*
-     * TODO later on we can have a list of heuristic function pointers since
-     * all signatures will be the same.
-     *
-     * Also if heuristic function can't decide it should return random object
-     * as well, it could return nullptr and we could deal with it here as well.
-     */
+    hash = std::hash<size_t>()(obj.getAllAttributes().size());
 
-    switch (object_type)
+    for (const auto &ita: obj.getAllAttributes())
     {
-        default:
+        const auto &attr = ita.second;
 
-            SWSS_LOG_WARN("%s is not supported for heuristic, will select best match object at random",
-                    sai_serialize_object_type(object_type).c_str());
+        size_t attrHash;
 
-            break;
-    }
-
-    return selectRandomCandidate(candidateObjects);
-}/*}}}*/
-
-std::shared_ptr<SaiObj> findCurrentBestMatchForGenericObject(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> temporaryObj)
-{
-    SWSS_LOG_ENTER();
-
-    /*
-     * This method will try to find current best match object for a given
-     * temporary object. This method should be used only on object id objects,
-     * since non object id structures also contains object id which in this
-     * case are not take into account. Besides for objects like FDB, ROUTE or
-     * NEIGHBOR we can do quick hash lookup instead of looping for all objects
-     * where there can be a lot of them.
-     *
-     * Special case here we can add later on is VLAN, since we can have a lot
-     * of VLANS so instead looking via all of them we just need to make sure
-     * that we will create reverse map via VLAN_ID KEY and then we can make
-     * hash lookup to see if such vlan is present.
-     */
-
-    /*
-     * Since our system design is to restart orch agend withourt restarting
-     * syncd and recreating objects and reassign new VIDs created inside orch
-     * agent, in our most cases values of objects will not change.  This will
-     * cause to make our comparison logic here faily simple:
-     *
-     * Find all objects that have the same equal attributes on current object
-     * and choose the one with the most attributes that match current and
-     * temporary object.
-     *
-     * This seems simple, but there are a lot of cases that needs to be taken
-     * into account:
-     *
-     * - what if we have several objects with the same number of equal
-     *   attributes then we can choose at random or implement some heuristic
-     *   logic to try figure out which of those objects will be the best, even
-     *   then if we choose wrong object, then there can be a lot of removes and
-     *   recreating objects on the ASIC
-     *
-     * - what if in temporary object CREATE_ONLY attributes don't match but
-     *   many of CREATE_AND_SET are the same, in that case we can choose object
-     *   with most matching attributes, but object will still needs to be
-     *   destroyed becasuse we need to set new CREATE_ONLY attributes
-     *
-     * - there are also cases with default values of attributes where attribute
-     *   is present only in one object but on other one it have defaule value
-     *   and this default value is the same as the one in attribute
-     *
-     * - another case is for objects that needs to be removed since there are
-     *   no corresponding objects in remporary view, but they can't be removed,
-     *   objects like PORT or default QUEUEs or INGRESS_PRIORITY_GROUPs, then
-     *   we need to bring their current set values to default ones, which also
-     *   can be challenging since we need to know prevous default value and it
-     *   could be assigned by switch internally, like default MAC addres or
-     *   default TRAP group etc
-     *
-     * - there is also interesting case with KEYs attributes which when
-     *   doing remove/create they needs to be removed first since
-     *   we can't have 2 identical cases
-     *
-     * There are alot of aspects to consider here, in here we will cake only
-     * couple of them in consideration, and other will be taken care inside
-     * processObjectForViewTransition method which will handle all other cases
-     * not mentioned here.
-     */
-
-    /*
-     * First check if object is oid object, if yes, chek if it status is
-     * matched.
-     */
-
-    if (!temporaryObj->oidObject)
-    {
-        SWSS_LOG_ERROR("non object id %s is used in generic method, please implement special case, FIXME", temporaryObj->str_object_type.c_str());
-
-        throw std::runtime_error("non object id is used in generic method, implement special case, FIXME");
-    }
-
-    /*
-     * Get not processed objects of temporary object type, and all attributes
-     * that are set on that object. This function should be used only on oid
-     * object ids, since for non object id findinf best match is based on
-     * struct entry of object id.
-     */
-
-    sai_object_type_t object_type = temporaryObj->getObjectType();
+        if (attr->isObjectIdAttr())
+        {
+            const auto meta = attr->getAttrMetadata();
 
-    const auto notProcessedObjects = currentView.getNotProcessedObjectsByObjectType(object_type);
+            attrHash = hashCombine(0, meta->serializationtype);
 
-    const auto attrs = temporaryObj->getAllAttributes();
+            /*
+             * Enable flag of ACL field and action is part of the value, when
+             * disabled oid list is empty.
+             */
 
-    /*
-     * Complexity here is O((n^2)*m) since we iterate via all not processed
-     * objects, then we iterate through all present attributes.  N is squared
-     * since for given object type we iterate via entire list for each object,
-     * this can be optimized a little bit inside AsicView class.
-     */
+            switch (meta->serializationtype)
+            {
+                case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+                case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+                    attrHash = hashCombine(attrHash, attr->getSaiAttr()->value.aclfield.enable);
+                    break;
 
-    SWSS_LOG_INFO("not processed objects for %s: %zu, attrs: %zu",
-            temporaryObj->str_object_type.c_str(),
-            notProcessedObjects.size(),
-            attrs.size());
+                case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+                case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+                    attrHash = hashCombine(attrHash, attr->getSaiAttr()->value.aclaction.enable);
+                    break;
 
-    std::vector<sai_object_compare_info_t> candidateObjects;
+                default:
+                    break;
+            }
 
-    for (const auto &currentObj: notProcessedObjects)
-    {
-        sai_object_compare_info_t soci = { 0, currentObj };
+            const auto vids = attr->getOidListFromAttribute();
 
-        bool has_different_create_only_attr = false;
+            std::vector<sai_object_id_t> rids;
 
-        for (const auto &attr: attrs)
-        {
-            sai_attr_id_t attrId = attr.first;
+            if (!translateVidListToRidList(view, (uint32_t)vids.size(), vids.data(), rids))
+            {
+                return false;
+            }
 
             /*
-             * Function hasEqualAttribute check if attribute exists on both objects.
+             * Object lists are compared regardless of order.
              */
 
-            if (hasEqualAttribute(currentView, temporaryView, currentObj, temporaryObj, attrId))
-            {
-                soci.equal_attributes++;
+            std::sort(rids.begin(), rids.end());
 
-                SWSS_LOG_DEBUG("ob equal %s %s, %s: %s",
-                        temporaryObj->str_object_id.c_str(),
-                        currentObj->str_object_id.c_str(),
-                        attr.second->getStrAttrId().c_str(),
-                        attr.second->getStrAttrValue().c_str());
-            }
-            else
+            for (const auto &rid: rids)
             {
-                SWSS_LOG_DEBUG("ob not equal %s %s, %s: %s",
-                        temporaryObj->str_object_id.c_str(),
-                        currentObj->str_object_id.c_str(),
-                        attr.second->getStrAttrId().c_str(),
-                        attr.second->getStrAttrValue().c_str());
+                attrHash = hashCombine(attrHash, std::hash<sai_object_id_t>()(rid));
+            }
+        }
+        else
+        {
+            attrHash = std::hash<std::string>()(attr->getStrAttrValue());
+        }
 
-                /*
-                 * Function hasEqualAttribute returns true only when both
-                 * attributes are existing and both are equal, so here it
-                 * returned false, so it may mean 2 things:
-                 *
-                 * - attribute don't exists in current view, or
-                 * - attributes are different
-                 *
-                 * If we check if attribute also exists in current view and has
-                 * CREATE_ONLY flag then attributes are different and we
-                 * disqualify this object since new temporary object needs to
-                 * pass new differetn attribute with CREATE_ONLY flag.
-                 *
-                 * Case when attribute don't exists is much more complicated
-                 * since it maybe conditional and have default value, we will
-                 * do that check when we select best match.
-                 */
+        hash += hashCombine(std::hash<sai_attr_id_t>()(ita.first), attrHash);
+    }
 
-                /*
-                 * Get attribute metadata to see if contains CREATE_ONLY flag.
-                 */
+    return true;
+}/*}}}*/
 
-                const sai_attr_metadata_t* meta = attr.second->getAttrMetadata();
+/**
+ * @brief Compute and cache content hash for all objects in view.
+ */
+void computeContentHashes(/*{{{*/
+        _In_ const AsicView &view)
+{
+    SWSS_LOG_ENTER();
 
-                if (HAS_FLAG_CREATE_ONLY(meta->flags) && currentObj->hasAttr(attrId))
-                {
-                    has_different_create_only_attr = true;
+    std::vector<std::shared_ptr<SaiObj>> objects;
 
-                    SWSS_LOG_INFO("obj has not equal create only attributes %s", temporaryObj->str_object_id.c_str());
+    objects.reserve(view.soAll.size());
 
-                    /*
-                     * In this case there is no need to compare other
-                     * attributes since we won't be able to update them anyway.
-                     */
+    for (const auto &p: view.soAll)
+    {
+        objects.push_back(p.second);
+    }
 
-                    break;
-                }
-            }
-        }
+    parallelFor(objects.size(), [&](size_t idx)
+    {
+        size_t hash;
 
-        if (has_different_create_only_attr)
+        if (computeContentHash(view, *objects[idx], hash))
         {
-            /*
-             * Those objects differs with attribute which is marked as
-             * CREATE_ONLY so we will not be able to update current if
-             * necessary using SET operations.
-             */
-
-            continue;
+            objects[idx]->setContentHash(hash);
         }
+    });
+}/*}}}*/
 
-        candidateObjects.push_back(soci);
+/**
+ * @brief Check whether temporary object has the same key and content as
+ * current best match.
+ *
+ * Key is the same if objects were matched by VID, or if non object id
+ * object was found by it's struct key. In that case set transition would
+ * not generate any operation, so object can be moved to final state right
+ * away.
+ *
+ * Content hash is used only to reject objects quickly, hashes can collide,
+ * so when hashes are equal attributes are still compared one by one.
+ */
+bool hasEqualContent(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> &currentObj,
+        _In_ const std::shared_ptr<SaiObj> &temporaryObj)
+{
+    SWSS_LOG_ENTER();
+
+    if (temporaryObj->oidObject &&
+            (temporaryObj->getObjectStatus() != SAI_OBJECT_STATUS_MATCHED ||
+             currentObj->getVid() != temporaryObj->getVid()))
+    {
+        return false;
     }
 
-    SWSS_LOG_INFO("number candidate objects for %s is %zu", temporaryObj->str_object_id.c_str(), candidateObjects.size());
+    size_t currentHash;
 
-    if (candidateObjects.size() == 0)
+    if (!currentObj->getContentHash(currentHash))
     {
-        /*
-         * We didn't found any object.
-         */
-
-        return nullptr;
+        return false;
     }
 
-    if (candidateObjects.size() == 1)
-    {
-        /*
-         * We found only one object so it must be it.
-         */
+    size_t temporaryHash;
 
-        return candidateObjects.begin()->obj;
+    if (!computeContentHash(temporaryView, *temporaryObj, temporaryHash))
+    {
+        return false;
     }
 
-    /*
-     * If we have more than 1 object matched actually more preffered
-     * object would be the object with most CREATE_ONLY attributes matching
-     * since that will reduce risk of removind and recreateing that object in
-     * current view.
-     */
+    if (currentHash != temporaryHash)
+    {
+        return false;
+    }
 
-    /*
-     * Sort candidate objects by equal attributes in descending order, we know
-     * here that we have at least 2 candidates.
-     *
-     * NOTE: maybe at this point we should be using heuristics?
-     */
+    const auto &currentAttrs = currentObj->getAllAttributes();
+    const auto &temporaryAttrs = temporaryObj->getAllAttributes();
 
-    std::sort(candidateObjects.begin(), candidateObjects.end(), compareByEqualAttributes);
+    if (currentAttrs.size() != temporaryAttrs.size())
+    {
+        return false;
+    }
 
-    if (candidateObjects[0].equal_attributes > candidateObjects[1].equal_attributes)
+    for (const auto &ap: temporaryAttrs)
     {
         /*
-         * We have only 1 object with the greatest number of equal attributes
-         * lets choose that object as our best match.
+         * Attribute missing on current object is handled here as well, since
+         * hasEqualAttribute requires attribute to be present on both.
          */
 
-        return candidateObjects.begin()->obj;
-    }
-
-    /*
-     * In here there are at least 2 current objects that have the same
-     * number of equal attributes. In here we can do two things
-     *
-     * - select object at random, or
-     * - use heuristic/smart lookup for inside graph
-     *
-     * Smart lookup would be for example searching wheter current object is
-     * pointing to the same PORT as temporary object (since ports are matched
-     * at the beginning). For different types of objects we need different type
-     * of logic and we can start adding that when needed and when missing we
-     * will just choose at random possiblu causing some remove/recreate but
-     * this logic is not perfect at this point.
-     */
-
-    /*
-     * Lets also remove candidates with less equal attributes
-     */
+        if (!hasEqualAttribute(currentView, temporaryView, currentObj, temporaryObj, ap.first))
+        {
+            SWSS_LOG_WARN("content hash collision on %s, attribute %s differs",
+                    temporaryObj->str_object_id.c_str(),
+                    ap.second->getStrAttrId().c_str());
 
-    size_t previousCandidates = candidateObjects.size();
+            return false;
+        }
+    }
 
-    size_t equalAttributes = candidateObjects[0].equal_attributes;
+    return true;
+}/*}}}*/
 
-    auto endIt = std::remove_if(candidateObjects.begin(), candidateObjects.end(),
-            [equalAttributes](const sai_object_compare_info_t &candidate)
-            { return candidate.equal_attributes != equalAttributes; });
+/*
+ * Number of objects moved to final state by content hash comparison.
+ */
 
-    candidateObjects.erase(endIt, candidateObjects.end());
+size_t g_contentHashMatches = 0;
 
-    SWSS_LOG_INFO("multiple candidates found (%zu of %zu) for %s, will use heuristic",
-            candidateObjects.size(),
-            previousCandidates,
-            temporaryObj->str_object_id.c_str());
+/*
+ * Statistics of heuristic selections during current apply view, estimated
+ * number of operations for selected objects and expected number of
+ * operations if objects would be selected at random.
+ */
 
-    return findCurrentBestMatchForGenericObjectUsingHeuristic(
-            currentView,
-            temporaryView,
-            temporaryObj,
-            candidateObjects);
-}/*}}}*/
+size_t g_heuristicSelections = 0;
+size_t g_heuristicSelectedCost = 0;
+double g_heuristicRandomCost = 0;
 
-std::shared_ptr<SaiObj> findCurrentBestMatchForNeighborEntry(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+/**
+ * @brief Get referrer signature.
+ *
+ * Signature identifies object which is referencing other object, and it don't
+ * depend on VIDs, so referrers of current and temporary objects can be
+ * compared between views. For example route referencing next hop is
+ * identified by it's destination prefix, and next hop referencing router
+ * interface is identified by it's primitive attributes like IP address.
+ *
+ * Object id attributes of referrer are represented by object types they
+ * point to, so for example next hops with the same IP address pointing to
+ * router interface and to tunnel are not considered equal.
+ */
+std::string getReferrerSignature(/*{{{*/
+        _In_ const std::shared_ptr<SaiObj> &referrer,
+        _In_ sai_attr_id_t attrId)
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * For Neighbor we don't need to iterate via all current
-     * neighbors, we can do dictionary lookup, but we need
-     * to do smart trick, since temporary object was processed
-     * we just need to check whether VID in neighbor_entry
-     * struct is matched/final and it has RID assigned from
-     * current view. If, RID exists, we can use that RID
-     * to get VID of current view, exchange in neighbor_entry
-     * struct and do dictionary lookup on serialized neighbor_entry.
-     *
-     * With this approach for many entries this is the quickest
-     * possible way. In case when RID don't exist, that means
-     * we have invalid neighbor entry, so we must return null.
-     */
-
-    /*
-     * Make a copy here to not destroy object data, later
-     * on this data should be read only.
-     */
+    std::string sig = referrer->getStrObjectType() + ":" + std::to_string(attrId) + ":";
 
-    sai_neighbor_entry_t ne = temporaryObj->meta_key.key.neighbor_entry;
+    switch (referrer->getObjectType())
+    {
+        case SAI_OBJECT_TYPE_ROUTE:
+            return sig + sai_serialize_ip_prefix(referrer->meta_key.key.route_entry.destination);
 
-    sai_object_id_t temporaryRouterInterfaceVid = ne.rif_id;
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+            return sig + sai_serialize_ip_address(referrer->meta_key.key.neighbor_entry.ip_address);
 
-    auto temporaryIt = temporaryView.vidToRid.find(temporaryRouterInterfaceVid);
+        default:
+            break;
+    }
 
-    if (temporaryIt == temporaryView.vidToRid.end())
+    if (!referrer->oidObject)
     {
-        /*
-         * RID for router interface in neighbor_entry struct was not assigned,
-         * so we didn't matched it in previous processing router interfaces, or
-         * router interface will be created later on. This mean we can't
-         * match neighbor because even if all attributes are matchind, RID in
-         * neighbor struct after create will not match so at the end of
-         * processing current neighbor will need to be destroyed and new one
-         * needs to be created.
-         */
-
-        return nullptr;
+        return sig + referrer->str_object_id;
     }
 
     /*
-     * We found RID which should be in current view, now we need to
-     * get current view VID to replace is in our neighbor_entry copy.
+     * Attributes are sorted by id, since order of attributes on object is
+     * random.
      */
 
-    sai_object_id_t temporaryRid = temporaryIt->second;
-
-    auto currentIt = currentView.ridToVid.find(temporaryRid);
+    std::map<sai_attr_id_t, std::string> values;
 
-    if (currentIt == currentView.ridToVid.end())
+    for (const auto &ap: referrer->getAllAttributes())
     {
-        /*
-         * This is just sanity check, should never happen.
-         */
+        if (!ap.second->isObjectIdAttr())
+        {
+            values[ap.first] = ap.second->getStrAttrValue();
 
-        SWSS_LOG_ERROR("found tempoary RID 0x%lx but current VID don't exists, FATAL", temporaryRid);
+            continue;
+        }
 
-        throw std::runtime_error("found temporary RID but current VID don't exists, FATAL");
-    }
+        std::string types;
 
-    /*
-     * This vid is vid of current view router interface, it may or may not be
-     * equal to temporaryVid, but we need to this step to not guess vids.
-     */
+        for (auto vid: ap.second->getOidListFromAttribute())
+        {
+            types += std::to_string(getObjectTypeFromVid(vid)) + ",";
+        }
 
-    sai_object_id_t currentRouterInterfaceVid = currentIt->second;
+        values[ap.first] = "[" + types + "]";
+    }
 
-    ne.rif_id = currentRouterInterfaceVid;
+    for (const auto &v: values)
+    {
+        sig += std::to_string(v.first) + "=" + v.second + ";";
+    }
 
-    std::string str_neighbor_entry = sai_serialize_neighbor_entry(ne);
+    return sig;
+}/*}}}*/
 
-    /*
-     * Now when we have serialized neighbor entry with temporary rif_if VID
-     * replaced to current rif_id VID we can do dictionary lookup for neighbor.
-     */
+/**
+ * @brief Get sorted referrer signatures of given object.
+ *
+ * Signatures are cached in view for entire matching pass, since the same
+ * current object is usually evaluated as candidate for many temporary
+ * objects.
+ */
+const std::vector<std::string>& getReferrerSignatures(/*{{{*/
+        _In_ const AsicView &view,
+        _In_ const std::shared_ptr<SaiObj> &obj)
+{
+    SWSS_LOG_ENTER();
 
-    auto currentNeighborIt = currentView.soNeighbors.find(str_neighbor_entry);
+    sai_object_id_t vid = obj->getVid();
 
-    if (currentNeighborIt == currentView.soNeighbors.end())
-    {
-        SWSS_LOG_DEBUG("unable to find neighbor entry %s in current asic view", str_neighbor_entry.c_str());
+    auto it = view.referrerSignatures.find(vid);
 
-        return nullptr;
+    if (it != view.referrerSignatures.end())
+    {
+        return it->second;
     }
 
-    /*
-     * We found the same neighbor entry in current view! Just one extra check
-     * of object status if it's not processed yet.
-     */
-
-    auto currentNeighborObj = currentNeighborIt->second;
+    std::vector<std::string> signatures;
 
-    if (currentNeighborObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    for (const auto &ref: view.getReverseReferences(vid))
     {
-        return currentNeighborObj;
+        signatures.push_back(getReferrerSignature(ref.first, ref.second));
     }
 
-    /*
-     * If we are here, that means this neighbor was already processed, which
-     * can indicate a bug or somehow duplicated entries.
-     */
-
-    SWSS_LOG_ERROR("found neighbor entry %s in current view, but it status is %d, FATAL",
-            str_neighbor_entry.c_str(), currentNeighborObj->getObjectStatus());
+    std::sort(signatures.begin(), signatures.end());
 
-    throw std::runtime_error("found neighbor entry in current view, but it status was processed");
+    return view.referrerSignatures[vid] = std::move(signatures);
 }/*}}}*/
 
-std::shared_ptr<SaiObj> findCurrentBestMatchForRouteEntry(/*{{{*/
+/**
+ * @brief Get estimated number of operations to bring current object to
+ * temporary object state.
+ *
+ * Each attribute which is different or missing on current object will
+ * require set, and each attribute present only on current object needs to be
+ * brought to default value. Each referrer of current object that has no
+ * corresponding referrer of temporary object (and the other way around) will
+ * need to be updated or recreated, since it will point to other object.
+ */
+size_t getEstimatedTransitionCost(/*{{{*/
         _In_ const AsicView &currentView,
         _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+        _In_ const std::shared_ptr<SaiObj> &currentObj,
+        _In_ const std::shared_ptr<SaiObj> &temporaryObj,
+        _In_ const std::vector<std::string> &temporarySignatures)
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * For Route we don't need to iterate via all current
-     * routes, we can do dictionary lookup, but we need
-     * to do smart trick, since temporary object was processed
-     * we just need to check whether VID in route_entry
-     * struct is matched/final and it has RID assigned from
-     * current view. If, RID exists, we can use that RID
-     * to get VID of current view, exchange in route_entry
-     * struct and do dictionary lookup on serialized route_entry.
-     *
-     * With this approach for many entries this is the quickest
-     * possible way. In case when RID don't exist, that means
-     * we have invalid route entry, so we must return null.
-     */
-
-    /*
-     * Make a copy here to not destroy object data, later
-     * on this data should be read only.
-     */
-
-    sai_unicast_route_entry_t re = temporaryObj->meta_key.key.route_entry;
-
-    sai_object_id_t temporaryVirtualRouterVid = re.vr_id;
-
-    auto temporaryIt = temporaryView.vidToRid.find(temporaryVirtualRouterVid);
+    size_t cost = 0;
 
-    if (temporaryIt == temporaryView.vidToRid.end())
+    for (const auto &ap: temporaryObj->getAllAttributes())
     {
-        /*
-         * RID for virtual router in route_entry struct was not assigned,
-         * so we didn't matched it in previous processing virtual routers, or
-         * virtual router will be created later on. This mean we can't
-         * match route because even if all attributes are matchind, RID in
-         * route struct after create will not match so at the end of
-         * processing current route will need to be destroyed and new one
-         * needs to be created.
-         */
+        if (!hasEqualAttribute(currentView, temporaryView, currentObj, temporaryObj, ap.first))
+        {
+            cost++;
+        }
+    }
 
-        return nullptr;
+    for (const auto &ap: currentObj->getAllAttributes())
+    {
+        if (!temporaryObj->hasAttr(ap.first))
+        {
+            cost++;
+        }
     }
 
-    /*
-     * We found RID which should be in current view, now we need to
-     * get current view VID to replace is in our route_entry copy.
-     */
+    const auto &currentSignatures = getReferrerSignatures(currentView, currentObj);
 
-    sai_object_id_t temporaryRid = temporaryIt->second;
+    std::vector<std::string> diff;
 
-    auto currentIt = currentView.ridToVid.find(temporaryRid);
+    std::set_symmetric_difference(
+            currentSignatures.begin(), currentSignatures.end(),
+            temporarySignatures.begin(), temporarySignatures.end(),
+            std::back_inserter(diff));
 
-    if (currentIt == currentView.ridToVid.end())
-    {
-        /*
-         * This is just sanity check, should never happen.
-         */
+    return cost + diff.size();
+}/*}}}*/
 
-        SWSS_LOG_ERROR("found tempoary RID 0x%lx but current VID don't exists, FATAL", temporaryRid);
+/**
+ * @brief Select best candidate using object graph.
+ *
+ * All candidates have the same number of equal attributes, so we select the
+ * one which will need the smallest number of operations, taking into account
+ * objects which are referencing candidate, for example routes pointing to
+ * next hop or neighbors on router interface. If there are still multiple
+ * candidates with the same cost, one is selected at random.
+ */
+std::shared_ptr<SaiObj> findCurrentBestMatchForGenericObjectUsingGraph(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> &temporaryObj,
+        _In_ const std::vector<sai_object_compare_info_t> &candidateObjects)
+{
+    SWSS_LOG_ENTER();
 
-        throw std::runtime_error("found temporary RID but current VID don't exists, FATAL");
-    }
+    const auto &temporarySignatures = getReferrerSignatures(temporaryView, temporaryObj);
 
-    /*
-     * This vid is vid of current view virtual router, it may or may not be
-     * equal to temporaryVid, but we need to this step to not guess vids.
-     */
+    std::vector<size_t> costs;
 
-    sai_object_id_t currentVirtualRouterVid = currentIt->second;
+    size_t minCost = SIZE_MAX;
+    size_t totalCost = 0;
 
-    re.vr_id = currentVirtualRouterVid;
+    for (const auto &c: candidateObjects)
+    {
+        size_t cost = getEstimatedTransitionCost(currentView, temporaryView, c.obj, temporaryObj, temporarySignatures);
 
-    std::string str_route_entry = sai_serialize_route_entry(re);
+        costs.push_back(cost);
 
-    /*
-     * Now when we have serialized route entry with temporary vr_id VID
-     * replaced to current vr_id VID we can do dictionary lookup for route.
-     */
-    auto currentRouteIt = currentView.soRoutes.find(str_route_entry);
+        minCost = std::min(minCost, cost);
+        totalCost += cost;
+    }
 
-    if (currentRouteIt == currentView.soRoutes.end())
-    {
-        SWSS_LOG_DEBUG("unable to find route entry %s in current asic view", str_route_entry.c_str());
+    std::vector<sai_object_compare_info_t> best;
 
-        return nullptr;
+    for (size_t idx = 0; idx < candidateObjects.size(); ++idx)
+    {
+        if (costs[idx] == minCost)
+        {
+            best.push_back(candidateObjects[idx]);
+        }
     }
 
-    /*
-     * We found the same route entry in current view! Just one extra check
-     * of object status if it's not processed yet.
-     */
+    double randomCost = (double)totalCost / (double)candidateObjects.size();
 
-    auto currentRouteObj = currentRouteIt->second;
+    g_heuristicSelections++;
+    g_heuristicSelectedCost += minCost;
+    g_heuristicRandomCost += randomCost;
 
-    if (currentRouteObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    SWSS_LOG_INFO("%s: %zu candidates, %zu with lowest cost %zu, random selection cost %.1f",
+            temporaryObj->str_object_id.c_str(),
+            candidateObjects.size(),
+            best.size(),
+            minCost,
+            randomCost);
+
+    if (best.size() == 1)
     {
-        return currentRouteObj;
+        return best.at(0).obj;
     }
 
-    /*
-     * If we are here, that means this route was already processed, which
-     * can indicate a bug or somehow duplicated entries.
-     */
-
-    SWSS_LOG_ERROR("found route entry %s in current view, but it status is %d, FATAL",
-            str_route_entry.c_str(), currentRouteObj->getObjectStatus());
-
-    throw std::runtime_error("found route entry in current view, but it status was processed");
+    return selectRandomCandidate(best);
 }/*}}}*/
 
-std::shared_ptr<SaiObj> findCurrentBestMatchForSwitch(/*{{{*/
+std::shared_ptr<SaiObj> findCurrentBestMatchForGenericObjectUsingHeuristic(/*{{{*/
         _In_ const AsicView &currentView,
         _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+        _In_ const std::shared_ptr<SaiObj> temporaryObj,
+        _In_ const std::vector<sai_object_compare_info_t> &candidateObjects)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * On compare logic we checked that we have one switch
-     * so we can just get first.
+     * This method will select heuristic method for best current object
+     * matching for given temporary object based on object type.  If heuristic
+     * don't exists yet, then current object will be choosen at random.
      */
 
-    auto currentSwitchIt = currentView.soSwitches.begin();
-
-    if (currentSwitchIt == currentView.soSwitches.end())
-    {
-        SWSS_LOG_DEBUG("unable to find switch object in current view");
-
-        return nullptr;
-    }
+    sai_object_type_t object_type = temporaryObj->getObjectType();
 
     /*
-     * We found switch object in current view! Just one extra check
-     * of object status if it's not processed yet.
+     * TODO later on we can have a list of heuristic function pointers since
+     * all signatures will be the same.
      */
 
-    auto currentSwitchObj = currentSwitchIt->second;
-
-    if (currentSwitchObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    switch (object_type)
     {
-        return currentSwitchObj;
-    }
+        case SAI_OBJECT_TYPE_NEXT_HOP:
+        case SAI_OBJECT_TYPE_NEXT_HOP_GROUP:
+        case SAI_OBJECT_TYPE_ROUTER_INTERFACE:
+        case SAI_OBJECT_TYPE_ACL_ENTRY:
+        case SAI_OBJECT_TYPE_SCHEDULER:
 
-    /*
-     * If we are here, that means this switch was already processed, which
-     * can indicate a bug or somehow duplicated entries.
-     */
+            return findCurrentBestMatchForGenericObjectUsingGraph(currentView, temporaryView, temporaryObj, candidateObjects);
 
-    SWSS_LOG_ERROR("found switch object %s in current view, but it status is %d, FATAL",
-            currentSwitchObj->str_object_id.c_str(), currentSwitchObj->getObjectStatus());
+        default:
 
-    throw std::runtime_error("found switch object in current view, but it status was processed");
+            SWSS_LOG_WARN("%s is not supported for heuristic, will select best match object at random",
+                    sai_serialize_object_type(object_type).c_str());
+
+            break;
+    }
+
+    return selectRandomCandidate(candidateObjects);
 }/*}}}*/
 
-std::shared_ptr<SaiObj> findCurrentBestMatchForFdbEntry(/*{{{*/
+/**
+ * @brief Get candidate current objects for given temporary object
+ *
+ * For each of given not processed current objects compute number of equal
+ * attributes with temporary object, and disqualify objects which differ on
+ * CREATE_ONLY attribute.
+ *
+ * This function don't modify any of the views, so it's safe to call it
+ * concurrently for different temporary objects as long as no other thread is
+ * modifying views at the same time.
+ */
+std::vector<sai_object_compare_info_t> getCandidateObjectsForGenericObject(/*{{{*/
         _In_ const AsicView &currentView,
         _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+        _In_ const std::shared_ptr<SaiObj> &temporaryObj,
+        _In_ const std::vector<std::shared_ptr<SaiObj>> &notProcessedObjects)
 {
     SWSS_LOG_ENTER();
 
+    const auto attrs = temporaryObj->getAllAttributes();
+
     /*
-     * For fdb we don't need to iterate via all current
-     * fdbs, we can do dictionary lookup, we don't even
-     * do OID translation since fdb entry don't contain
-     * any oids, so simple direct lookup is fine. This
-     * will change in SAI 1.0 since oids are added there.
+     * Complexity here is O((n^2)*m) since we iterate via all not processed
+     * objects, then we iterate through all present attributes.  N is squared
+     * since for given object type we iterate via entire list for each object,
+     * this can be optimized a little bit inside AsicView class.
      */
 
-    sai_fdb_entry_t fe = temporaryObj->meta_key.key.fdb_entry;
+    SWSS_LOG_INFO("not processed objects for %s: %zu, attrs: %zu",
+            temporaryObj->getStrObjectType().c_str(),
+            notProcessedObjects.size(),
+            attrs.size());
 
-    std::string str_fdb_entry = sai_serialize_fdb_entry(fe);
+    std::vector<sai_object_compare_info_t> candidateObjects;
 
-    /*
-     * Now when we have serialized fdb entry can do dictionary lookup for fdb.
-     */
+    for (const auto &currentObj: notProcessedObjects)
+    {
+        sai_object_compare_info_t soci = { 0, currentObj };
 
-    auto currentFdbIt = currentView.soFdbs.find(str_fdb_entry);
+        bool has_different_create_only_attr = false;
 
-    if (currentFdbIt == currentView.soFdbs.end())
-    {
-        SWSS_LOG_DEBUG("unable to find fdb entry %s in current asic view", str_fdb_entry.c_str());
+        for (const auto &attr: attrs)
+        {
+            sai_attr_id_t attrId = attr.first;
 
-        return nullptr;
-    }
+            /*
+             * Function hasEqualAttribute check if attribute exists on both objects.
+             */
 
-    /*
-     * We found the same fdb entry in current view! Just one extra check
-     * of object status if it's not processed yet.
-     */
+            if (hasEqualAttribute(currentView, temporaryView, currentObj, temporaryObj, attrId))
+            {
+                soci.equal_attributes++;
 
-    auto currentFdbObj = currentFdbIt->second;
+                SWSS_LOG_DEBUG("ob equal %s %s, %s: %s",
+                        temporaryObj->str_object_id.c_str(),
+                        currentObj->str_object_id.c_str(),
+                        attr.second->getStrAttrId().c_str(),
+                        attr.second->getStrAttrValue().c_str());
+            }
+            else
+            {
+                SWSS_LOG_DEBUG("ob not equal %s %s, %s: %s",
+                        temporaryObj->str_object_id.c_str(),
+                        currentObj->str_object_id.c_str(),
+                        attr.second->getStrAttrId().c_str(),
+                        attr.second->getStrAttrValue().c_str());
 
-    if (currentFdbObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
-    {
-        return currentFdbObj;
-    }
+                /*
+                 * Function hasEqualAttribute returns true only when both
+                 * attributes are existing and both are equal, so here it
+                 * returned false, so it may mean 2 things:
+                 *
+                 * - attribute don't exists in current view, or
+                 * - attributes are different
+                 *
+                 * If we check if attribute also exists in current view and has
+                 * CREATE_ONLY flag then attributes are different and we
+                 * disqualify this object since new temporary object needs to
+                 * pass new differetn attribute with CREATE_ONLY flag.
+                 *
+                 * Case when attribute don't exists is much more complicated
+                 * since it maybe conditional and have default value, we will
+                 * do that check when we select best match.
+                 */
 
-    /*
-     * If we are here, that means this fdb was already processed, which
-     * can indicate a bug or somehow duplicated entries.
-     */
+                /*
+                 * Get attribute metadata to see if contains CREATE_ONLY flag.
+                 */
 
-    SWSS_LOG_ERROR("found fdb entry %s in current view, but it status is %d, FATAL",
-            str_fdb_entry.c_str(), currentFdbObj->getObjectStatus() );
+                const sai_attr_metadata_t* meta = attr.second->getAttrMetadata();
 
-    throw std::runtime_error("found fdb entry in current view, but it status was processed");
+                if (HAS_FLAG_CREATE_ONLY(meta->flags) && currentObj->hasAttr(attrId))
+                {
+                    has_different_create_only_attr = true;
+
+                    SWSS_LOG_INFO("obj has not equal create only attributes %s", temporaryObj->str_object_id.c_str());
+
+                    /*
+                     * In this case there is no need to compare other
+                     * attributes since we won't be able to update them anyway.
+                     */
+
+                    break;
+                }
+            }
+        }
+
+        if (has_different_create_only_attr)
+        {
+            /*
+             * Those objects differs with attribute which is marked as
+             * CREATE_ONLY so we will not be able to update current if
+             * necessary using SET operations.
+             */
+
+            continue;
+        }
+
+        candidateObjects.push_back(soci);
+    }
+
+    return candidateObjects;
 }/*}}}*/
 
-std::shared_ptr<SaiObj> findCurrentBestMatchForTrap(/*{{{*/
+/*
+ * Candidate lists precomputed by worker threads for temporary objects (by
+ * temporary VID), see precomputeCandidateObjects.
+ */
+
+std::unordered_map<sai_object_id_t, std::vector<sai_object_compare_info_t>> g_precomputedCandidates;
+
+std::shared_ptr<SaiObj> findCurrentBestMatchForGenericObject(/*{{{*/
         _In_ const AsicView &currentView,
         _In_ const AsicView &temporaryView,
         _In_ const std::shared_ptr<SaiObj> temporaryObj)
@@ -2397,591 +2891,842 @@ std::shared_ptr<SaiObj> findCurrentBestMatchForTrap(/*{{{*/
     SWSS_LOG_ENTER();
 
     /*
-     * For traps in 0.9.4 traps are enum values, and we have
-     * their exact names so we can do direct dictionary lookup.
+     * This method will try to find current best match object for a given
+     * temporary object. This method should be used only on object id objects,
+     * since non object id structures also contains object id which in this
+     * case are not take into account. Besides for objects like FDB, ROUTE or
+     * NEIGHBOR we can do quick hash lookup instead of looping for all objects
+     * where there can be a lot of them.
+     *
+     * Special case here we can add later on is VLAN, since we can have a lot
+     * of VLANS so instead looking via all of them we just need to make sure
+     * that we will create reverse map via VLAN_ID KEY and then we can make
+     * hash lookup to see if such vlan is present.
      */
 
-    sai_hostif_trap_id_t trap_id = temporaryObj->meta_key.key.trap_id;
-
-    std::string str_trap_id = sai_serialize_hostif_trap_id(trap_id);
-
     /*
-     * Now when we have serialized trap id, we can do dictionary lookup for trap.
+     * Since our system design is to restart orch agend withourt restarting
+     * syncd and recreating objects and reassign new VIDs created inside orch
+     * agent, in our most cases values of objects will not change.  This will
+     * cause to make our comparison logic here faily simple:
+     *
+     * Find all objects that have the same equal attributes on current object
+     * and choose the one with the most attributes that match current and
+     * temporary object.
+     *
+     * This seems simple, but there are a lot of cases that needs to be taken
+     * into account:
+     *
+     * - what if we have several objects with the same number of equal
+     *   attributes then we can choose at random or implement some heuristic
+     *   logic to try figure out which of those objects will be the best, even
+     *   then if we choose wrong object, then there can be a lot of removes and
+     *   recreating objects on the ASIC
+     *
+     * - what if in temporary object CREATE_ONLY attributes don't match but
+     *   many of CREATE_AND_SET are the same, in that case we can choose object
+     *   with most matching attributes, but object will still needs to be
+     *   destroyed becasuse we need to set new CREATE_ONLY attributes
+     *
+     * - there are also cases with default values of attributes where attribute
+     *   is present only in one object but on other one it have defaule value
+     *   and this default value is the same as the one in attribute
+     *
+     * - another case is for objects that needs to be removed since there are
+     *   no corresponding objects in remporary view, but they can't be removed,
+     *   objects like PORT or default QUEUEs or INGRESS_PRIORITY_GROUPs, then
+     *   we need to bring their current set values to default ones, which also
+     *   can be challenging since we need to know prevous default value and it
+     *   could be assigned by switch internally, like default MAC addres or
+     *   default TRAP group etc
+     *
+     * - there is also interesting case with KEYs attributes which when
+     *   doing remove/create they needs to be removed first since
+     *   we can't have 2 identical cases
+     *
+     * There are alot of aspects to consider here, in here we will cake only
+     * couple of them in consideration, and other will be taken care inside
+     * processObjectForViewTransition method which will handle all other cases
+     * not mentioned here.
      */
 
-    auto currentTrapIt = currentView.soTraps.find(str_trap_id);
+    /*
+     * First check if object is oid object, if yes, chek if it status is
+     * matched.
+     */
 
-    if (currentTrapIt == currentView.soTraps.end())
+    if (!temporaryObj->oidObject)
     {
-        SWSS_LOG_WARN("unable to find trap id %s in current asic view", str_trap_id.c_str());
+        SWSS_LOG_ERROR("non object id %s is used in generic method, please implement special case, FIXME", temporaryObj->getStrObjectType().c_str());
 
-        return nullptr;
+        throw std::runtime_error("non object id is used in generic method, implement special case, FIXME");
     }
 
     /*
-     * We found the same trap id in current view! Just one extra check
-     * of object status if it's not processed yet.
+     * Get not processed objects of temporary object type, and all attributes
+     * that are set on that object. This function should be used only on oid
+     * object ids, since for non object id findinf best match is based on
+     * struct entry of object id.
      */
 
-    auto currentTrapObj = currentTrapIt->second;
+    sai_object_type_t object_type = temporaryObj->getObjectType();
 
-    if (currentTrapObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
-    {
-        return currentTrapObj;
-    }
+    const auto notProcessedObjects = currentView.getNotProcessedObjectsByObjectType(object_type);
 
-    /*
-     * If we are here, that means this trap was already processed, which
-     * can indicate a bug or somehow duplicated entries.
-     */
+    std::vector<sai_object_compare_info_t> candidateObjects;
 
-    SWSS_LOG_ERROR("found trap id %s in current view, but it status is %d, FATAL",
-            str_trap_id.c_str(), currentTrapObj->getObjectStatus());
+    auto cacheIt = g_precomputedCandidates.find(temporaryObj->getVid());
 
-    throw std::runtime_error("found trap id in current view, but it status was processed");
-}/*}}}*/
+    if (cacheIt != g_precomputedCandidates.end())
+    {
+        /*
+         * Candidates were computed by worker threads at the beginning of
+         * object type layer. Some of them could be processed since then by
+         * previous temporary objects, so we take only objects that are still
+         * not processed, and we take them in current not processed order, so
+         * candidate list is identical to the one computed serially here.
+         *
+         * Not processed objects which are missing in precomputed list were
+         * disqualified, since object status can only change from not
+         * processed to other state.
+         */
 
-std::shared_ptr<SaiObj> findCurrentBestMatchForVlan(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> temporaryObj)
-{
-    SWSS_LOG_ENTER();
+        std::unordered_map<const SaiObj*, size_t> equalAttributes;
 
-    /*
-     * For vlan in 0.9.4 vlans are numbers values, and we have
-     * their exact values so we can do direct dictionary lookup.
-     */
+        for (const auto &candidate: cacheIt->second)
+        {
+            equalAttributes[candidate.obj.get()] = candidate.equal_attributes;
+        }
 
-    sai_vlan_id_t vlan_id = temporaryObj->meta_key.key.vlan_id;
+        for (const auto &currentObj: notProcessedObjects)
+        {
+            auto it = equalAttributes.find(currentObj.get());
 
-    std::string str_vlan_id = sai_serialize_vlan_id(vlan_id);
+            if (it != equalAttributes.end())
+            {
+                candidateObjects.push_back({ it->second, currentObj });
+            }
+        }
 
-    /*
-     * Now when we have serialized vlan id, we can do dictionary lookup for vlan.
-     */
+        g_precomputedCandidates.erase(cacheIt);
+    }
+    else
+    {
+        candidateObjects = getCandidateObjectsForGenericObject(currentView, temporaryView, temporaryObj, notProcessedObjects);
+    }
 
-    auto currentVlanIt = currentView.soVlans.find(str_vlan_id);
+    SWSS_LOG_INFO("number candidate objects for %s is %zu", temporaryObj->str_object_id.c_str(), candidateObjects.size());
 
-    if (currentVlanIt == currentView.soVlans.end())
+    if (candidateObjects.size() == 0)
     {
-        SWSS_LOG_DEBUG("unable to find vlan id %s in current asic view", str_vlan_id.c_str());
+        /*
+         * We didn't found any object.
+         */
 
         return nullptr;
     }
 
+    if (candidateObjects.size() == 1)
+    {
+        /*
+         * We found only one object so it must be it.
+         */
+
+        return candidateObjects.begin()->obj;
+    }
+
     /*
-     * We found the same vlan id in current view! Just one extra check
-     * of object status if it's not processed yet.
+     * If we have more than 1 object matched actually more preffered
+     * object would be the object with most CREATE_ONLY attributes matching
+     * since that will reduce risk of removind and recreateing that object in
+     * current view.
      */
 
-    auto currentVlanObj = currentVlanIt->second;
+    /*
+     * Sort candidate objects by equal attributes in descending order, we know
+     * here that we have at least 2 candidates.
+     *
+     * NOTE: maybe at this point we should be using heuristics?
+     */
 
-    if (currentVlanObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    std::sort(candidateObjects.begin(), candidateObjects.end(), compareByEqualAttributes);
+
+    if (candidateObjects[0].equal_attributes > candidateObjects[1].equal_attributes)
     {
-        return currentVlanObj;
+        /*
+         * We have only 1 object with the greatest number of equal attributes
+         * lets choose that object as our best match.
+         */
+
+        return candidateObjects.begin()->obj;
     }
 
     /*
-     * If we are here, that means this vlan was already processed, which
-     * can indicate a bug or somehow duplicated entries.
+     * In here there are at least 2 current objects that have the same
+     * number of equal attributes. In here we can do two things
+     *
+     * - select object at random, or
+     * - use heuristic/smart lookup for inside graph
+     *
+     * Smart lookup would be for example searching wheter current object is
+     * pointing to the same PORT as temporary object (since ports are matched
+     * at the beginning). For different types of objects we need different type
+     * of logic and we can start adding that when needed and when missing we
+     * will just choose at random possiblu causing some remove/recreate but
+     * this logic is not perfect at this point.
      */
 
-    SWSS_LOG_ERROR("found vlan id %s in current view, but it status is %d, FATAL",
-            str_vlan_id.c_str(), currentVlanObj->getObjectStatus());
+    /*
+     * Lets also remove candidates with less equal attributes
+     */
 
-    throw std::runtime_error("found vlan id in current view, but it status was processed");
+    size_t previousCandidates = candidateObjects.size();
+
+    size_t equalAttributes = candidateObjects[0].equal_attributes;
+
+    auto endIt = std::remove_if(candidateObjects.begin(), candidateObjects.end(),
+            [equalAttributes](const sai_object_compare_info_t &candidate)
+            { return candidate.equal_attributes != equalAttributes; });
+
+    candidateObjects.erase(endIt, candidateObjects.end());
+
+    SWSS_LOG_INFO("multiple candidates found (%zu of %zu) for %s, will use heuristic",
+            candidateObjects.size(),
+            previousCandidates,
+            temporaryObj->str_object_id.c_str());
+
+    return findCurrentBestMatchForGenericObjectUsingHeuristic(
+            currentView,
+            temporaryView,
+            temporaryObj,
+            candidateObjects);
 }/*}}}*/
 
-std::shared_ptr<SaiObj> findCurrentBestMatch(/*{{{*/
+std::shared_ptr<SaiObj> findCurrentBestMatchForNeighborEntry(/*{{{*/
         _In_ const AsicView &currentView,
         _In_ const AsicView &temporaryView,
         _In_ const std::shared_ptr<SaiObj> temporaryObj)
 {
     SWSS_LOG_ENTER();
 
-    if (temporaryObj->oidObject)
+    /*
+     * For Neighbor we don't need to iterate via all current
+     * neighbors, we can do dictionary lookup, but we need
+     * to do smart trick, since temporary object was processed
+     * we just need to check whether VID in neighbor_entry
+     * struct is matched/final and it has RID assigned from
+     * current view. If, RID exists, we can use that RID
+     * to get VID of current view, exchange in neighbor_entry
+     * struct and do dictionary lookup on serialized neighbor_entry.
+     *
+     * With this approach for many entries this is the quickest
+     * possible way. In case when RID don't exist, that means
+     * we have invalid neighbor entry, so we must return null.
+     */
+
+    /*
+     * Make a copy here to not destroy object data, later
+     * on this data should be read only.
+     */
+
+    sai_neighbor_entry_t ne = temporaryObj->meta_key.key.neighbor_entry;
+
+    sai_object_id_t temporaryRouterInterfaceVid = ne.rif_id;
+
+    auto temporaryIt = temporaryView.vidToRid.find(temporaryRouterInterfaceVid);
+
+    if (temporaryIt == temporaryView.vidToRid.end())
     {
         /*
-         * This approach will not work for neighbor but it could work for
-         * routes in SAI 0.9.4 with default virtual router. But make no sense
-         * to invest time since in SAI 1.0 it will not work for routes as well.
+         * RID for router interface in neighbor_entry struct was not assigned,
+         * so we didn't matched it in previous processing router interfaces, or
+         * router interface will be created later on. This mean we can't
+         * match neighbor because even if all attributes are matchind, RID in
+         * neighbor struct after create will not match so at the end of
+         * processing current neighbor will need to be destroyed and new one
+         * needs to be created.
          */
 
-        if (temporaryObj->getObjectStatus() == SAI_OBJECT_STATUS_MATCHED)
-        {
-            /*
-             * Object status is matched so current and temp VID are the same so
-             * we can just take object directly.
-             */
-
-            SWSS_LOG_INFO("found best match for %s %s since object status is MATCHED",
-                    temporaryObj->str_object_type.c_str(),
-                    temporaryObj->str_object_id.c_str());
-
-            return currentView.oOids.at(temporaryObj->getVid());
-        }
+        return nullptr;
     }
 
     /*
-     * NOTE: later on best match find can be done based on present CREATE_ONLY
-     * attributes or on most matched CREATE_AND_SET attributes.
+     * We found RID which should be in current view, now we need to
+     * get current view VID to replace is in our neighbor_entry copy.
      */
 
-    switch (temporaryObj->getObjectType())
+    sai_object_id_t temporaryRid = temporaryIt->second;
+
+    auto currentIt = currentView.ridToVid.find(temporaryRid);
+
+    if (currentIt == currentView.ridToVid.end())
     {
         /*
-         * Non object id cases
+         * This is just sanity check, should never happen.
          */
 
-        case SAI_OBJECT_TYPE_NEIGHBOR:
-            return findCurrentBestMatchForNeighborEntry(currentView, temporaryView, temporaryObj);
+        SWSS_LOG_ERROR("found tempoary RID 0x%lx but current VID don't exists, FATAL", temporaryRid);
 
-        case SAI_OBJECT_TYPE_ROUTE:
-            return findCurrentBestMatchForRouteEntry(currentView, temporaryView, temporaryObj);
+        throw std::runtime_error("found temporary RID but current VID don't exists, FATAL");
+    }
 
-        case SAI_OBJECT_TYPE_FDB:
-            return findCurrentBestMatchForFdbEntry(currentView, temporaryView, temporaryObj);
+    /*
+     * This vid is vid of current view router interface, it may or may not be
+     * equal to temporaryVid, but we need to this step to not guess vids.
+     */
 
-        case SAI_OBJECT_TYPE_SWITCH:
-            return findCurrentBestMatchForSwitch(currentView, temporaryView, temporaryObj);
+    sai_object_id_t currentRouterInterfaceVid = currentIt->second;
 
-        case SAI_OBJECT_TYPE_TRAP:
-            return findCurrentBestMatchForTrap(currentView, temporaryView, temporaryObj);
+    ne.rif_id = currentRouterInterfaceVid;
 
-        case SAI_OBJECT_TYPE_VLAN:
-            return findCurrentBestMatchForVlan(currentView, temporaryView, temporaryObj);
+    /*
+     * Now when we have neighbor entry with temporary rif_if VID replaced to
+     * current rif_id VID we can do dictionary lookup for neighbor.
+     */
 
-        default:
+    auto currentNeighborIt = currentView.soNeighbors.find(ne);
 
-            /*
-             * Here we support only object id object types.
-             */
+    if (currentNeighborIt == currentView.soNeighbors.end())
+    {
+        SWSS_LOG_DEBUG("unable to find neighbor entry %s in current asic view", temporaryObj->str_object_id.c_str());
 
-            return findCurrentBestMatchForGenericObject(currentView, temporaryView, temporaryObj);
+        return nullptr;
     }
-}/*}}}*/
 
-void processObjectForViewTransition(
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView,
-        _In_ std::shared_ptr<SaiObj> temporayObj);
+    /*
+     * We found the same neighbor entry in current view! Just one extra check
+     * of object status if it's not processed yet.
+     */
 
-/**
- * @brief Process object attributes for view transition
- *
- * Since each object can contain attributes (or non id struct object can
- * contain oids inside struct) they need to be processed first recursivly and
- * they need to be in FINAL state before processing temporary view further.
- * This processing may result in changes in current view like removing and
- * recreateing or adding new objects depends on transitions.
- */
-void procesObjectAttributesForViewTransition(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView,
-        _In_ std::shared_ptr<SaiObj> temporaryObj)
-{
-    SWSS_LOG_ENTER();
+    auto currentNeighborObj = currentNeighborIt->second;
 
-    SWSS_LOG_INFO("%s %s", temporaryObj->str_object_type.c_str(), temporaryObj->str_object_id.c_str());
+    if (currentNeighborObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    {
+        return currentNeighborObj;
+    }
 
     /*
-     * First we need to make sure if all attributes of this temporary object
-     * are in FINAL or MATCHED state, then we can process this object and find
-     * best match in current asic view.
+     * If we are here, that means this neighbor was already processed, which
+     * can indicate a bug or somehow duplicated entries.
      */
 
-    for (auto &at: temporaryObj->getAllAttributes())
-    {
-        auto &attribute = at.second;
-
-        SWSS_LOG_INFO("attr %s", attribute->getStrAttrId().c_str());
+    SWSS_LOG_ERROR("found neighbor entry %s in current view, but it status is %d, FATAL",
+            currentNeighborObj->str_object_id.c_str(), currentNeighborObj->getObjectStatus());
 
-        // for each object id in attributes go recursively to match those objects
+    throw std::runtime_error("found neighbor entry in current view, but it status was processed");
+}/*}}}*/
 
-        for (auto vid: attribute->getOidListFromAttribute())
-        {
-            if (vid == SAI_NULL_OBJECT_ID)
-            {
-                continue;
-            }
+std::shared_ptr<SaiObj> findCurrentBestMatchForRouteEntry(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+{
+    SWSS_LOG_ENTER();
 
-            SWSS_LOG_INFO("- processing attr VID 0x%lx", vid);
+    /*
+     * For Route we don't need to iterate via all current
+     * routes, we can do dictionary lookup, but we need
+     * to do smart trick, since temporary object was processed
+     * we just need to check whether VID in route_entry
+     * struct is matched/final and it has RID assigned from
+     * current view. If, RID exists, we can use that RID
+     * to get VID of current view, exchange in route_entry
+     * struct and do dictionary lookup on serialized route_entry.
+     *
+     * With this approach for many entries this is the quickest
+     * possible way. In case when RID don't exist, that means
+     * we have invalid route entry, so we must return null.
+     */
 
-            auto tempParent = temporaryView.oOids.at(vid);
+    /*
+     * Make a copy here to not destroy object data, later
+     * on this data should be read only.
+     */
 
-            processObjectForViewTransition(currentView, temporaryView, tempParent); // recursion
+    sai_unicast_route_entry_t re = temporaryObj->meta_key.key.route_entry;
 
-            /*
-             * Temporary object here is never changed, even if we do recursion
-             * here all that could been removed are objects in current view
-             * tree so we don't need to worry about any temporary object
-             * removal.
-             */
-        }
-    }
+    sai_object_id_t temporaryVirtualRouterVid = re.vr_id;
 
-    if (temporaryObj->oidObject)
+    auto temporaryIt = temporaryView.vidToRid.find(temporaryVirtualRouterVid);
+
+    if (temporaryIt == temporaryView.vidToRid.end())
     {
-        return;
+        /*
+         * RID for virtual router in route_entry struct was not assigned,
+         * so we didn't matched it in previous processing virtual routers, or
+         * virtual router will be created later on. This mean we can't
+         * match route because even if all attributes are matchind, RID in
+         * route struct after create will not match so at the end of
+         * processing current route will need to be destroyed and new one
+         * needs to be created.
+         */
+
+        return nullptr;
     }
 
     /*
-     * For non object id types like NEIGHBOR or ROUTE they have object id
-     * inside object struct entry, they also need to be processed, in SAI 1.0
-     * this can be automated since we have metadata for those structs.
+     * We found RID which should be in current view, now we need to
+     * get current view VID to replace is in our route_entry copy.
      */
 
-    switch (temporaryObj->getObjectType())
-    {
-        case SAI_OBJECT_TYPE_NEIGHBOR:
+    sai_object_id_t temporaryRid = temporaryIt->second;
 
-            {
-                sai_object_id_t vid = temporaryObj->meta_key.key.neighbor_entry.rif_id;
+    auto currentIt = currentView.ridToVid.find(temporaryRid);
 
-                auto structObject = temporaryView.oOids.at(vid);
+    if (currentIt == currentView.ridToVid.end())
+    {
+        /*
+         * This is just sanity check, should never happen.
+         */
 
-                SWSS_LOG_INFO("- processing NEIGHBOR rif_id VID 0x%lx", vid);
+        SWSS_LOG_ERROR("found tempoary RID 0x%lx but current VID don't exists, FATAL", temporaryRid);
 
-                processObjectForViewTransition(currentView, temporaryView, structObject); // recursion
-            }
+        throw std::runtime_error("found temporary RID but current VID don't exists, FATAL");
+    }
 
-            break;
+    /*
+     * This vid is vid of current view virtual router, it may or may not be
+     * equal to temporaryVid, but we need to this step to not guess vids.
+     */
 
-        case SAI_OBJECT_TYPE_ROUTE:
+    sai_object_id_t currentVirtualRouterVid = currentIt->second;
 
-            {
-                sai_object_id_t vid = temporaryObj->meta_key.key.route_entry.vr_id;
+    re.vr_id = currentVirtualRouterVid;
 
-                auto structObject = temporaryView.oOids.at(vid);
+    /*
+     * Now when we have route entry with temporary vr_id VID replaced to
+     * current vr_id VID we can do dictionary lookup for route.
+     */
 
-                SWSS_LOG_INFO("- processing ROUTE vr_id VID 0x%lx", vid);
+    auto currentRouteIt = currentView.soRoutes.find(re);
 
-                processObjectForViewTransition(currentView, temporaryView, structObject); // recursion
-            }
+    if (currentRouteIt == currentView.soRoutes.end())
+    {
+        SWSS_LOG_DEBUG("unable to find route entry %s in current asic view", temporaryObj->str_object_id.c_str());
 
-            break;
+        return nullptr;
+    }
 
-        case SAI_OBJECT_TYPE_TRAP:
-        case SAI_OBJECT_TYPE_SWITCH:
-        case SAI_OBJECT_TYPE_VLAN:
-        case SAI_OBJECT_TYPE_FDB:
+    /*
+     * We found the same route entry in current view! Just one extra check
+     * of object status if it's not processed yet.
+     */
 
-            {
-                /*
-                 * In SAI 0.9.4 FDB don't contains any object IDs so no extra work
-                 * required at this stage. As SAI 1.0 this will change.
-                 */
-            }
+    auto currentRouteObj = currentRouteIt->second;
 
-            break;
+    if (currentRouteObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    {
+        return currentRouteObj;
+    }
 
-        default:
+    /*
+     * If we are here, that means this route was already processed, which
+     * can indicate a bug or somehow duplicated entries.
+     */
 
-            SWSS_LOG_ERROR("non object id %s is not supported for processing yet, FIXME", temporaryObj->str_object_type.c_str());
+    SWSS_LOG_ERROR("found route entry %s in current view, but it status is %d, FATAL",
+            currentRouteObj->str_object_id.c_str(), currentRouteObj->getObjectStatus());
 
-            throw std::runtime_error("non object id is not supported for processing yet, FIXME");
-    }
+    throw std::runtime_error("found route entry in current view, but it status was processed");
 }/*}}}*/
 
-std::shared_ptr<SaiAttr> getSaiAttrFromDefaultValue(
+std::shared_ptr<SaiObj> findCurrentBestMatchForSwitch(/*{{{*/
         _In_ const AsicView &currentView,
-        _In_ const sai_attr_metadata_t &meta);
-
-void releaseExisgingLinks(
-        _In_ AsicView &view,
-        _In_ std::shared_ptr<SaiAttr> attr);
-
-void bindNewLinks(/*{{{*/
-        _In_ AsicView &view,
-        _In_ std::shared_ptr<SaiAttr> attr)
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> temporaryObj)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * For each VID on that attribute (it can be single oid or oid list,
-     * bind new link on current view.
-     *
-     * Notice that this list can contain VIDs from temporary view or default
-     * view, so they may not exists in current view. But that should also be
-     * not the case since we eather created new object on current view or
-     * eather we matched current object to temporary object so RID can be the
-     * same.
-     *
-     * Also if we want to keep track of object reverse dependency
-     * this action can be more complicated.
+     * On compare logic we checked that we have one switch
+     * so we can just get first.
      */
 
-    for (auto const &vid: attr->getOidListFromAttribute())
+    auto currentSwitchIt = currentView.soSwitches.begin();
+
+    if (currentSwitchIt == currentView.soSwitches.end())
     {
-        view.bindNewVidReference(vid);
+        SWSS_LOG_DEBUG("unable to find switch object in current view");
+
+        return nullptr;
     }
-}/*}}}*/
 
-void bringNonRemovableObjectToDefaultState(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView,
-        _In_ std::shared_ptr<SaiObj> currentObj)
-{
-    SWSS_LOG_ENTER();
+    /*
+     * We found switch object in current view! Just one extra check
+     * of object status if it's not processed yet.
+     */
 
-    for (const auto &it: currentObj->getAllAttributes())
-    {
-        const auto &attr = it.second;
+    auto currentSwitchObj = currentSwitchIt->second;
 
-        const auto &meta = attr->getAttrMetadata();
+    if (currentSwitchObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    {
+        return currentSwitchObj;
+    }
 
-        if (!HAS_FLAG_CREATE_AND_SET(meta->flags))
-        {
-            SWSS_LOG_ERROR("attribute %s is not CREATE_AND_SET, bug?", meta->attridname);
+    /*
+     * If we are here, that means this switch was already processed, which
+     * can indicate a bug or somehow duplicated entries.
+     */
 
-            throw std::runtime_error("attribute is not create and set");
-        }
+    SWSS_LOG_ERROR("found switch object %s in current view, but it status is %d, FATAL",
+            currentSwitchObj->str_object_id.c_str(), currentSwitchObj->getObjectStatus());
 
-        if (meta->defaultvaluetype == SAI_DEFAULT_VALUE_TYPE_NONE)
-        {
-            SWSS_LOG_ERROR("attribute %s default value type is NONE, bug?", meta->attridname);
+    throw std::runtime_error("found switch object in current view, but it status was processed");
+}/*}}}*/
 
-            throw std::runtime_error("attribute default value type is none");
-        }
+std::shared_ptr<SaiObj> findCurrentBestMatchForFdbEntry(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+{
+    SWSS_LOG_ENTER();
 
-        auto defaultValueAttr = getSaiAttrFromDefaultValue(currentView, *meta);
+    /*
+     * For fdb we don't need to iterate via all current
+     * fdbs, we can do dictionary lookup, we don't even
+     * do OID translation since fdb entry don't contain
+     * any oids, so simple direct lookup is fine. This
+     * will change in SAI 1.0 since oids are added there.
+     */
 
-        if (defaultValueAttr == nullptr)
-        {
-            SWSS_LOG_ERROR("Can't get default value for present current attr %s:%s, FIXME",
-                    meta->attridname,
-                    attr->getStrAttrValue().c_str());
+    sai_fdb_entry_t fe = temporaryObj->meta_key.key.fdb_entry;
 
-            throw std::runtime_error("cant get default value for attribute");
-        }
+    auto currentFdbIt = currentView.soFdbs.find(fe);
 
-        if (attr->getStrAttrValue() == defaultValueAttr->getStrAttrValue())
-        {
-            /*
-             * If current value is the same as default value no need to
-             * generate ASIC update command.
-             */
+    if (currentFdbIt == currentView.soFdbs.end())
+    {
+        SWSS_LOG_DEBUG("unable to find fdb entry %s in current asic view", temporaryObj->str_object_id.c_str());
 
-            continue;
-        }
+        return nullptr;
+    }
 
-        if (attr->isObjectIdAttr())
-        {
-            /*
-             * If attribute is OID attribute, we need to release previous links
-             * and bind new links for new OID.
-             */
+    /*
+     * We found the same fdb entry in current view! Just one extra check
+     * of object status if it's not processed yet.
+     */
 
-            releaseExisgingLinks(currentView, attr);
+    auto currentFdbObj = currentFdbIt->second;
 
-            currentObj->setAttr(defaultValueAttr);
+    if (currentFdbObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    {
+        return currentFdbObj;
+    }
 
-            bindNewLinks(currentView, defaultValueAttr);
-        }
-        else
-        {
-            /*
-             * Attribute is non oid attribute, so no links operation is needed.
-             */
+    /*
+     * If we are here, that means this fdb was already processed, which
+     * can indicate a bug or somehow duplicated entries.
+     */
 
-            currentObj->setAttr(defaultValueAttr);
-        }
+    SWSS_LOG_ERROR("found fdb entry %s in current view, but it status is %d, FATAL",
+            currentFdbObj->str_object_id.c_str(), currentFdbObj->getObjectStatus() );
 
-        currentView.asicSetAttribute(currentObj, defaultValueAttr);
+    throw std::runtime_error("found fdb entry in current view, but it status was processed");
+}/*}}}*/
+
+std::shared_ptr<SaiObj> findCurrentBestMatchForTrap(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * For traps in 0.9.4 traps are enum values, and we have
+     * their exact names so we can do direct dictionary lookup.
+     */
+
+    sai_hostif_trap_id_t trap_id = temporaryObj->meta_key.key.trap_id;
+
+    std::string str_trap_id = sai_serialize_hostif_trap_id(trap_id);
+
+    /*
+     * Now when we have serialized trap id, we can do dictionary lookup for trap.
+     */
+
+    auto currentTrapIt = currentView.soTraps.find(str_trap_id);
+
+    if (currentTrapIt == currentView.soTraps.end())
+    {
+        SWSS_LOG_WARN("unable to find trap id %s in current asic view", str_trap_id.c_str());
+
+        return nullptr;
     }
 
-    currentObj->setObjectStatus(SAI_OBJECT_STATUS_FINAL);
+    /*
+     * We found the same trap id in current view! Just one extra check
+     * of object status if it's not processed yet.
+     */
+
+    auto currentTrapObj = currentTrapIt->second;
+
+    if (currentTrapObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    {
+        return currentTrapObj;
+    }
 
     /*
-     * Problem here is that default trap group is used and we build references
-     * for it, so it will not be "removed" when processing, since it's default
-     * object so it will not be processed, and also it can't be removed since
-     * it's default object.
+     * If we are here, that means this trap was already processed, which
+     * can indicate a bug or somehow duplicated entries.
      */
+
+    SWSS_LOG_ERROR("found trap id %s in current view, but it status is %d, FATAL",
+            str_trap_id.c_str(), currentTrapObj->getObjectStatus());
+
+    throw std::runtime_error("found trap id in current view, but it status was processed");
 }/*}}}*/
 
-void releaseExisgingLinks(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ std::shared_ptr<SaiObj> currentObj)
+std::shared_ptr<SaiObj> findCurrentBestMatchForVlan(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> temporaryObj)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto &ita: currentObj->getAllAttributes())
+    /*
+     * For vlan in 0.9.4 vlans are numbers values, and we have
+     * their exact values so we can do direct dictionary lookup.
+     */
+
+    sai_vlan_id_t vlan_id = temporaryObj->meta_key.key.vlan_id;
+
+    std::string str_vlan_id = sai_serialize_vlan_id(vlan_id);
+
+    /*
+     * Now when we have serialized vlan id, we can do dictionary lookup for vlan.
+     */
+
+    auto currentVlanIt = currentView.soVlans.find(str_vlan_id);
+
+    if (currentVlanIt == currentView.soVlans.end())
     {
-        releaseExisgingLinks(currentView, ita.second);
+        SWSS_LOG_DEBUG("unable to find vlan id %s in current asic view", str_vlan_id.c_str());
+
+        return nullptr;
     }
-}/*}}}*/
 
-void removeExistingObjectFromCurrentView(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView,
-        _In_ std::shared_ptr<SaiObj> currentObj)
-{
-    SWSS_LOG_ENTER();
+    /*
+     * We found the same vlan id in current view! Just one extra check
+     * of object status if it's not processed yet.
+     */
+
+    auto currentVlanObj = currentVlanIt->second;
+
+    if (currentVlanObj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+    {
+        return currentVlanObj;
+    }
 
     /*
-     * This decreaseing VID reference will be hard when actual reference will
-     * be one of default objects like CPU or default trap group when we "bring
-     * defaul value" or maybe in oid case we will not bring default values and
-     * just remove and recreate.
+     * If we are here, that means this vlan was already processed, which
+     * can indicate a bug or somehow duplicated entries.
      */
 
-    if (currentObj->oidObject)
+    SWSS_LOG_ERROR("found vlan id %s in current view, but it status is %d, FATAL",
+            str_vlan_id.c_str(), currentVlanObj->getObjectStatus());
+
+    throw std::runtime_error("found vlan id in current view, but it status was processed");
+}/*}}}*/
+
+std::shared_ptr<SaiObj> findCurrentBestMatch(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> temporaryObj)
+{
+    SWSS_LOG_ENTER();
+
+    if (temporaryObj->oidObject)
     {
-        int count = currentView.getVidReferenceCount(currentObj->getVid());
+        /*
+         * This approach will not work for neighbor but it could work for
+         * routes in SAI 0.9.4 with default virtual router. But make no sense
+         * to invest time since in SAI 1.0 it will not work for routes as well.
+         */
 
-        if (count != 0)
+        if (temporaryObj->getObjectStatus() == SAI_OBJECT_STATUS_MATCHED)
         {
             /*
-             * If references count is not zero, we need to remove child
-             * first for that we need dependency tree, not supported yet.
+             * Object status is matched so current and temp VID are the same so
+             * we can just take object directly.
              */
 
-            SWSS_LOG_ERROR("can't remove existing object %s:%s since reference count is %d, FIXME",
-                    currentObj->str_object_type.c_str(),
-                    currentObj->str_object_id.c_str(),
-                    count);
+            SWSS_LOG_INFO("found best match for %s %s since object status is MATCHED",
+                    temporaryObj->getStrObjectType().c_str(),
+                    temporaryObj->str_object_id.c_str());
 
-            throw std::runtime_error("can't remove existing object since reference count is not zero, FIXME");
+            return currentView.oOids.at(temporaryObj->getVid());
         }
     }
 
     /*
-     * If some object can't be removed from current and it's missing from temp,
-     * then it needs to be transfered to temp as well and bring to default
-     * values.
-     *
-     * First we need to check if object can be removed, like port's cant be
-     * removed, vlan 1, queues, ingress_pg etc.
+     * NOTE: later on best match find can be done based on present CREATE_ONLY
+     * attributes or on most matched CREATE_AND_SET attributes.
      */
 
-    switch (currentObj->getObjectType())
+    switch (temporaryObj->getObjectType())
     {
+        /*
+         * Non object id cases
+         */
+
         case SAI_OBJECT_TYPE_NEIGHBOR:
-        case SAI_OBJECT_TYPE_FDB:
+            return findCurrentBestMatchForNeighborEntry(currentView, temporaryView, temporaryObj);
+
         case SAI_OBJECT_TYPE_ROUTE:
+            return findCurrentBestMatchForRouteEntry(currentView, temporaryView, temporaryObj);
+
+        case SAI_OBJECT_TYPE_FDB:
+            return findCurrentBestMatchForFdbEntry(currentView, temporaryView, temporaryObj);
+
+        case SAI_OBJECT_TYPE_SWITCH:
+            return findCurrentBestMatchForSwitch(currentView, temporaryView, temporaryObj);
+
+        case SAI_OBJECT_TYPE_TRAP:
+            return findCurrentBestMatchForTrap(currentView, temporaryView, temporaryObj);
+
+        case SAI_OBJECT_TYPE_VLAN:
+            return findCurrentBestMatchForVlan(currentView, temporaryView, temporaryObj);
+
+        default:
 
             /*
-             * For ROUTE/FDB/NEIGHBOR we don't need to worry about dependencies
-             * since those are struct object id and no object is usind it. But
-             * we need to release it reference id for useda OIDs in structs
-             * like rif_id and vr_id.
+             * Here we support only object id object types.
              */
 
-            currentView.asicRemoveNonObjectIdObject(currentObj);
+            return findCurrentBestMatchForGenericObject(currentView, temporaryView, temporaryObj);
+    }
+}/*}}}*/
 
-            releaseExisgingLinks(currentView, currentObj);
-            currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
+void processObjectForViewTransition(
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView,
+        _In_ std::shared_ptr<SaiObj> temporayObj);
 
-            return;
+/**
+ * @brief Process object attributes for view transition
+ *
+ * Since each object can contain attributes (or non id struct object can
+ * contain oids inside struct) they need to be processed first recursivly and
+ * they need to be in FINAL state before processing temporary view further.
+ * This processing may result in changes in current view like removing and
+ * recreateing or adding new objects depends on transitions.
+ */
+void procesObjectAttributesForViewTransition(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView,
+        _In_ std::shared_ptr<SaiObj> temporaryObj)
+{
+    SWSS_LOG_ENTER();
 
-        case SAI_OBJECT_TYPE_VLAN:
+    SWSS_LOG_INFO("%s %s", temporaryObj->getStrObjectType().c_str(), temporaryObj->str_object_id.c_str());
 
-            if (currentObj->meta_key.key.vlan_id == 1)
-            {
-                /*
-                 * VLAN 1 can't be removed.
-                 */
+    /*
+     * First we need to make sure if all attributes of this temporary object
+     * are in FINAL or MATCHED state, then we can process this object and find
+     * best match in current asic view.
+     */
 
-                bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
-            }
-            else
-            {
-                currentView.asicRemoveNonObjectIdObject(currentObj);
+    for (auto &at: temporaryObj->getAllAttributes())
+    {
+        auto &attribute = at.second;
 
-                releaseExisgingLinks(currentView, currentObj);
-                currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
+        SWSS_LOG_INFO("attr %s", attribute->getStrAttrId().c_str());
+
+        // for each object id in attributes go recursively to match those objects
+
+        for (auto vid: attribute->getOidListFromAttribute())
+        {
+            if (vid == SAI_NULL_OBJECT_ID)
+            {
+                continue;
             }
 
-            return;
+            SWSS_LOG_INFO("- processing attr VID 0x%lx", vid);
 
-        case SAI_OBJECT_TYPE_SWITCH:
-        case SAI_OBJECT_TYPE_TRAP:
+            auto tempParent = temporaryView.oOids.at(vid);
 
-            /*
-             * All traps are inserted so we should alwasy find current best
-             * match.
-             */
+            processObjectForViewTransition(currentView, temporaryView, tempParent); // recursion
 
-            bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
-            return;
-
-        case SAI_OBJECT_TYPE_SCHEDULER:
-        case SAI_OBJECT_TYPE_POLICER:
-        case SAI_OBJECT_TYPE_QOS_MAPS:
-        case SAI_OBJECT_TYPE_NEXT_HOP_GROUP:
-        case SAI_OBJECT_TYPE_BUFFER_POOL:
-        case SAI_OBJECT_TYPE_WRED:
-        case SAI_OBJECT_TYPE_BUFFER_PROFILE:
-        case SAI_OBJECT_TYPE_NEXT_HOP:
-        case SAI_OBJECT_TYPE_ROUTER_INTERFACE:
-        case SAI_OBJECT_TYPE_ACL_ENTRY:
-        case SAI_OBJECT_TYPE_HOST_INTERFACE:
-        case SAI_OBJECT_TYPE_ACL_TABLE:
+            /*
+             * Temporary object here is never changed, even if we do recursion
+             * here all that could been removed are objects in current view
+             * tree so we don't need to worry about any temporary object
+             * removal.
+             */
+        }
+    }
 
-            currentView.asicRemoveObject(currentObj);
+    if (temporaryObj->oidObject)
+    {
+        return;
+    }
 
-            releaseExisgingLinks(currentView, currentObj);
-            currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
+    /*
+     * For non object id types like NEIGHBOR or ROUTE they have object id
+     * inside object struct entry, they also need to be processed, in SAI 1.0
+     * this can be automated since we have metadata for those structs.
+     */
 
-            return;
+    switch (temporaryObj->getObjectType())
+    {
+        case SAI_OBJECT_TYPE_NEIGHBOR:
 
-            /*
-             * Remove for those objects is not supported now lets bring back
-             * object to default state.
-             *
-             * For oid values we can figure out if we would have list of
-             * defaults which can be removed and which can't and use list same
-             * for queu schedulers etc.
-             */
+            {
+                sai_object_id_t vid = temporaryObj->meta_key.key.neighbor_entry.rif_id;
 
-        case SAI_OBJECT_TYPE_TRAP_GROUP:
-        case SAI_OBJECT_TYPE_VIRTUAL_ROUTER:
+                auto structObject = temporaryView.oOids.at(vid);
 
-            if (currentView.vidToRid.at(currentObj->getVid()) == currentView.defaultVirtualRouterRid ||
-                currentView.vidToRid.at(currentObj->getVid()) == currentView.defaultTrapGroupRid)
-            {
-                /*
-                 * Default trap group and default virtual router can't be removed.
-                 */
+                SWSS_LOG_INFO("- processing NEIGHBOR rif_id VID 0x%lx", vid);
 
-                bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
+                processObjectForViewTransition(currentView, temporaryView, structObject); // recursion
             }
-            else
+
+            break;
+
+        case SAI_OBJECT_TYPE_ROUTE:
+
             {
-                currentView.asicRemoveObject(currentObj);
+                sai_object_id_t vid = temporaryObj->meta_key.key.route_entry.vr_id;
 
-                releaseExisgingLinks(currentView, currentObj);
-                currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
+                auto structObject = temporaryView.oOids.at(vid);
+
+                SWSS_LOG_INFO("- processing ROUTE vr_id VID 0x%lx", vid);
+
+                processObjectForViewTransition(currentView, temporaryView, structObject); // recursion
             }
 
-            return;
+            break;
 
-        /*
-         * NOTE: Some queues can be user created and then they can be removed.
-         * Also user can create scheduler groups as well.
-         */
+        case SAI_OBJECT_TYPE_TRAP:
+        case SAI_OBJECT_TYPE_SWITCH:
+        case SAI_OBJECT_TYPE_VLAN:
+        case SAI_OBJECT_TYPE_FDB:
 
-        case SAI_OBJECT_TYPE_PORT:
-        case SAI_OBJECT_TYPE_QUEUE:
-        case SAI_OBJECT_TYPE_PRIORITY_GROUP:
-        case SAI_OBJECT_TYPE_SCHEDULER_GROUP:
-            bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
-            return;
+            {
+                /*
+                 * In SAI 0.9.4 FDB don't contains any object IDs so no extra work
+                 * required at this stage. As SAI 1.0 this will change.
+                 */
+            }
 
-        default:
             break;
-    }
 
-    SWSS_LOG_ERROR("remove existing object %s:%s from current view is not supported yet, FIXME",
-            currentObj->str_object_type.c_str(),
-            currentObj->str_object_id.c_str());
+        default:
 
-    throw std::runtime_error("remove existing object from current view is not supported yet, FIXME");
+            SWSS_LOG_ERROR("non object id %s is not supported for processing yet, FIXME", temporaryObj->getStrObjectType().c_str());
+
+            throw std::runtime_error("non object id is not supported for processing yet, FIXME");
+    }
 }/*}}}*/
 
-void releaseExisgingLinks(/*{{{*/
+std::shared_ptr<SaiAttr> getSaiAttrFromDefaultValue(
+        _In_ const AsicView &currentView,
+        _In_ const sai_attr_metadata_t &meta);
+
+void releaseExisgingLinks(
+        _In_ AsicView &view,
+        _In_ std::shared_ptr<SaiAttr> attr);
+
+void bindNewLinks(/*{{{*/
         _In_ AsicView &view,
         _In_ std::shared_ptr<SaiAttr> attr)
 {
@@ -2989,10 +3734,13 @@ void releaseExisgingLinks(/*{{{*/
 
     /*
      * For each VID on that attribute (it can be single oid or oid list,
-     * release link on current view.
+     * bind new link on current view.
      *
-     * Second operation after could increase links of setting new attribute, or
-     * nothing if object was removed.
+     * Notice that this list can contain VIDs from temporary view or default
+     * view, so they may not exists in current view. But that should also be
+     * not the case since we eather created new object on current view or
+     * eather we matched current object to temporary object so RID can be the
+     * same.
      *
      * Also if we want to keep track of object reverse dependency
      * this action can be more complicated.
@@ -3000,260 +3748,546 @@ void releaseExisgingLinks(/*{{{*/
 
     for (auto const &vid: attr->getOidListFromAttribute())
     {
-        view.releaseVidReference(vid);
+        view.bindNewVidReference(vid);
     }
 }/*}}}*/
 
-sai_object_id_t translateTemporaryVidToCurrentVid(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView,
-        _In_ sai_object_id_t tvid)
+void bringNonRemovableObjectToDefaultState(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView,
+        _In_ std::shared_ptr<SaiObj> currentObj)
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * This method is used to translate temporary VID to current VID using RID
-     * which should be present in both views.  If RID don't exist, then we
-     * check whether object was created if so, then we return temporary VID
-     * instead of createing new current VID and we don't need to track mapping
-     * of those vids not having actual RID. This function should be used only
-     * when we creating new objects in current view.
-     */
-
-    auto temporaryIt = temporaryView.vidToRid.find(tvid);
-
-    if (temporaryIt == temporaryView.vidToRid.end())
+    for (const auto &it: currentObj->getAllAttributes())
     {
-        /*
-         * This can also happen when this VID object was created dynamically,
-         * and don't have RID assigned yet, in that case we should use exact
-         * same VID. We need to get temporary object for that VID and see if
-         * flag created is set, and same VID must then exists in current view.
-         */
+        const auto &attr = it.second;
 
-        /*
-         * We need to find object that has this vid
-         */
+        const auto &meta = attr->getAttrMetadata();
 
-        auto tempIt = temporaryView.oOids.find(tvid);
+        if (!HAS_FLAG_CREATE_AND_SET(meta->flags))
+        {
+            SWSS_LOG_ERROR("attribute %s is not CREATE_AND_SET, bug?", meta->attridname);
 
-        if (tempIt == temporaryView.oOids.end())
+            throw std::runtime_error("attribute is not create and set");
+        }
+
+        if (meta->defaultvaluetype == SAI_DEFAULT_VALUE_TYPE_NONE)
         {
-            SWSS_LOG_ERROR("temporary VID 0x%lx not found in temporary view", tvid);
+            SWSS_LOG_ERROR("attribute %s default value type is NONE, bug?", meta->attridname);
 
-            throw std::runtime_error("temporary VID not found in temporary view");
+            throw std::runtime_error("attribute default value type is none");
         }
 
-        const auto &tempObj = tempIt->second;
+        auto defaultValueAttr = getSaiAttrFromDefaultValue(currentView, *meta);
 
-        if (tempObj->createdObject)
+        if (defaultValueAttr == nullptr)
         {
-            SWSS_LOG_DEBUG("translated temp VID 0x%lx to current, since object was created", tvid);
+            SWSS_LOG_ERROR("Can't get default value for present current attr %s:%s, FIXME",
+                    meta->attridname,
+                    attr->getStrAttrValue().c_str());
 
-            return tvid;
+            throw std::runtime_error("cant get default value for attribute");
         }
 
-        SWSS_LOG_ERROR("VID 0x%lx was not found in temporary view, was object created? FIXME", tvid);
+        if (attr->getStrAttrValue() == defaultValueAttr->getStrAttrValue())
+        {
+            /*
+             * If current value is the same as default value no need to
+             * generate ASIC update command.
+             */
 
-        throw std::runtime_error("VID was not found in temp view, object was created? FIXME");
-    }
+            continue;
+        }
 
-    sai_object_id_t rid = temporaryIt->second;
+        if (attr->isObjectIdAttr())
+        {
+            /*
+             * If attribute is OID attribute, we need to release previous links
+             * and bind new links for new OID.
+             */
 
-    auto currentIt = currentView.ridToVid.find(rid);
+            releaseExisgingLinks(currentView, attr);
 
-    if (currentIt == currentView.ridToVid.end())
-    {
-        SWSS_LOG_ERROR("RID 0x%lx was not found in current view", rid);
+            currentObj->setAttr(defaultValueAttr);
 
-        throw std::runtime_error("RID was not found in current view");
+            bindNewLinks(currentView, defaultValueAttr);
+        }
+        else
+        {
+            /*
+             * Attribute is non oid attribute, so no links operation is needed.
+             */
+
+            currentObj->setAttr(defaultValueAttr);
+        }
+
+        currentView.asicSetAttribute(currentObj, defaultValueAttr);
     }
 
-    sai_object_id_t cvid = currentIt->second;
+    currentObj->setObjectStatus(SAI_OBJECT_STATUS_FINAL);
 
-    SWSS_LOG_DEBUG("translated temp VID 0x%lx using RID 0x%lx to current VID 0x%lx", tvid, rid, cvid);
+    /*
+     * Problem here is that default trap group is used and we build references
+     * for it, so it will not be "removed" when processing, since it's default
+     * object so it will not be processed, and also it can't be removed since
+     * it's default object.
+     */
+}/*}}}*/
 
-    return cvid;
+void releaseExisgingLinks(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ std::shared_ptr<SaiObj> currentObj)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &ita: currentObj->getAllAttributes())
+    {
+        releaseExisgingLinks(currentView, ita.second);
+    }
 }/*}}}*/
 
-std::shared_ptr<SaiAttr> translateTemporaryVidsToCurrentVids(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> &currentObj,
-        _In_ const std::shared_ptr<SaiAttr> &inattr)
+void removeExistingObjectFromCurrentView(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView,
+        _In_ std::shared_ptr<SaiObj> currentObj)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * We are creating copy here since we will modyify contents of that
-     * attribute.
+     * This decreaseing VID reference will be hard when actual reference will
+     * be one of default objects like CPU or default trap group when we "bring
+     * defaul value" or maybe in oid case we will not bring default values and
+     * just remove and recreate.
      */
 
-    auto attr = std::make_shared<SaiAttr>(inattr->getStrAttrId(), inattr->getStrAttrValue());
-
-    if (!attr->isObjectIdAttr())
+    if (currentObj->oidObject)
     {
-        return attr;
+        int count = currentView.getVidReferenceCount(currentObj->getVid());
+
+        if (count != 0)
+        {
+            /*
+             * If references count is not zero, we need to remove child
+             * first for that we need dependency tree, not supported yet.
+             */
+
+            SWSS_LOG_ERROR("can't remove existing object %s:%s since reference count is %d, FIXME",
+                    currentObj->getStrObjectType().c_str(),
+                    currentObj->str_object_id.c_str(),
+                    count);
+
+            throw std::runtime_error("can't remove existing object since reference count is not zero, FIXME");
+        }
     }
 
     /*
-     * We need temporary VID translation to current view RID.
+     * If some object can't be removed from current and it's missing from temp,
+     * then it needs to be transfered to temp as well and bring to default
+     * values.
      *
-     * We also need simpler version that will translate simple VID for
-     * oids present inside non object id structs.
+     * First we need to check if object can be removed, like port's cant be
+     * removed, vlan 1, queues, ingress_pg etc.
      */
 
-    uint32_t count = 0;
+    switch (currentObj->getObjectType())
+    {
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+        case SAI_OBJECT_TYPE_FDB:
+        case SAI_OBJECT_TYPE_ROUTE:
 
-    sai_object_id_t *objectIdList = NULL;
+            /*
+             * For ROUTE/FDB/NEIGHBOR we don't need to worry about dependencies
+             * since those are struct object id and no object is usind it. But
+             * we need to release it reference id for useda OIDs in structs
+             * like rif_id and vr_id.
+             */
 
-    auto &at = *attr->getRWSaiAttr();
+            currentView.asicRemoveNonObjectIdObject(currentObj);
 
-    switch (attr->getAttrMetadata()->serializationtype)
-    {
-        case SAI_SERIALIZATION_TYPE_OBJECT_ID:
-            count = 1;
-            objectIdList = &at.value.oid;
-            break;
+            releaseExisgingLinks(currentView, currentObj);
+            currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
 
-        case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
-            count = at.value.objlist.count;
-            objectIdList = at.value.objlist.list;
-            break;
+            return;
 
-        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+        case SAI_OBJECT_TYPE_VLAN:
 
-            if (at.value.aclfield.enable)
+            if (currentObj->meta_key.key.vlan_id == 1)
             {
-                count = 1;
-                objectIdList = &at.value.aclfield.data.oid;
+                /*
+                 * VLAN 1 can't be removed.
+                 */
+
+                bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
             }
+            else
+            {
+                currentView.asicRemoveNonObjectIdObject(currentObj);
 
-            break;
+                releaseExisgingLinks(currentView, currentObj);
+                currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
+            }
 
-        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            return;
 
-            if (at.value.aclfield.enable)
-            {
-                count = at.value.aclfield.data.objlist.count;
-                objectIdList = at.value.aclfield.data.objlist.list;
-            }
+        case SAI_OBJECT_TYPE_SWITCH:
+        case SAI_OBJECT_TYPE_TRAP:
 
-            break;
+            /*
+             * All traps are inserted so we should alwasy find current best
+             * match.
+             */
 
-        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+            bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
+            return;
 
-            if (at.value.aclaction.enable)
-            {
-                count = 1;
-                objectIdList = &at.value.aclaction.parameter.oid;
-            }
+        case SAI_OBJECT_TYPE_SCHEDULER:
+        case SAI_OBJECT_TYPE_POLICER:
+        case SAI_OBJECT_TYPE_QOS_MAPS:
+        case SAI_OBJECT_TYPE_NEXT_HOP_GROUP:
+        case SAI_OBJECT_TYPE_BUFFER_POOL:
+        case SAI_OBJECT_TYPE_WRED:
+        case SAI_OBJECT_TYPE_BUFFER_PROFILE:
+        case SAI_OBJECT_TYPE_NEXT_HOP:
+        case SAI_OBJECT_TYPE_ROUTER_INTERFACE:
+        case SAI_OBJECT_TYPE_ACL_ENTRY:
+        case SAI_OBJECT_TYPE_HOST_INTERFACE:
+        case SAI_OBJECT_TYPE_ACL_TABLE:
 
-            break;
+            currentView.asicRemoveObject(currentObj);
 
-        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            releaseExisgingLinks(currentView, currentObj);
+            currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
 
-            if (at.value.aclaction.enable)
-            {
-                count = at.value.aclaction.parameter.objlist.count;
-                objectIdList = at.value.aclaction.parameter.objlist.list;
-            }
+            return;
 
-            break;
+            /*
+             * Remove for those objects is not supported now lets bring back
+             * object to default state.
+             *
+             * For oid values we can figure out if we would have list of
+             * defaults which can be removed and which can't and use list same
+             * for queu schedulers etc.
+             */
 
-        default:
-            break;
-    }
+        case SAI_OBJECT_TYPE_TRAP_GROUP:
+        case SAI_OBJECT_TYPE_VIRTUAL_ROUTER:
 
-    for (uint32_t i = 0; i < count; ++i)
-    {
-        sai_object_id_t tvid = objectIdList[i];
+            if (currentView.vidToRid.at(currentObj->getVid()) == currentView.defaultVirtualRouterRid ||
+                currentView.vidToRid.at(currentObj->getVid()) == currentView.defaultTrapGroupRid)
+            {
+                /*
+                 * Default trap group and default virtual router can't be removed.
+                 */
 
-        if (tvid == SAI_NULL_OBJECT_ID)
-        {
-            continue;
-        }
+                bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
+            }
+            else
+            {
+                currentView.asicRemoveObject(currentObj);
+
+                releaseExisgingLinks(currentView, currentObj);
+                currentObj->setObjectStatus(SAI_OBJECT_STATUS_REMOVED);
+            }
+
+            return;
 
         /*
-         * Do actual translation.
+         * NOTE: Some queues can be user created and then they can be removed.
+         * Also user can create scheduler groups as well.
          */
 
-        objectIdList[i] =  translateTemporaryVidToCurrentVid(currentView, temporaryView, tvid);
-    }
+        case SAI_OBJECT_TYPE_PORT:
+        case SAI_OBJECT_TYPE_QUEUE:
+        case SAI_OBJECT_TYPE_PRIORITY_GROUP:
+        case SAI_OBJECT_TYPE_SCHEDULER_GROUP:
+            bringNonRemovableObjectToDefaultState(currentView, temporaryView, currentObj);
+            return;
 
-    /*
-     * Since we probably performed updates on this attribute, since VID was
-     * eschanged, we need to update value string of that attribute.
-     */
+        default:
+            break;
+    }
 
-    attr->UpdateValue();
+    SWSS_LOG_ERROR("remove existing object %s:%s from current view is not supported yet, FIXME",
+            currentObj->getStrObjectType().c_str(),
+            currentObj->str_object_id.c_str());
 
-    return attr;
+    throw std::runtime_error("remove existing object from current view is not supported yet, FIXME");
 }/*}}}*/
 
-/**
- * @brief Set attribute on current object
- *
- * This function will set given attribute to current object adding new
- * attribute or replacing exising one. Given attribute can be eather one
- * temporary attribute missing or different from current object object or
- * default attribute value if we need to bring some attribute to default value.
- */
-void setAttributeOnCurrentObject(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView,
-        _In_ const std::shared_ptr<SaiObj> &currentObj,
-        _In_ const std::shared_ptr<SaiAttr> &inattr)
+void releaseExisgingLinks(/*{{{*/
+        _In_ AsicView &view,
+        _In_ std::shared_ptr<SaiAttr> attr)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * At the beginning just small assert to check if object is create and set.
+     * For each VID on that attribute (it can be single oid or oid list,
+     * release link on current view.
+     *
+     * Second operation after could increase links of setting new attribute, or
+     * nothing if object was removed.
+     *
+     * Also if we want to keep track of object reverse dependency
+     * this action can be more complicated.
      */
 
-    const auto meta = inattr->getAttrMetadata();
-
-    if (!HAS_FLAG_CREATE_AND_SET(meta->flags))
+    for (auto const &vid: attr->getOidListFromAttribute())
     {
-        SWSS_LOG_ERROR("can't set attribute %s on current object %s:%s since it's not CREATE_AND_SET",
-                meta->attridname,
-                currentObj->str_object_type.c_str(),
-                currentObj->str_object_id.c_str());
-
-        throw std::runtime_error("can't set attribute on current object since it's not CREATE_AND_SET");
+        view.releaseVidReference(vid);
     }
+}/*}}}*/
+
+sai_object_id_t translateTemporaryVidToCurrentVid(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ sai_object_id_t tvid)
+{
+    SWSS_LOG_ENTER();
 
     /*
-     * TODO There is a problem here, since attribute we SET can be OID
-     * attribute, and that can be a VID or list of VIDs from temporary view. So
-     * after this "set" operation we will end up with MIXED VIDs on current
-     * view, some object will contain VIDs from temporary view, and this can
-     * lead to fail in translate_vid_to_rid since we will need to look inside
-     * two views to find right RID.
-     *
-     * We need a flag to say that VID is for object that was created
-     * and we can mix only those VID's for objects that was created
-     *
-     * In here we need to translate attribute VIDs to current VIDs to keep
-     * track in dependency tree, since if we use temporary VID that will point
-     * to the same RID then we will lost track in dependency tree of that VID
-     * reference count.
-     *
-     * This should also done for object id's inside non object ids.
+     * This method is used to translate temporary VID to current VID using RID
+     * which should be present in both views.  If RID don't exist, then we
+     * check whether object was created if so, then we return temporary VID
+     * instead of createing new current VID and we don't need to track mapping
+     * of those vids not having actual RID. This function should be used only
+     * when we creating new objects in current view.
      */
 
-    std::shared_ptr<SaiAttr> attr = translateTemporaryVidsToCurrentVids(currentView, temporaryView, currentObj, inattr);
+    auto temporaryIt = temporaryView.vidToRid.find(tvid);
 
-    if (attr->isObjectIdAttr())
+    if (temporaryIt == temporaryView.vidToRid.end())
     {
-        if (currentObj->hasAttr(meta->attrid))
-        {
-            /*
-             * Since previous attribute exists, lets release previous links if
-             * they are not NULL.
-             */
-
-            releaseExisgingLinks(currentView, currentObj->getSaiAttr(meta->attrid));
+        /*
+         * This can also happen when this VID object was created dynamically,
+         * and don't have RID assigned yet, in that case we should use exact
+         * same VID. We need to get temporary object for that VID and see if
+         * flag created is set, and same VID must then exists in current view.
+         */
+
+        /*
+         * We need to find object that has this vid
+         */
+
+        auto tempIt = temporaryView.oOids.find(tvid);
+
+        if (tempIt == temporaryView.oOids.end())
+        {
+            SWSS_LOG_ERROR("temporary VID 0x%lx not found in temporary view", tvid);
+
+            throw std::runtime_error("temporary VID not found in temporary view");
+        }
+
+        const auto &tempObj = tempIt->second;
+
+        if (tempObj->createdObject)
+        {
+            SWSS_LOG_DEBUG("translated temp VID 0x%lx to current, since object was created", tvid);
+
+            return tvid;
+        }
+
+        SWSS_LOG_ERROR("VID 0x%lx was not found in temporary view, was object created? FIXME", tvid);
+
+        throw std::runtime_error("VID was not found in temp view, object was created? FIXME");
+    }
+
+    sai_object_id_t rid = temporaryIt->second;
+
+    auto currentIt = currentView.ridToVid.find(rid);
+
+    if (currentIt == currentView.ridToVid.end())
+    {
+        SWSS_LOG_ERROR("RID 0x%lx was not found in current view", rid);
+
+        throw std::runtime_error("RID was not found in current view");
+    }
+
+    sai_object_id_t cvid = currentIt->second;
+
+    SWSS_LOG_DEBUG("translated temp VID 0x%lx using RID 0x%lx to current VID 0x%lx", tvid, rid, cvid);
+
+    return cvid;
+}/*}}}*/
+
+std::shared_ptr<SaiAttr> translateTemporaryVidsToCurrentVids(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> &currentObj,
+        _In_ const std::shared_ptr<SaiAttr> &inattr)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * We are creating copy here since we will modyify contents of that
+     * attribute.
+     */
+
+    auto attr = inattr->clone();
+
+    if (!attr->isObjectIdAttr())
+    {
+        return attr;
+    }
+
+    /*
+     * We need temporary VID translation to current view RID.
+     *
+     * We also need simpler version that will translate simple VID for
+     * oids present inside non object id structs.
+     */
+
+    uint32_t count = 0;
+
+    sai_object_id_t *objectIdList = NULL;
+
+    auto &at = *attr->getRWSaiAttr();
+
+    switch (attr->getAttrMetadata()->serializationtype)
+    {
+        case SAI_SERIALIZATION_TYPE_OBJECT_ID:
+            count = 1;
+            objectIdList = &at.value.oid;
+            break;
+
+        case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
+            count = at.value.objlist.count;
+            objectIdList = at.value.objlist.list;
+            break;
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+
+            if (at.value.aclfield.enable)
+            {
+                count = 1;
+                objectIdList = &at.value.aclfield.data.oid;
+            }
+
+            break;
+
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+
+            if (at.value.aclfield.enable)
+            {
+                count = at.value.aclfield.data.objlist.count;
+                objectIdList = at.value.aclfield.data.objlist.list;
+            }
+
+            break;
+
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+
+            if (at.value.aclaction.enable)
+            {
+                count = 1;
+                objectIdList = &at.value.aclaction.parameter.oid;
+            }
+
+            break;
+
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+
+            if (at.value.aclaction.enable)
+            {
+                count = at.value.aclaction.parameter.objlist.count;
+                objectIdList = at.value.aclaction.parameter.objlist.list;
+            }
+
+            break;
+
+        default:
+            break;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sai_object_id_t tvid = objectIdList[i];
+
+        if (tvid == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        /*
+         * Do actual translation.
+         */
+
+        objectIdList[i] =  translateTemporaryVidToCurrentVid(currentView, temporaryView, tvid);
+    }
+
+    /*
+     * Since we probably performed updates on this attribute, since VID was
+     * eschanged, we need to update value string of that attribute.
+     */
+
+    attr->UpdateValue();
+
+    return attr;
+}/*}}}*/
+
+/**
+ * @brief Set attribute on current object
+ *
+ * This function will set given attribute to current object adding new
+ * attribute or replacing exising one. Given attribute can be eather one
+ * temporary attribute missing or different from current object object or
+ * default attribute value if we need to bring some attribute to default value.
+ */
+void setAttributeOnCurrentObject(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView,
+        _In_ const std::shared_ptr<SaiObj> &currentObj,
+        _In_ const std::shared_ptr<SaiAttr> &inattr)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * At the beginning just small assert to check if object is create and set.
+     */
+
+    const auto meta = inattr->getAttrMetadata();
+
+    if (!HAS_FLAG_CREATE_AND_SET(meta->flags))
+    {
+        SWSS_LOG_ERROR("can't set attribute %s on current object %s:%s since it's not CREATE_AND_SET",
+                meta->attridname,
+                currentObj->getStrObjectType().c_str(),
+                currentObj->str_object_id.c_str());
+
+        throw std::runtime_error("can't set attribute on current object since it's not CREATE_AND_SET");
+    }
+
+    /*
+     * TODO There is a problem here, since attribute we SET can be OID
+     * attribute, and that can be a VID or list of VIDs from temporary view. So
+     * after this "set" operation we will end up with MIXED VIDs on current
+     * view, some object will contain VIDs from temporary view, and this can
+     * lead to fail in translate_vid_to_rid since we will need to look inside
+     * two views to find right RID.
+     *
+     * We need a flag to say that VID is for object that was created
+     * and we can mix only those VID's for objects that was created
+     *
+     * In here we need to translate attribute VIDs to current VIDs to keep
+     * track in dependency tree, since if we use temporary VID that will point
+     * to the same RID then we will lost track in dependency tree of that VID
+     * reference count.
+     *
+     * This should also done for object id's inside non object ids.
+     */
+
+    std::shared_ptr<SaiAttr> attr = translateTemporaryVidsToCurrentVids(currentView, temporaryView, currentObj, inattr);
+
+    if (attr->isObjectIdAttr())
+    {
+        if (currentObj->hasAttr(meta->attrid))
+        {
+            /*
+             * Since previous attribute exists, lets release previous links if
+             * they are not NULL.
+             */
+
+            releaseExisgingLinks(currentView, currentObj->getSaiAttr(meta->attrid));
         }
 
         currentObj->setAttr(attr);
@@ -3291,7 +4325,7 @@ void createNewOidObjectFromTemporaryObject(/*{{{*/
     if (!temporaryObj->oidObject)
     {
         SWSS_LOG_ERROR("expected OID object type, got: %s:%s",
-                temporaryObj->str_object_type.c_str(),
+                temporaryObj->getStrObjectType().c_str(),
                 temporaryObj->str_object_id.c_str());
 
         throw std::runtime_error("expected OID object type");
@@ -3331,7 +4365,6 @@ void createNewOidObjectFromTemporaryObject(/*{{{*/
      * TODO Find out better way to do this, copy operator ?
      */
 
-    currentObj->str_object_type  = temporaryObj->str_object_type;
     currentObj->str_object_id    = temporaryObj->str_object_id;      // temporary VID
     currentObj->meta_key         = temporaryObj->meta_key;           // temporary VID
     currentObj->defaultObject    = temporaryObj->defaultObject;
@@ -3403,7 +4436,7 @@ void createNewNonOidObjectFromTemporaryObject(/*{{{*/
     if (temporaryObj->oidObject)
     {
         SWSS_LOG_ERROR("expected non OID object type, got: %s:%s",
-                temporaryObj->str_object_type.c_str(),
+                temporaryObj->getStrObjectType().c_str(),
                 temporaryObj->str_object_id.c_str());
 
         throw std::runtime_error("expected OID object type");
@@ -3441,7 +4474,6 @@ void createNewNonOidObjectFromTemporaryObject(/*{{{*/
      * TODO Find out better way to do this, copy operator ?
      */
 
-    currentObj->str_object_type  = temporaryObj->str_object_type;
     currentObj->str_object_id    = temporaryObj->str_object_id;      // non object id
     currentObj->meta_key         = temporaryObj->meta_key;           // non object id
     currentObj->defaultObject    = temporaryObj->defaultObject;
@@ -3588,7 +4620,7 @@ void createTrapAndSetAttributes(/*{{{*/
     if (temporaryObj->getObjectType() != SAI_OBJECT_TYPE_TRAP)
     {
         SWSS_LOG_ERROR("expected TRAP, got %s:%s",
-                temporaryObj->str_object_type.c_str(),
+                temporaryObj->getStrObjectType().c_str(),
                 temporaryObj->str_object_id.c_str());
 
         throw std::runtime_error("expected TRAP object");
@@ -3602,7 +4634,7 @@ void createTrapAndSetAttributes(/*{{{*/
      */
 
     const auto &currentObj = currentView.createTrapObject(
-            temporaryObj->str_object_type,
+            temporaryObj->getStrObjectType(),
             temporaryObj->str_object_id);
 
     for(const auto &it: temporaryObj->getAllAttributes())
@@ -3628,7 +4660,7 @@ void createNewObjectFromTemporaryObject(/*{{{*/
     SWSS_LOG_ENTER();
 
     SWSS_LOG_INFO("creating object %s:%s",
-                    temporaryObj->str_object_type.c_str(),
+                    temporaryObj->getStrObjectType().c_str(),
                     temporaryObj->str_object_id.c_str());
 
     switch (temporaryObj->getObjectType())
@@ -3696,7 +4728,7 @@ void createNewObjectFromTemporaryObject(/*{{{*/
     }
 
     SWSS_LOG_ERROR("create new object %s:%s from temporay is not supported yet, FIXME",
-            temporaryObj->str_object_type.c_str(),
+            temporaryObj->getStrObjectType().c_str(),
             temporaryObj->str_object_id.c_str());
 
     throw std::runtime_error("finding current best match failed, not supported yet, FIXME");
@@ -4387,7 +5419,7 @@ void processObjectForViewTransition(/*{{{*/
          */
 
         SWSS_LOG_INFO("failed to find best match %s %s in current view, will create new object",
-                temporaryObj->str_object_type.c_str(),
+                temporaryObj->getStrObjectType().c_str(),
                 temporaryObj->str_object_id.c_str());
 
         createNewObjectFromTemporaryObject(currentView, temporaryView, temporaryObj);
@@ -4395,10 +5427,24 @@ void processObjectForViewTransition(/*{{{*/
     }
 
     SWSS_LOG_INFO("found best match %s: current: %s temporary: %s",
-            currentBestMatch->str_object_type.c_str(),
+            currentBestMatch->getStrObjectType().c_str(),
             currentBestMatch->str_object_id.c_str(),
             temporaryObj->str_object_id.c_str());
 
+    if (hasEqualContent(currentView, temporaryView, currentBestMatch, temporaryObj))
+    {
+        /*
+         * Objects have the same key and the same attributes, so there is
+         * nothing to update, no need to run set transition.
+         */
+
+        g_contentHashMatches++;
+
+        UpdateObjectStatus(currentView, temporaryView, currentBestMatch, temporaryObj);
+
+        return;
+    }
+
     /*
      * We need to two passes, for not matched parameters since if first
      * atttribute will modify current object like SET operation, but second
@@ -4438,407 +5484,1224 @@ void processObjectForViewTransition(/*{{{*/
          * final.
          */
 
-        switch (temporaryObj->getObjectType())
-        {
-            case SAI_OBJECT_TYPE_ROUTE:
-            case SAI_OBJECT_TYPE_FDB:
-            case SAI_OBJECT_TYPE_NEIGHBOR:
-            case SAI_OBJECT_TYPE_VLAN: // may be not possible may have dependencies
-            case SAI_OBJECT_TYPE_SWITCH: // switch can't be removed
-            case SAI_OBJECT_TYPE_TRAP: // traps are always defined and should only support set
+        switch (temporaryObj->getObjectType())
+        {
+            case SAI_OBJECT_TYPE_ROUTE:
+            case SAI_OBJECT_TYPE_FDB:
+            case SAI_OBJECT_TYPE_NEIGHBOR:
+            case SAI_OBJECT_TYPE_VLAN: // may be not possible may have dependencies
+            case SAI_OBJECT_TYPE_SWITCH: // switch can't be removed
+            case SAI_OBJECT_TYPE_TRAP: // traps are always defined and should only support set
+
+                removeExistingObjectFromCurrentView(currentView, temporaryView, currentBestMatch);
+                break;
+
+            default:
+
+                /*
+                 * Later on if we decide we want to remove objects before
+                 * creating new one's we need to put here this action, or just
+                 * remove this entire switch and call remove.
+                 */
+
+                break;
+        }
+
+        createNewObjectFromTemporaryObject(currentView, temporaryView, temporaryObj);
+
+        return;
+    }
+
+    /*
+     * First pass was successfull, so we can do update on current object, lets do that now!
+     */
+
+    if (temporaryObj->oidObject && (temporaryObj->getObjectStatus() != SAI_OBJECT_STATUS_MATCHED))
+    {
+        /*
+         * We track all oid object references, and since this objest was
+         * matched we need to insert it's vid to reference map since when we
+         * will update attributes in current view from temporary view
+         * attributes, then this object must be in reference map. This is
+         * sanity check. Object can't be in matched state since matched objects
+         * have the same RID and VID in both views, so VID already exists in
+         * reference map.
+         *
+         * This object VID will be remapped inside UpdateObjectStatus to
+         * rid/vid map since if we are here then we matched one of current
+         * objects to this temporary obejct and update can be performed.
+         */
+
+        // TODO this is temporary VID, it's not available in current view
+        // so we need to remove this code here, since we will translate
+        // this VID in temporary view to current view
+
+        sai_object_id_t vid = temporaryObj->getVid();
+
+        currentView.insertNewVidReference(vid);
+    }
+
+    performObjectSetTransition(currentView, temporaryView, currentBestMatch, temporaryObj, true);
+
+    /*
+     * Since we got here, that means matching or updating current best match
+     * object was successful, and we can now set their state to final.
+     */
+
+    UpdateObjectStatus(currentView, temporaryView, currentBestMatch, temporaryObj);
+}/*}}}*/
+
+void processObjectType(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView,
+        _In_ sai_object_type_t object_type)
+{
+    SWSS_LOG_ENTER();
+
+    auto objects = temporaryView.getObjectsByObjectType(object_type);
+
+    for (const auto &o: objects)
+    {
+        processObjectForViewTransition(currentView, temporaryView, o);
+    }
+
+    SWSS_LOG_NOTICE("processed %s", sai_serialize_object_type(object_type).c_str());
+}/*}}}*/
+
+void checkSwitch(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView)
+{
+    SWSS_LOG_ENTER();
+
+    size_t csize = currentView.soSwitches.size();
+    size_t tsize = temporaryView.soSwitches.size();
+
+    if (csize == 0 && tsize == 0)
+    {
+        return;
+    }
+
+    if (csize == 1 && tsize == 1)
+    {
+        return;
+    }
+
+    /*
+     * Current logic supports only 1 instance of switch so in both views we
+     * should have only 1 instance of switch and they must match.
+     */
+
+    SWSS_LOG_ERROR("unsupported number of switches: current %zu, temp %zu", csize, tsize);
+
+    throw std::runtime_error("unsupported number of switches");
+
+    /*
+     * In current SAI 0.9.4 switch is non object id so we don't need to make
+     * VID/RID for it, but in SAI 1.0 it will be object id so we need to change
+     * our strategy here.
+     *
+     * Later on we can support in 0.9.4 case where one or both switches can be
+     * missing since no attributes were set.
+     */
+}/*}}}*/
+
+void bringDefaultTrapGroupToFinalState(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t rid = currentView.defaultTrapGroupRid;
+
+    if (temporaryView.hasRid(rid))
+    {
+        /*
+         * Default trap group is defined inside temporary view
+         * so it will be matched by RID, no need to process.
+         */
+
+        return;
+    }
+
+    sai_object_id_t vid = currentView.ridToVid.at(rid);
+
+    auto const &dtgObj = currentView.oOids.at(vid);
+
+    if (dtgObj->getObjectStatus() != SAI_OBJECT_STATUS_NOT_PROCESSED)
+    {
+        /*
+         * Object was processed, no further actions are required.
+         */
+
+        return;
+    }
+
+    /*
+     * Trap group was not processed, it can't be removed so bring it to default
+     * state and release existing references.
+     */
+
+    bringNonRemovableObjectToDefaultState(currentView, temporaryView, dtgObj);
+}/*}}}*/
+
+/**
+ * @brief Get object type dependencies.
+ *
+ * Object type depends on other object type when any of it's attributes can
+ * point to that object type, this is taken from attributes metadata. Non
+ * object id structs also can contain object ids so those are added here
+ * explicitly.
+ */
+std::map<sai_object_type_t, std::set<sai_object_type_t>> getObjectTypeDependencies()/*{{{*/
+{
+    SWSS_LOG_ENTER();
+
+    std::map<sai_object_type_t, std::set<sai_object_type_t>> dependencies;
+
+    for (int ot = SAI_OBJECT_TYPE_NULL + 1; ot < SAI_OBJECT_TYPE_MAX; ++ot)
+    {
+        auto &deps = dependencies[(sai_object_type_t)ot];
+
+        for (const auto &md: get_object_type_attr_metadata((sai_object_type_t)ot)->objectids)
+        {
+            for (auto allowed: md->allowedobjecttypes)
+            {
+                deps.insert(allowed);
+
+                dependencies[allowed];
+            }
+        }
+    }
+
+    dependencies[SAI_OBJECT_TYPE_ROUTE].insert(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
+    dependencies[SAI_OBJECT_TYPE_NEIGHBOR].insert(SAI_OBJECT_TYPE_ROUTER_INTERFACE);
+
+    return dependencies;
+}/*}}}*/
+
+/**
+ * @brief Get object type processing layers.
+ *
+ * Each object type is placed in higher layer than all object types it
+ * depends on, so when all objects from lower layers are processed, objects
+ * from current layer will reference only objects in FINAL state.
+ *
+ * Object types which are part of dependency cycle (like PORT and MIRROR, or
+ * SCHEDULER_GROUP which can point to itself) are placed in the same layer and
+ * returned in cyclic set, since processing object of that type can recurse to
+ * objects in the same layer.
+ */
+std::vector<std::set<sai_object_type_t>> getObjectTypeProcessingLayers(/*{{{*/
+        _Out_ std::set<sai_object_type_t> &cyclic)
+{
+    SWSS_LOG_ENTER();
+
+    const auto dependencies = getObjectTypeDependencies();
+
+    /*
+     * Number of object types is small so we can afford computing all
+     * reachable object types for each object type.
+     */
+
+    std::map<sai_object_type_t, std::set<sai_object_type_t>> reachable;
+
+    for (const auto &dep: dependencies)
+    {
+        auto &visited = reachable[dep.first];
+
+        std::vector<sai_object_type_t> stack(dep.second.begin(), dep.second.end());
+
+        while (!stack.empty())
+        {
+            sai_object_type_t ot = stack.back();
+
+            stack.pop_back();
+
+            if (visited.find(ot) != visited.end())
+            {
+                continue;
+            }
+
+            visited.insert(ot);
+
+            const auto &next = dependencies.at(ot);
+
+            stack.insert(stack.end(), next.begin(), next.end());
+        }
+
+        if (visited.find(dep.first) != visited.end())
+        {
+            cyclic.insert(dep.first);
+        }
+    }
+
+    /*
+     * Object types that reach each other are in the same cycle and they must
+     * end up in the same layer, all other dependencies must be in lower
+     * layer. Since dependency graph without cycles is acyclic, this loop will
+     * finish.
+     */
+
+    std::map<sai_object_type_t, size_t> level;
+
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+
+        for (const auto &dep: dependencies)
+        {
+            size_t lvl = level[dep.first];
+
+            for (auto ot: dep.second)
+            {
+                bool sameCycle = reachable.at(ot).find(dep.first) != reachable.at(ot).end();
+
+                lvl = std::max(lvl, level[ot] + (sameCycle ? 0 : 1));
+            }
+
+            if (lvl != level[dep.first])
+            {
+                level[dep.first] = lvl;
+                changed = true;
+            }
+        }
+    }
+
+    std::vector<std::set<sai_object_type_t>> layers;
+
+    for (const auto &l: level)
+    {
+        if (layers.size() <= l.second)
+        {
+            layers.resize(l.second + 1);
+        }
+
+        layers[l.second].insert(l.first);
+    }
+
+    return layers;
+}/*}}}*/
+
+/*
+ * Minimum number of object comparisons in a layer for which it's worth to
+ * start worker threads.
+ */
+
+#define APPLY_VIEW_PARALLEL_MIN_COMPARISONS 4096
+
+/**
+ * @brief Precompute candidate objects for temporary objects.
+ *
+ * All temporary objects passed here must be not processed object id objects
+ * from single layer and not from cyclic object types. All objects they
+ * reference are already in FINAL state, and processing them will not modify
+ * any not processed current object of the same layer, so candidate scores
+ * computed here are the same as they would be computed serially during
+ * findCurrentBestMatchForGenericObject, and can be computed in parallel since
+ * views are not modified here.
+ */
+void precomputeCandidateObjects(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView,
+        _In_ const std::vector<std::shared_ptr<SaiObj>> &temporaryObjects)
+{
+    SWSS_LOG_ENTER();
+
+    std::map<sai_object_type_t, std::vector<std::shared_ptr<SaiObj>>> notProcessed;
+
+    size_t comparisons = 0;
+
+    for (const auto &obj: temporaryObjects)
+    {
+        sai_object_type_t ot = obj->getObjectType();
+
+        if (notProcessed.find(ot) == notProcessed.end())
+        {
+            notProcessed[ot] = currentView.getNotProcessedObjectsByObjectType(ot);
+        }
+
+        comparisons += notProcessed[ot].size();
+    }
+
+    if (comparisons < APPLY_VIEW_PARALLEL_MIN_COMPARISONS)
+    {
+        /*
+         * Not worth it, candidates will be computed serially.
+         */
+
+        return;
+    }
+
+    SWSS_LOG_TIMER("precompute candidates");
+
+    SWSS_LOG_NOTICE("precomputing candidates for %zu objects, %zu comparisons",
+            temporaryObjects.size(),
+            comparisons);
+
+    std::vector<std::vector<sai_object_compare_info_t>> candidates(temporaryObjects.size());
+
+    parallelFor(temporaryObjects.size(), [&](size_t idx)
+    {
+        const auto &obj = temporaryObjects[idx];
+
+        candidates[idx] = getCandidateObjectsForGenericObject(
+                currentView,
+                temporaryView,
+                obj,
+                notProcessed.at(obj->getObjectType()));
+    });
+
+    for (size_t idx = 0; idx < temporaryObjects.size(); ++idx)
+    {
+        g_precomputedCandidates[temporaryObjects[idx]->getVid()] = std::move(candidates[idx]);
+    }
+}/*}}}*/
+
+/**
+ * @brief Get all VIDs referenced by object.
+ *
+ * This includes object id attributes and object ids inside non object id
+ * structs like route and neighbor.
+ */
+std::vector<sai_object_id_t> getReferencedVids(/*{{{*/
+        _In_ const SaiObj &obj)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<sai_object_id_t> vids;
+
+    switch (obj.getObjectType())
+    {
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+            vids.push_back(obj.meta_key.key.neighbor_entry.rif_id);
+            break;
+
+        case SAI_OBJECT_TYPE_ROUTE:
+            vids.push_back(obj.meta_key.key.route_entry.vr_id);
+            break;
+
+        default:
+            break;
+    }
+
+    for (const auto &ita: obj.getAllAttributes())
+    {
+        for (const auto &vid: ita.second->getOidListFromAttribute())
+        {
+            if (vid != SAI_NULL_OBJECT_ID)
+            {
+                vids.push_back(vid);
+            }
+        }
+    }
+
+    return vids;
+}/*}}}*/
+
+/**
+ * @brief Remove all not processed objects from current view.
+ *
+ * Objects are removed in reverse topological order of references. Initially
+ * all objects with zero references are put on worklist. When object is
+ * removed, objects referenced by it are put on worklist if their reference
+ * count dropped to zero. Reference count is checked again when object is
+ * taken from worklist, since bringing non removable objects to default state
+ * can bind new references.
+ *
+ * Objects which were not removed are kept alive by references from objects
+ * which are not removed (reference cycle, or object in final state), this is
+ * reported as error.
+ */
+sai_status_t removeNotProcessedObjects(/*{{{*/
+        _In_ AsicView &current,
+        _In_ AsicView &temp)
+{
+    SWSS_LOG_ENTER();
+
+    std::map<std::string, std::shared_ptr<SaiObj>> worklist;
+
+    for (const auto &obj: current.getAllNotProcessedObjects())
+    {
+        /*
+         * Non object id objects don't have references count, they are leafs
+         * so we can remove them right away.
+         */
+
+        if (!obj->oidObject || current.getVidReferenceCount(obj->getVid()) == 0)
+        {
+            worklist[obj->str_object_id] = obj;
+        }
+    }
+
+    size_t removed = 0;
+
+    while (!worklist.empty())
+    {
+        auto obj = worklist.begin()->second;
+
+        worklist.erase(worklist.begin());
+
+        if (obj->getObjectStatus() != SAI_OBJECT_STATUS_NOT_PROCESSED)
+        {
+            continue;
+        }
+
+        if (obj->oidObject && current.getVidReferenceCount(obj->getVid()) != 0)
+        {
+            /*
+             * New reference was bound since object was put on worklist, it
+             * will be put there again when reference count drops to zero.
+             */
+
+            continue;
+        }
+
+        auto referenced = getReferencedVids(*obj);
+
+        removeExistingObjectFromCurrentView(current, temp, obj);
+
+        removed++;
+
+        for (const auto &vid: referenced)
+        {
+            if (current.getVidReferenceCount(vid) != 0)
+            {
+                continue;
+            }
+
+            auto it = current.oOids.find(vid);
+
+            if (it != current.oOids.end() &&
+                    it->second->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+            {
+                worklist[it->second->str_object_id] = it->second;
+            }
+        }
+    }
+
+    SWSS_LOG_NOTICE("removed %zu objects", removed);
+
+    auto remaining = current.getAllNotProcessedObjects();
+
+    if (remaining.empty())
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /*
+     * Count references between remaining objects, if all references of object
+     * come from other remaining objects, then object is part of cycle.
+     */
+
+    std::map<sai_object_id_t, int> remainingReferences;
+
+    for (const auto &obj: remaining)
+    {
+        for (const auto &vid: getReferencedVids(*obj))
+        {
+            remainingReferences[vid]++;
+        }
+    }
+
+    for (const auto &obj: remaining)
+    {
+        if (!obj->oidObject)
+        {
+            SWSS_LOG_ERROR("can't remove %s:%s",
+                    obj->getStrObjectType().c_str(),
+                    obj->str_object_id.c_str());
+
+            continue;
+        }
+
+        int count = current.getVidReferenceCount(obj->getVid());
+
+        int fromRemaining = remainingReferences[obj->getVid()];
+
+        SWSS_LOG_ERROR("can't remove %s:%s, references: %d (%d from not removed objects)%s",
+                obj->getStrObjectType().c_str(),
+                obj->str_object_id.c_str(),
+                count,
+                fromRemaining,
+                count == fromRemaining ? ", kept alive by reference cycle" : "");
+    }
+
+    SWSS_LOG_ERROR("%zu objects in current view can't be removed", remaining.size());
+
+    return SAI_STATUS_FAILURE;
+}/*}}}*/
+
+sai_status_t applyViewTransition(/*{{{*/
+        _In_ AsicView &current,
+        _In_ AsicView &temp)
+{
+    SWSS_LOG_ENTER();
+
+    checkSwitch(current, temp);
+
+    checkMatchedPorts(temp);
+
+    /*
+     * Process all objects
+     */
+
+    /*
+     * During iteration no object from temp view are removed, so no need to
+     * worry about any iterator issues here since removed objects are only from
+     * current view.
+     *
+     * Objects are processed layer by layer, where each layer contains object
+     * types that depend only on object types from lower layers. Processing
+     * objects inside a layer will not change candidates score of other not
+     * processed objects in that layer, so at the beginning of each layer we
+     * compute candidates for all objects in parallel, and then we process
+     * objects serially, so selected matches are identical to processing the
+     * same layers without precomputed candidates.
+     */
+
+    g_precomputedCandidates.clear();
+
+    g_heuristicSelections = 0;
+    g_heuristicSelectedCost = 0;
+    g_heuristicRandomCost = 0;
+
+    g_contentHashMatches = 0;
+
+    current.buildReverseReferences();
+    temp.buildReverseReferences();
+
+    /*
+     * All current objects have RIDs, so their hashes can be computed right
+     * away. Temporary object hash depends on RIDs assigned to objects it
+     * references, so it's computed when object is processed.
+     */
+
+    computeContentHashes(current);
+
+    std::set<sai_object_type_t> cyclic;
+
+    const auto layers = getObjectTypeProcessingLayers(cyclic);
+
+    std::map<sai_object_type_t, size_t> layerIndex;
+
+    for (size_t idx = 0; idx < layers.size(); ++idx)
+    {
+        for (auto ot: layers[idx])
+        {
+            layerIndex[ot] = idx;
+        }
+    }
+
+    std::vector<std::vector<std::shared_ptr<SaiObj>>> layerObjects(layers.size() + 1);
+
+    for (auto &obj: temp.soAll)
+    {
+        auto it = layerIndex.find(obj.second->getObjectType());
+
+        /*
+         * Object types not present in metadata are processed at the end.
+         */
+
+        size_t idx = (it == layerIndex.end()) ? layers.size() : it->second;
+
+        layerObjects[idx].push_back(obj.second);
+    }
+
+    for (const auto &objects: layerObjects)
+    {
+        std::vector<std::shared_ptr<SaiObj>> precompute;
+
+        for (const auto &obj: objects)
+        {
+            if (obj->oidObject &&
+                    obj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED &&
+                    cyclic.find(obj->getObjectType()) == cyclic.end())
+            {
+                precompute.push_back(obj);
+            }
+        }
+
+        precomputeCandidateObjects(current, temp, precompute);
+
+        for (const auto &obj: objects)
+        {
+            processObjectForViewTransition(current, temp, obj);
+        }
+
+        g_precomputedCandidates.clear();
+    }
+
+    /*
+     * There is a problem here with default trap group, since when other trap
+     * groups are created and used in traps, then when removing them we reset
+     * trap group on traps to default one, and this increases reference count
+     * so in this loop, default trap group will not be considered to be removed
+     * and it will stay not processed since it will hold reference count on
+     * traps. So what we can do here, we can explicitly move default trap group
+     * to FINAL state if it's not defined in temporary view, but this problem
+     * should go away when we will put all existing objects to temporary view
+     * if they don't exist.
+     *
+     * Similar thing can happen when we start using PROFILE_ID on
+     * SCHEDULER_GROUP.
+     */
+
+    bringDefaultTrapGroupToFinalState(current, temp);
+
+    SWSS_LOG_NOTICE("heuristic selected %zu objects, estimated operations: %zu, with random selection: %.1f",
+            g_heuristicSelections,
+            g_heuristicSelectedCost,
+            g_heuristicRandomCost);
+
+    SWSS_LOG_NOTICE("objects matched by content hash: %zu of %zu", g_contentHashMatches, temp.soAll.size());
+
+    /*
+     * Removing needs to be done from leaf with no references, after object is
+     * removed, objects it was referencing may have zero references, so they
+     * are put on worklist. Objects are taken from worklist in order of their
+     * id, so removal order is deterministic.
+     */
+
+    return removeNotProcessedObjects(current, temp);
+}/*}}}*/
+
+void executeOperationsOnAsic(
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView);
+
+void populateExistingObjects(/*{{{*/
+        _In_ AsicView &currentView,
+        _In_ AsicView &temporaryView,
+        _In_ const std::set<sai_object_id_t> rids)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * If some objects that are existing objects on switch are not present in
+     * temporary view, just populate them with empty values.  Since vid2rid
+     * maps must match on both view after apply view.
+     */
+
+    for (const auto rid: rids)
+    {
+        if (rid == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        /*
+         * Rid's are not matched yet, but if VID is the same then we have the
+         * same object.
+         */
+
+        if (temporaryView.hasRid(rid))
+        {
+            continue;
+        }
+
+        auto it = currentView.ridToVid.find(rid);
+
+        if (it == currentView.ridToVid.end())
+        {
+            SWSS_LOG_ERROR("unable to find existing object RID 0x%lx in current view", rid);
+
+            throw std::runtime_error("unable to find existing object RID in current view");
+        }
+
+        sai_object_id_t vid = it->second;
+
+        temporaryView.createDummy(rid, vid);
+
+        SWSS_LOG_DEBUG("populate existing RID/VID 0x%lx 0x%lx", rid, vid);
+
+        /*
+         * Move both objects to matched state since match oids was already
+         * called, and here we created some new objects that should be matched.
+         */
+
+        currentView.oOids.at(vid)->setObjectStatus(SAI_OBJECT_STATUS_MATCHED);
+        temporaryView.oOids.at(vid)->setObjectStatus(SAI_OBJECT_STATUS_MATCHED);
+    }
+}/*}}}*/
+
+/*
+ * Prefix of keys where new ASIC view is written before it's swapped with
+ * current ASIC view. It must not match ASIC_STATE and TEMP_ASIC_STATE keys.
+ */
+
+#define STAGING_PREFIX "STAGING_"
+
+/*
+ * Maximum number of keys in single DEL command when old view and staging
+ * leftovers are removed.
+ */
+
+#define REDIS_DEL_CHUNK 512
+
+/**
+ * @brief Remove keys using pipelined DEL commands.
+ *
+ * Keys are passed explicitly in each command, nothing is enumerated on redis
+ * side.
+ *
+ * @return Number of removed keys.
+ */
+static long long redisDelKeys(/*{{{*/
+        _In_ RedisPipeline &pipeline,
+        _In_ const std::vector<std::string> &keys)
+{
+    SWSS_LOG_ENTER();
+
+    long long removed = 0;
+
+    for (size_t idx = 0; idx < keys.size(); idx += REDIS_DEL_CHUNK)
+    {
+        std::vector<std::string> args = { "DEL" };
+
+        args.insert(args.end(),
+                keys.begin() + idx,
+                keys.begin() + std::min(keys.size(), idx + REDIS_DEL_CHUNK));
+
+        pipeline.push(args, [&](const redisReply *reply)
+        {
+            if (reply->type == REDIS_REPLY_INTEGER)
+            {
+                removed += reply->integer;
+            }
+        });
+    }
+
+    pipeline.flush();
+
+    return removed;
+}/*}}}*/
+
+/**
+ * @brief Collect keys matching given prefix using SCAN.
+ */
+static void redisScanKeysWithPrefix(/*{{{*/
+        _In_ RedisPipeline &pipeline,
+        _In_ const std::string &prefix,
+        _Inout_ std::vector<std::string> &keys)
+{
+    SWSS_LOG_ENTER();
+
+    pipeline.scanKeys(prefix + "*", [&](const std::vector<std::string> &batch)
+    {
+        keys.insert(keys.end(), batch.begin(), batch.end());
+    });
+}/*}}}*/
+
+/*
+ * Maximum number of field value pairs in single HMSET of VIDTORID/RIDTOVID
+ * maps.
+ */
+
+#define REDIS_MAP_HMSET_CHUNK 512
+
+void updateRedisDatabase(/*{{{*/
+        _In_ const AsicView &currentView,
+        _In_ const AsicView &temporaryView)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER("redis update");
+
+    /*
+     * New view is first written to staging keys using pipeline, which is
+     * limiting number of round trips to redis, and then in single MULTI/EXEC
+     * transaction previous ASIC_STATE and TEMP_ASIC_STATE are removed and
+     * staging keys are renamed to ASIC_STATE, so there is no moment when
+     * redis database contains partial view.
+     */
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    RedisPipeline pipeline(&db);
 
-                removeExistingObjectFromCurrentView(currentView, temporaryView, currentBestMatch);
-                break;
+    const std::string asicStatePrefix = ASIC_STATE_TABLE + std::string(":");
+    const std::string tempAsicStatePrefix = TEMP_PREFIX + asicStatePrefix;
+    const std::string stagingAsicStatePrefix = STAGING_PREFIX + asicStatePrefix;
 
-            default:
+    const std::string stagingVidToRid = STAGING_PREFIX VIDTORID;
+    const std::string stagingRidToVid = STAGING_PREFIX RIDTOVID;
 
-                /*
-                 * Later on if we decide we want to remove objects before
-                 * creating new one's we need to put here this action, or just
-                 * remove this entire switch and call remove.
-                 */
+    std::vector<std::string> staleKeys;
 
-                break;
-        }
+    redisScanKeysWithPrefix(pipeline, stagingAsicStatePrefix, staleKeys);
 
-        createNewObjectFromTemporaryObject(currentView, temporaryView, temporaryObj);
+    staleKeys.push_back(stagingVidToRid);
+    staleKeys.push_back(stagingRidToVid);
 
-        return;
+    long long cleared = redisDelKeys(pipeline, staleKeys);
+
+    if (cleared != 0)
+    {
+        SWSS_LOG_WARN("removed %lld staging keys left by previous apply view", cleared);
     }
 
     /*
-     * First pass was successfull, so we can do update on current object, lets do that now!
+     * Save temporary view as staging view in redis database.
      */
 
-    if (temporaryObj->oidObject && (temporaryObj->getObjectStatus() != SAI_OBJECT_STATUS_MATCHED))
+    for (const auto &pair: temporaryView.soAll)
     {
-        /*
-         * We track all oid object references, and since this objest was
-         * matched we need to insert it's vid to reference map since when we
-         * will update attributes in current view from temporary view
-         * attributes, then this object must be in reference map. This is
-         * sanity check. Object can't be in matched state since matched objects
-         * have the same RID and VID in both views, so VID already exists in
-         * reference map.
-         *
-         * This object VID will be remapped inside UpdateObjectStatus to
-         * rid/vid map since if we are here then we matched one of current
-         * objects to this temporary obejct and update can be performed.
-         */
+        const auto &obj = pair.second;
 
-        // TODO this is temporary VID, it's not available in current view
-        // so we need to remove this code here, since we will translate
-        // this VID in temporary view to current view
+        const auto &attr = obj->getAllAttributes();
 
-        sai_object_id_t vid = temporaryObj->getVid();
+        std::vector<std::string> args = { "HMSET", stagingAsicStatePrefix + obj->getStrObjectType() + ":" + obj->str_object_id };
 
-        currentView.insertNewVidReference(vid);
-    }
+        SWSS_LOG_DEBUG("setting key %s", args[1].c_str());
 
-    performObjectSetTransition(currentView, temporaryView, currentBestMatch, temporaryObj, true);
+        if (attr.size() == 0)
+        {
+            /*
+             * Object has no attributes, so populate using NULL just to
+             * indicate that object exists.
+             */
 
-    /*
-     * Since we got here, that means matching or updating current best match
-     * object was successful, and we can now set their state to final.
-     */
+            args.push_back("NULL");
+            args.push_back("NULL");
+        }
+        else
+        {
+            for (const auto &ap: attr)
+            {
+                const auto saiAttr = ap.second;
 
-    UpdateObjectStatus(currentView, temporaryView, currentBestMatch, temporaryObj);
-}/*}}}*/
+                args.push_back(saiAttr->getStrAttrId());
+                args.push_back(saiAttr->getStrAttrValue());
+            }
+        }
 
-void processObjectType(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView,
-        _In_ sai_object_type_t object_type)
-{
-    SWSS_LOG_ENTER();
+        pipeline.push(args);
+    }
 
-    auto objects = temporaryView.getObjectsByObjectType(object_type);
+    /*
+     * Save new RID2VID maps as staging maps.
+     */
 
-    for (const auto &o: objects)
+    std::vector<std::string> vidToRidArgs;
+    std::vector<std::string> ridToVidArgs;
+
+    for (auto &kv: temporaryView.ridToVid)
     {
-        processObjectForViewTransition(currentView, temporaryView, o);
-    }
+        if (vidToRidArgs.empty())
+        {
+            vidToRidArgs = { "HMSET", stagingVidToRid };
+            ridToVidArgs = { "HMSET", stagingRidToVid };
+        }
 
-    SWSS_LOG_NOTICE("processed %s", sai_serialize_object_type(object_type).c_str());
-}/*}}}*/
+        std::string strVid = sai_serialize_object_id(kv.second);
+        std::string strRid = sai_serialize_object_id(kv.first);
 
-void checkSwitch(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView)
-{
-    SWSS_LOG_ENTER();
+        vidToRidArgs.push_back(strVid);
+        vidToRidArgs.push_back(strRid);
 
-    size_t csize = currentView.soSwitches.size();
-    size_t tsize = temporaryView.soSwitches.size();
+        ridToVidArgs.push_back(strRid);
+        ridToVidArgs.push_back(strVid);
 
-    if (csize == 0 && tsize == 0)
-    {
-        return;
+        if (vidToRidArgs.size() >= 2 + 2 * REDIS_MAP_HMSET_CHUNK)
+        {
+            pipeline.push(vidToRidArgs);
+            pipeline.push(ridToVidArgs);
+
+            vidToRidArgs.clear();
+            ridToVidArgs.clear();
+        }
     }
 
-    if (csize == 1 && tsize == 1)
+    if (!vidToRidArgs.empty())
     {
-        return;
+        pipeline.push(vidToRidArgs);
+        pipeline.push(ridToVidArgs);
     }
 
-    /*
-     * Current logic supports only 1 instance of switch so in both views we
-     * should have only 1 instance of switch and they must match.
-     */
-
-    SWSS_LOG_ERROR("unsupported number of switches: current %zu, temp %zu", csize, tsize);
-
-    throw std::runtime_error("unsupported number of switches");
+    pipeline.flush();
 
     /*
-     * In current SAI 0.9.4 switch is non object id so we don't need to make
-     * VID/RID for it, but in SAI 1.0 it will be object id so we need to change
-     * our strategy here.
+     * Swap staging view with current view.
      *
-     * Later on we can support in 0.9.4 case where one or both switches can be
-     * missing since no attributes were set.
+     * Old keys are collected using SCAN before transaction starts, this is
+     * safe since only syncd is writing ASIC_STATE keys and it's holding
+     * g_mutex during apply view. Then all DEL and RENAME commands with
+     * explicit key names are queued in single MULTI/EXEC transaction, which
+     * is pipelined in batches, so number of round trips is bounded by
+     * number of commands divided by batch size.
+     *
+     * Redis is not rolling back transaction when one of the commands fails
+     * on EXEC, so everything which could fail is checked before: staging
+     * keys are watched and then their existence is confirmed, so RENAME can't
+     * fail on missing key, and if any of staging keys is modified after that,
+     * EXEC is aborted without executing any command. Queued replies are
+     * read before EXEC is sent and transaction is discarded on error, so
+     * current view is never removed unless entire new view is renamed in
+     * it's place.
      */
-}/*}}}*/
-
-void bringDefaultTrapGroupToFinalState(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView)
-{
-    SWSS_LOG_ENTER();
 
-    sai_object_id_t rid = currentView.defaultTrapGroupRid;
+    std::vector<std::string> stagingKeys;
 
-    if (temporaryView.hasRid(rid))
+    for (const auto &pair: temporaryView.soAll)
     {
-        /*
-         * Default trap group is defined inside temporary view
-         * so it will be matched by RID, no need to process.
-         */
+        const auto &obj = pair.second;
 
-        return;
+        stagingKeys.push_back(stagingAsicStatePrefix + obj->getStrObjectType() + ":" + obj->str_object_id);
     }
 
-    sai_object_id_t vid = currentView.ridToVid.at(rid);
+    if (!temporaryView.ridToVid.empty())
+    {
+        stagingKeys.push_back(stagingVidToRid);
+        stagingKeys.push_back(stagingRidToVid);
+    }
 
-    auto const &dtgObj = currentView.oOids.at(vid);
+    long long existing = 0;
 
-    if (dtgObj->getObjectStatus() != SAI_OBJECT_STATUS_NOT_PROCESSED)
+    for (size_t idx = 0; idx < stagingKeys.size(); idx += REDIS_DEL_CHUNK)
     {
-        /*
-         * Object was processed, no further actions are required.
-         */
+        auto begin = stagingKeys.begin() + idx;
+        auto end = stagingKeys.begin() + std::min(stagingKeys.size(), idx + REDIS_DEL_CHUNK);
 
-        return;
-    }
+        std::vector<std::string> args = { "WATCH" };
 
-    /*
-     * Trap group was not processed, it can't be removed so bring it to default
-     * state and release existing references.
-     */
+        args.insert(args.end(), begin, end);
 
-    bringNonRemovableObjectToDefaultState(currentView, temporaryView, dtgObj);
-}/*}}}*/
+        pipeline.push(args);
+    }
 
-sai_status_t applyViewTransition(/*{{{*/
-        _In_ AsicView &current,
-        _In_ AsicView &temp)
-{
-    SWSS_LOG_ENTER();
+    for (size_t idx = 0; idx < stagingKeys.size(); idx += REDIS_DEL_CHUNK)
+    {
+        auto begin = stagingKeys.begin() + idx;
+        auto end = stagingKeys.begin() + std::min(stagingKeys.size(), idx + REDIS_DEL_CHUNK);
 
-    checkSwitch(current, temp);
+        std::vector<std::string> args = { "EXISTS" };
 
-    checkMatchedPorts(temp);
+        args.insert(args.end(), begin, end);
 
-    /*
-     * Process all objects
-     */
+        pipeline.push(args, [&](const redisReply *reply)
+        {
+            if (reply->type == REDIS_REPLY_INTEGER)
+            {
+                existing += reply->integer;
+            }
+        });
+    }
 
-    /*
-     * During iteration no object from temp view are removed, so no need to
-     * worry about any iterator issues here since removed objects are only from
-     * current view.
-     */
+    pipeline.flush();
 
-    for (auto &obj: temp.soAll)
+    if ((size_t)existing != stagingKeys.size())
     {
-        processObjectForViewTransition(current, temp, obj.second);
+        pipeline.push({ "UNWATCH" });
+
+        pipeline.flush();
+
+        SWSS_LOG_ERROR("only %lld of %zu staging keys exist, current view was not modified",
+                existing,
+                stagingKeys.size());
+
+        throw std::runtime_error("staging view is not complete");
     }
 
-    /*
-     * There is a problem here with default trap group, since when other trap
-     * groups are created and used in traps, then when removing them we reset
-     * trap group on traps to default one, and this increases reference count
-     * so in this loop, default trap group will not be considered to be removed
-     * and it will stay not processed since it will hold reference count on
-     * traps. So what we can do here, we can explicitly move default trap group
-     * to FINAL state if it's not defined in temporary view, but this problem
-     * should go away when we will put all existing objects to temporary view
-     * if they don't exist.
-     *
-     * Similar thing can happen when we start using PROFILE_ID on
-     * SCHEDULER_GROUP.
-     */
+    std::vector<std::string> oldKeys;
 
-    bringDefaultTrapGroupToFinalState(current, temp);
+    redisScanKeysWithPrefix(pipeline, asicStatePrefix, oldKeys);
+    redisScanKeysWithPrefix(pipeline, tempAsicStatePrefix, oldKeys);
+
+    oldKeys.push_back(VIDTORID);
+    oldKeys.push_back(RIDTOVID);
 
     /*
-     * Removing needs to be done from leaf with no references and it can be
-     * multiple passes since if in first pass object had non zero references,
-     * it can have zero in next pass so it is safe to remove.
+     * Pipeline throws on error reply after all replies of the batch are
+     * read, so error of any queued command ends up here before EXEC is sent.
      */
 
-    for (int removed = 1; removed != 0 ;)
+    try
     {
-        removed = 0;
+        pipeline.push({ "MULTI" });
 
-        for (const auto &obj: current.getAllNotProcessedObjects())
+        for (size_t idx = 0; idx < oldKeys.size(); idx += REDIS_DEL_CHUNK)
         {
-            /*
-             * What can happen during this processing some object state during
-             * processing can change from not processed to removed, if it have
-             * references, currently we are only removing objects with zero
-             * references, so this will not happen but in general case this
-             * will be the case.
-             */
-
-            if (obj->oidObject)
-            {
-                if (current.getVidReferenceCount(obj->getVid()) == 0)
-                {
-                    /*
-                     * Reference count on this VID is zero, so it's safe to
-                     * remove this object.
-                     */
+            std::vector<std::string> args = { "DEL" };
 
-                    removeExistingObjectFromCurrentView(current, temp, obj);
-                    removed++;
-                }
-            }
-            else
-            {
-                /*
-                 * Non object id objects don't have references count, they are leafs
-                 * so we can remove them right away
-                 */
+            args.insert(args.end(),
+                    oldKeys.begin() + idx,
+                    oldKeys.begin() + std::min(oldKeys.size(), idx + REDIS_DEL_CHUNK));
 
-                removeExistingObjectFromCurrentView(current, temp, obj);
-                removed++;
-            }
+            pipeline.push(args);
         }
 
-        SWSS_LOG_NOTICE("- loop removed (%d)", removed);
-    }
-
-    return SAI_STATUS_SUCCESS;
-}/*}}}*/
-
-void executeOperationsOnAsic(
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView);
+        for (const auto &pair: temporaryView.soAll)
+        {
+            const auto &obj = pair.second;
 
-void populateExistingObjects(/*{{{*/
-        _In_ AsicView &currentView,
-        _In_ AsicView &temporaryView,
-        _In_ const std::set<sai_object_id_t> rids)
-{
-    SWSS_LOG_ENTER();
+            std::string key = obj->getStrObjectType() + ":" + obj->str_object_id;
 
-    /*
-     * If some objects that are existing objects on switch are not present in
-     * temporary view, just populate them with empty values.  Since vid2rid
-     * maps must match on both view after apply view.
-     */
+            pipeline.push({ "RENAME", stagingAsicStatePrefix + key, asicStatePrefix + key });
+        }
 
-    for (const auto rid: rids)
-    {
-        if (rid == SAI_NULL_OBJECT_ID)
+        if (!temporaryView.ridToVid.empty())
         {
-            continue;
+            pipeline.push({ "RENAME", stagingVidToRid, VIDTORID });
+            pipeline.push({ "RENAME", stagingRidToVid, RIDTOVID });
         }
 
-        /*
-         * Rid's are not matched yet, but if VID is the same then we have the
-         * same object.
-         */
+        pipeline.flush();
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("failed to queue transaction: %s, discarding, current view was not modified", e.what());
 
-        if (temporaryView.hasRid(rid))
+        try
         {
-            continue;
+            pipeline.push({ "DISCARD" });
+
+            pipeline.flush();
         }
+        catch (const std::exception &)
+        {
+            /*
+             * Transaction is also discarded by redis when connection is
+             * closed.
+             */
 
-        auto it = currentView.ridToVid.find(rid);
+            SWSS_LOG_WARN("failed to discard transaction");
+        }
 
-        if (it == currentView.ridToVid.end())
+        throw;
+    }
+
+    size_t renamed = 0;
+
+    pipeline.push({ "EXEC" }, [&](const redisReply *reply)
+    {
+        if (reply->type == REDIS_REPLY_NIL)
         {
-            SWSS_LOG_ERROR("unable to find existing object RID 0x%lx in current view", rid);
+            SWSS_LOG_ERROR("staging keys were modified, transaction aborted, current view was not modified");
 
-            throw std::runtime_error("unable to find existing object RID in current view");
+            throw std::runtime_error("redis transaction was aborted");
         }
 
-        sai_object_id_t vid = it->second;
+        if (reply->type != REDIS_REPLY_ARRAY)
+        {
+            throw std::runtime_error("redis transaction was aborted");
+        }
+
+        for (size_t idx = 0; idx < reply->elements; ++idx)
+        {
+            const redisReply *r = reply->element[idx];
+
+            if (r->type == REDIS_REPLY_ERROR)
+            {
+                SWSS_LOG_ERROR("command %zu in transaction failed: %s", idx, r->str);
 
-        temporaryView.createDummy(rid, vid);
+                throw std::runtime_error("redis transaction command failed");
+            }
 
-        SWSS_LOG_DEBUG("populate existing RID/VID 0x%lx 0x%lx", rid, vid);
+            if (r->type == REDIS_REPLY_STATUS)
+            {
+                renamed++;
+            }
+        }
+    });
 
-        /*
-         * Move both objects to matched state since match oids was already
-         * called, and here we created some new objects that should be matched.
-         */
+    pipeline.flush();
 
-        currentView.oOids.at(vid)->setObjectStatus(SAI_OBJECT_STATUS_MATCHED);
-        temporaryView.oOids.at(vid)->setObjectStatus(SAI_OBJECT_STATUS_MATCHED);
-    }
+    SWSS_LOG_NOTICE("updated redis database, %zu keys renamed, %zu commands in %zu round trips",
+            renamed,
+            pipeline.getCommandsCount(),
+            pipeline.getRoundTrips());
 }/*}}}*/
 
-void updateRedisDatabase(/*{{{*/
-        _In_ const AsicView &currentView,
-        _In_ const AsicView &temporaryView)
+typedef std::vector<std::pair<std::string, double>> ApplyViewPhaseTimes;
+
+/**
+ * @brief Log apply view report.
+ *
+ * Report contains number of create/set/remove operations per object type
+ * generated by view transition, time spent in each phase and size of both
+ * views. Report is also returned as field values, which are sent back to
+ * sairedis in notify syncd response.
+ */
+void logApplyViewReport(/*{{{*/
+        _In_ const AsicView &current,
+        _In_ const ApplyViewPhaseTimes &phases,
+        _In_ size_t currentViewSize,
+        _In_ size_t temporaryViewSize,
+        _In_ bool dryRun,
+        _Out_ std::vector<swss::FieldValueTuple> &report)
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * TODO we can make lua script for this which will be much faster.
-     */
-
-    SWSS_LOG_TIMER("redis update");
+    std::map<std::string, std::map<std::string, size_t>> ops;
 
-    /*
-     * Remove Asic State Table
-     */
+    for (const auto &op: current.asicGetOperations())
+    {
+        ops[op->getObj()->getStrObjectType()][op->getStrOp()]++;
+    }
 
-    const auto &asicStateKeys = g_redisClient->keys(ASIC_STATE_TABLE + std::string(":*"));
+    SWSS_LOG_NOTICE("apply view%s report: current view objects: %zu, temporary view objects: %zu, operations: %zu",
+            dryRun ? " dry run" : "",
+            currentViewSize,
+            temporaryViewSize,
+            current.asicGetOperationsCount());
 
-    for (const auto &key: asicStateKeys)
+    for (const auto &ot: ops)
     {
-        g_redisClient->del(key);
-    }
+        auto count = [&](const std::string &op) -> size_t
+        {
+            auto it = ot.second.find(op);
 
-    /*
-     * Remove Temp Asic State Table
-     */
+            return it == ot.second.end() ? 0 : it->second;
+        };
 
-    const auto &tempAsicStateKeys = g_redisClient->keys(TEMP_PREFIX ASIC_STATE_TABLE + std::string(":*"));
+        SWSS_LOG_NOTICE("- %s: create %zu, set %zu, remove %zu",
+                ot.first.c_str(),
+                count("create"),
+                count("set"),
+                count("remove"));
+    }
 
-    for (const auto &key: tempAsicStateKeys)
+    for (const auto &phase: phases)
     {
-        g_redisClient->del(key);
+        SWSS_LOG_NOTICE("- phase %s: %.3f s", phase.first.c_str(), phase.second);
     }
 
-    /*
-     * Save temporary view as current view in redis database.
-     */
-
-    for (const auto &pair: temporaryView.soAll)
-    {
-        const auto &obj = pair.second;
+    struct rusage usage;
 
-        const auto &attr = obj->getAllAttributes();
+    long peakRss = (getrusage(RUSAGE_SELF, &usage) == 0) ? usage.ru_maxrss : 0;
 
-        std::string key = std::string(ASIC_STATE_TABLE) + ":" + obj->str_object_type + ":" + obj->str_object_id;
+    SWSS_LOG_NOTICE("- peak RSS: %ld kB", peakRss);
 
-        SWSS_LOG_DEBUG("setting key %s", key.c_str());
+    /*
+     * Report is not stored in redis, since dry run must not modify ASIC DB,
+     * tools like benchmark can get it from sairedis after notify syncd.
+     */
 
-        if (attr.size() == 0)
-        {
-            /*
-             * Object has no attributes, so populate using NULL just to
-             * indicate that object exists.
-             */
+    report = {
+        { "dry_run", dryRun ? "true" : "false" },
+        { "current_view_objects", std::to_string(currentViewSize) },
+        { "temporary_view_objects", std::to_string(temporaryViewSize) },
+        { "operations", std::to_string(current.asicGetOperationsCount()) },
+        { "peak_rss_kb", std::to_string(peakRss) } };
 
-            g_redisClient->hset(key, "NULL", "NULL");
-        }
-        else
+    for (const auto &ot: ops)
+    {
+        for (const auto &op: ot.second)
         {
-            for (const auto &ap: attr)
-            {
-                const auto saiAttr = ap.second;
-
-                g_redisClient->hset(key, saiAttr->getStrAttrId(), saiAttr->getStrAttrValue());
-            }
+            report.emplace_back("op:" + ot.first + ":" + op.first, std::to_string(op.second));
         }
     }
 
-    /*
-     * Remove previous RID2VID maps and apply new map.
-     */
-
-    redisClearVidToRidMap();
-    redisClearRidToVidMap();
-
-    for (auto &kv: temporaryView.ridToVid)
+    for (const auto &phase: phases)
     {
-        std::string strVid = sai_serialize_object_id(kv.second);
-        std::string strRid = sai_serialize_object_id(kv.first);
-
-        g_redisClient->hset(VIDTORID, strVid, strRid);
-        g_redisClient->hset(RIDTOVID, strRid, strVid);
+        report.emplace_back("phase:" + phase.first, std::to_string(phase.second));
     }
-
-    SWSS_LOG_NOTICE("updated redis database");
 }/*}}}*/
 
-sai_status_t internalSyncdApplyView()/*{{{*/
+sai_status_t internalSyncdApplyView(/*{{{*/
+        _In_ bool dryRun,
+        _Out_ std::vector<swss::FieldValueTuple> &report)
 {
     sai_status_t status;
 
@@ -4858,6 +6721,19 @@ sai_status_t internalSyncdApplyView()/*{{{*/
 
     std::srand((unsigned int)std::time(0));
 
+    ApplyViewPhaseTimes phases;
+
+    auto phaseStart = std::chrono::steady_clock::now();
+
+    auto phaseEnd = [&](const std::string &name)
+    {
+        auto now = std::chrono::steady_clock::now();
+
+        phases.push_back(std::make_pair(name, std::chrono::duration<double>(now - phaseStart).count()));
+
+        phaseStart = now;
+    };
+
     AsicView current;
     AsicView temp;
 
@@ -4883,11 +6759,49 @@ sai_status_t internalSyncdApplyView()/*{{{*/
     temp.defaultStpInstanceRid      = current.defaultStpInstanceRid;
 
     /*
-     * Read current and temporary view from REDIS.
+     * Read current and temporary view from REDIS, both views are read at the
+     * same time on separate connections.
      */
 
-    redisGetAsicView(ASIC_STATE_TABLE, current);
-    redisGetAsicView(TEMP_PREFIX ASIC_STATE_TABLE, temp);
+    std::exception_ptr tempError;
+
+    std::thread tempThread([&]()
+    {
+        try
+        {
+            redisGetAsicView(TEMP_PREFIX ASIC_STATE_TABLE, temp);
+        }
+        catch (...)
+        {
+            tempError = std::current_exception();
+        }
+    });
+
+    try
+    {
+        redisGetAsicView(ASIC_STATE_TABLE, current);
+    }
+    catch (...)
+    {
+        tempThread.join();
+
+        throw;
+    }
+
+    tempThread.join();
+
+    if (tempError)
+    {
+        std::rethrow_exception(tempError);
+    }
+
+    size_t currentViewSize = current.soAll.size();
+    size_t temporaryViewSize = temp.soAll.size();
+
+    phaseEnd("read views");
+
+    current.logMemoryUsage("current");
+    temp.logMemoryUsage("temporary");
 
     std::set<sai_object_id_t> existingObjects;
 
@@ -4916,8 +6830,12 @@ sai_status_t internalSyncdApplyView()/*{{{*/
     populateExistingObjects(current, temp, g_defaultSchedulerGroupsRids);
     populateExistingObjects(current, temp, g_defaultPortsRids);
 
+    phaseEnd("match existing objects");
+
     status = applyViewTransition(current, temp);
 
+    phaseEnd("view transition");
+
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("apply view transition failed: %s", sai_serialize_status(status).c_str());
@@ -4991,14 +6909,34 @@ sai_status_t internalSyncdApplyView()/*{{{*/
         return SAI_STATUS_FAILURE;
     }
 
+    phaseEnd("check views");
+
+    current.logMemoryUsage("current");
+    temp.logMemoryUsage("temporary");
+
+    if (dryRun)
+    {
+        logApplyViewReport(current, phases, currentViewSize, temporaryViewSize, dryRun, report);
+
+        return status;
+    }
+
     executeOperationsOnAsic(current, temp);
 
+    phaseEnd("asic apply");
+
     updateRedisDatabase(current, temp);
 
+    phaseEnd("redis update");
+
+    logApplyViewReport(current, phases, currentViewSize, temporaryViewSize, dryRun, report);
+
     return status;
 }/*}}}*/
 
-sai_status_t syncdApplyView()/*{{{*/
+sai_status_t internalSyncdApplyViewWithTimer(/*{{{*/
+        _In_ bool dryRun,
+        _Out_ std::vector<swss::FieldValueTuple> &report)
 {
     SWSS_LOG_ENTER();
 
@@ -5011,7 +6949,7 @@ sai_status_t syncdApplyView()/*{{{*/
 
         try
         {
-            status = internalSyncdApplyView();
+            status = internalSyncdApplyView(dryRun, report);
         }
         catch (const std::runtime_error &e)
         {
@@ -5026,6 +6964,29 @@ sai_status_t syncdApplyView()/*{{{*/
     return status;
 }/*}}}*/
 
+sai_status_t syncdApplyView(/*{{{*/
+        _Out_ std::vector<swss::FieldValueTuple> &report)
+{
+    SWSS_LOG_ENTER();
+
+    return internalSyncdApplyViewWithTimer(false, report);
+}/*}}}*/
+
+/**
+ * @brief Perform apply view without executing operations.
+ *
+ * Current and temporary view are read from redis and compared, and report
+ * of operations which would be executed is logged and returned. ASIC and
+ * redis database are not modified.
+ */
+sai_status_t syncdApplyViewDryRun(/*{{{*/
+        _Out_ std::vector<swss::FieldValueTuple> &report)
+{
+    SWSS_LOG_ENTER();
+
+    return internalSyncdApplyViewWithTimer(true, report);
+}/*}}}*/
+
 /*
  * Below we will duplicate asic execution logic for asic operations.
  *
@@ -5173,19 +7134,94 @@ void asic_translate_vid_to_rid_list(/*{{{*/
     }
 }/*}}}*/
 
+/**
+ * @brief Attribute list passed to ASIC.
+ *
+ * Attributes are copied from in-memory SaiAttr values, and object id lists
+ * are copied to local buffers since they will be translated to RIDs in place
+ * and view attributes must still hold VIDs.
+ */
+class AsicAttributeList
+{
+    public:
+
+        AsicAttributeList(/*{{{*/
+                _In_ const AsicView &current,
+                _In_ const AsicView &temporary,
+                _In_ sai_object_type_t object_type,
+                _In_ const std::vector<std::shared_ptr<SaiAttr>> &attrs)
+        {
+            SWSS_LOG_ENTER();
+
+            m_lists.reserve(attrs.size());
+
+            for (const auto &a: attrs)
+            {
+                sai_attribute_t attr = *a->getSaiAttr();
+
+                switch (a->getAttrMetadata()->serializationtype)
+                {
+                    case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
+                        copyList(attr.value.objlist);
+                        break;
+
+                    case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+                        copyList(attr.value.aclfield.data.objlist);
+                        break;
+
+                    case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+                        copyList(attr.value.aclaction.parameter.objlist);
+                        break;
+
+                    default:
+                        break;
+                }
+
+                m_attrs.push_back(attr);
+            }
+
+            asic_translate_vid_to_rid_list(current, temporary, object_type, getAttrCount(), getAttrList());
+        }/*}}}*/
+
+        sai_attribute_t* getAttrList()/*{{{*/
+        {
+            return m_attrs.data();
+        }/*}}}*/
+
+        uint32_t getAttrCount() const/*{{{*/
+        {
+            return (uint32_t)m_attrs.size();
+        }/*}}}*/
+
+    private:
+
+        void copyList(/*{{{*/
+                _Inout_ sai_object_list_t &list)
+        {
+            SWSS_LOG_ENTER();
+
+            m_lists.emplace_back(list.list, list.list + list.count);
+
+            list.list = m_lists.back().data();
+        }/*}}}*/
+
+        std::vector<sai_attribute_t> m_attrs;
+
+        std::vector<std::vector<sai_object_id_t>> m_lists;
+};
+
 sai_status_t asic_handle_generic(/*{{{*/
         _In_ AsicView &current,
         _In_ AsicView &temporary,
-        _In_ sai_object_type_t object_type,
-        _In_ const std::string &str_object_id,
+        _In_ const sai_object_meta_key_t &meta_key,
         _In_ sai_common_api_t api,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t object_id;
-    sai_deserialize_object_id(str_object_id, object_id);
+    sai_object_type_t object_type = meta_key.object_type;
+    sai_object_id_t object_id = meta_key.key.object_id;
 
     SWSS_LOG_DEBUG("common generic api: %d", api);
 
@@ -5208,10 +7244,7 @@ sai_status_t asic_handle_generic(/*{{{*/
                     temporary.ridToVid[real_object_id] = object_id;
                     temporary.vidToRid[object_id] = real_object_id;
 
-                    std::string str_vid = sai_serialize_object_id(object_id);
-                    std::string str_rid = sai_serialize_object_id(real_object_id);
-
-                    SWSS_LOG_INFO("saved VID %s to RID %s", str_vid.c_str(), str_rid.c_str());
+                    SWSS_LOG_INFO("saved VID 0x%lx to RID 0x%lx", object_id, real_object_id);
                 }
                 else
                 {
@@ -5231,9 +7264,6 @@ sai_status_t asic_handle_generic(/*{{{*/
 
                 sai_object_id_t rid = asic_translate_vid_to_rid(current, temporary, object_id);
 
-                std::string str_vid = sai_serialize_object_id(object_id);
-                std::string str_rid = sai_serialize_object_id(rid);
-
                 /*
                  * Since object was removed, then we also need to remove it
                  * from removedVidToRid map jsut in case if there is some bug.
@@ -5264,15 +7294,14 @@ sai_status_t asic_handle_generic(/*{{{*/
 sai_status_t asic_handle_fdb(/*{{{*/
         _In_ const AsicView &current,
         _In_ const AsicView &temporary,
-        _In_ const std::string &str_object_id,
+        _In_ const sai_object_meta_key_t &meta_key,
         _In_ sai_common_api_t api,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
 {
     SWSS_LOG_ENTER();
 
-    sai_fdb_entry_t fdb_entry;
-    sai_deserialize_fdb_entry(str_object_id, fdb_entry);
+    sai_fdb_entry_t fdb_entry = meta_key.key.fdb_entry;
 
     switch (api)
     {
@@ -5294,7 +7323,7 @@ sai_status_t asic_handle_fdb(/*{{{*/
 sai_status_t asic_handle_switch(/*{{{*/
         _In_ const AsicView &current,
         _In_ const AsicView &temporary,
-        _In_ const std::string &str_object_id,
+        _In_ const sai_object_meta_key_t &meta_key,
         _In_ sai_common_api_t api,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
@@ -5315,20 +7344,17 @@ sai_status_t asic_handle_switch(/*{{{*/
 sai_status_t asic_handle_neighbor(/*{{{*/
         _In_ const AsicView &current,
         _In_ const AsicView &temporary,
-        _In_ const std::string &str_object_id,
+        _In_ const sai_object_meta_key_t &meta_key,
         _In_ sai_common_api_t api,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
 {
     SWSS_LOG_ENTER();
 
-    sai_neighbor_entry_t neighbor_entry;
-    sai_deserialize_neighbor_entry(str_object_id, neighbor_entry);
+    sai_neighbor_entry_t neighbor_entry = meta_key.key.neighbor_entry;
 
     neighbor_entry.rif_id = asic_translate_vid_to_rid(current, temporary, neighbor_entry.rif_id);
 
-    SWSS_LOG_DEBUG("neighbor: %s", str_object_id.c_str());
-
     switch (api)
     {
         case SAI_COMMON_API_CREATE:
@@ -5349,20 +7375,17 @@ sai_status_t asic_handle_neighbor(/*{{{*/
 sai_status_t asic_handle_route(/*{{{*/
         _In_ const AsicView &current,
         _In_ const AsicView &temporary,
-        _In_ const std::string &str_object_id,
+        _In_ const sai_object_meta_key_t &meta_key,
         _In_ sai_common_api_t api,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
 {
     SWSS_LOG_ENTER();
 
-    sai_unicast_route_entry_t route_entry;
-    sai_deserialize_route_entry(str_object_id, route_entry);
+    sai_unicast_route_entry_t route_entry = meta_key.key.route_entry;
 
     route_entry.vr_id = asic_translate_vid_to_rid(current, temporary, route_entry.vr_id);
 
-    SWSS_LOG_DEBUG("route: %s", str_object_id.c_str());
-
     switch (api)
     {
         case SAI_COMMON_API_CREATE:
@@ -5383,15 +7406,14 @@ sai_status_t asic_handle_route(/*{{{*/
 sai_status_t asic_handle_vlan(/*{{{*/
         _In_ const AsicView &current,
         _In_ const AsicView &temporary,
-        _In_ const std::string &str_object_id,
+        _In_ const sai_object_meta_key_t &meta_key,
         _In_ sai_common_api_t api,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
 {
     SWSS_LOG_ENTER();
 
-    sai_vlan_id_t vlan_id;
-    sai_deserialize_vlan_id(str_object_id, vlan_id);
+    sai_vlan_id_t vlan_id = meta_key.key.vlan_id;
 
     switch (api)
     {
@@ -5413,15 +7435,14 @@ sai_status_t asic_handle_vlan(/*{{{*/
 sai_status_t asic_handle_trap(/*{{{*/
         _In_ const AsicView &current,
         _In_ const AsicView &temporary,
-        _In_ std::string &str_object_id,
+        _In_ const sai_object_meta_key_t &meta_key,
         _In_ sai_common_api_t api,
         _In_ uint32_t attr_count,
-        _In_ sai_attribute_t *attr_list)
+        _In_ const sai_attribute_t *attr_list)
 {
     SWSS_LOG_ENTER();
 
-    sai_hostif_trap_id_t trap_id;
-    sai_deserialize_hostif_trap_id(str_object_id, trap_id);
+    sai_hostif_trap_id_t trap_id = meta_key.key.trap_id;
 
     switch (api)
     {
@@ -5437,111 +7458,77 @@ sai_status_t asic_handle_trap(/*{{{*/
 sai_status_t asic_process_event(/*{{{*/
         _In_ AsicView &current,
         _In_ AsicView &temporary,
-        _In_ const swss::KeyOpFieldsValuesTuple &kco)
+        _In_ const AsicOperation &op,
+        _In_ AsicAttributeList &list)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * Ssince we have stored our keys in asic view, we can actually keep api
-     * type right away so we don't have to serialize and deserialize everything
-     * twice. We can take a look into that if update execution time will not be
-     * sufficient.
+     * Operation holds object and attributes directly from asic view, so there
+     * is no need to deserialize object key and attributes here.
      */
 
-    const std::string &key = kfvKey(kco);
-    const std::string &op = kfvOp(kco);
-
-    std::string str_object_type = key.substr(0, key.find(":"));
-    std::string str_object_id = key.substr(key.find(":") + 1);
-
-    SWSS_LOG_INFO("key: %s op: %s", key.c_str(), op.c_str());
-
-    sai_common_api_t api = SAI_COMMON_API_MAX;
-
-    if (op == "set")
-    {
-        /*
-         * Most common operation will probably be set so let put it first
-         */
-
-        api = SAI_COMMON_API_SET;
-    }
-    else if (op == "create")
-    {
-        api = SAI_COMMON_API_CREATE;
-    }
-    else if (op == "remove")
-    {
-        api = SAI_COMMON_API_REMOVE;
-    }
-    else
-    {
-        SWSS_LOG_ERROR("api %s is not implemented", op.c_str());
+    const auto &obj = op.getObj();
 
-        return SAI_STATUS_NOT_SUPPORTED;
-    }
+    sai_common_api_t api = op.getApi();
 
-    std::stringstream ss;
+    sai_object_type_t object_type = obj->getObjectType();
 
-    sai_object_type_t object_type;
-    sai_deserialize_object_type(str_object_type, object_type);
+    SWSS_LOG_INFO("key: %s op: %s", op.getStrKey().c_str(), op.getStrOp().c_str());
 
-    if (object_type >= SAI_OBJECT_TYPE_MAX)
+    if (object_type == SAI_OBJECT_TYPE_NULL || object_type >= SAI_OBJECT_TYPE_MAX)
     {
         SWSS_LOG_ERROR("undefined object type %d", object_type);
 
         return SAI_STATUS_NOT_SUPPORTED;
     }
 
-    const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(kco);
-
-    SaiAttributeList list(object_type, values, false);
-
-    sai_attribute_t *attr_list = list.get_attr_list();
-    uint32_t attr_count = list.get_attr_count();
-
-    asic_translate_vid_to_rid_list(current, temporary, object_type, attr_count, attr_list);
+    sai_attribute_t *attr_list = list.getAttrList();
+    uint32_t attr_count = list.getAttrCount();
 
     sai_status_t status;
 
     switch (object_type)
     {
         case SAI_OBJECT_TYPE_FDB:
-            status = asic_handle_fdb(current, temporary, str_object_id, api, attr_count, attr_list);
+            status = asic_handle_fdb(current, temporary, obj->meta_key, api, attr_count, attr_list);
             break;
 
         case SAI_OBJECT_TYPE_SWITCH:
-            status = asic_handle_switch(current, temporary, str_object_id, api, attr_count, attr_list);
+            status = asic_handle_switch(current, temporary, obj->meta_key, api, attr_count, attr_list);
             break;
 
         case SAI_OBJECT_TYPE_NEIGHBOR:
-            status = asic_handle_neighbor(current, temporary, str_object_id, api, attr_count, attr_list);
+            status = asic_handle_neighbor(current, temporary, obj->meta_key, api, attr_count, attr_list);
             break;
 
         case SAI_OBJECT_TYPE_ROUTE:
-            status = asic_handle_route(current, temporary, str_object_id, api, attr_count, attr_list);
+            status = asic_handle_route(current, temporary, obj->meta_key, api, attr_count, attr_list);
             break;
 
         case SAI_OBJECT_TYPE_VLAN:
-            status = asic_handle_vlan(current, temporary, str_object_id, api, attr_count, attr_list);
+            status = asic_handle_vlan(current, temporary, obj->meta_key, api, attr_count, attr_list);
             break;
 
         case SAI_OBJECT_TYPE_TRAP:
-            status = asic_handle_trap(current, temporary, str_object_id, api, attr_count, attr_list);
+            status = asic_handle_trap(current, temporary, obj->meta_key, api, attr_count, attr_list);
             break;
 
         default:
-            status = asic_handle_generic(current, temporary, object_type, str_object_id, api, attr_count, attr_list);
+            status = asic_handle_generic(current, temporary, obj->meta_key, api, attr_count, attr_list);
             break;
     }
 
     if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("failed to execute api: %s, key: %s, status: %s", op.c_str(), key.c_str(), sai_serialize_status(status).c_str());
+        SWSS_LOG_ERROR("failed to execute api: %s, key: %s, status: %s",
+                op.getStrOp().c_str(),
+                op.getStrKey().c_str(),
+                sai_serialize_status(status).c_str());
 
-        for (const auto &v: values)
+        for (const auto &attr: op.getAttrs())
         {
-            SWSS_LOG_ERROR("field: %s, value: %s", fvField(v).c_str(), fvValue(v).c_str());
+            SWSS_LOG_ERROR("field: %s, value: %s", attr->getStrAttrId().c_str(), attr->getStrAttrValue().c_str());
         }
 
         // asic here will be in inconsistent state
@@ -5552,6 +7539,90 @@ sai_status_t asic_process_event(/*{{{*/
     return status;
 }/*}}}*/
 
+/*
+ * Maximum number of operations executed in single bulk.
+ */
+
+#define ASIC_BULK_MAX_OPERATIONS 1024
+
+bool asic_can_bulk(/*{{{*/
+        _In_ const AsicOperation &first,
+        _In_ const AsicOperation &next)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Only create and remove of non object id leaf entries is grouped, since
+     * those don't produce RIDs used by other operations and there is usually
+     * a lot of them. Object id creates can't be grouped since next operation
+     * can use RID created by previous one.
+     */
+
+    if (first.getApi() != next.getApi() ||
+            first.getObj()->getObjectType() != next.getObj()->getObjectType())
+    {
+        return false;
+    }
+
+    if (first.getApi() != SAI_COMMON_API_CREATE && first.getApi() != SAI_COMMON_API_REMOVE)
+    {
+        return false;
+    }
+
+    switch (first.getObj()->getObjectType())
+    {
+        case SAI_OBJECT_TYPE_ROUTE:
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+        case SAI_OBJECT_TYPE_FDB:
+            return true;
+
+        default:
+            return false;
+    }
+}/*}}}*/
+
+sai_status_t asic_process_bulk(/*{{{*/
+        _In_ AsicView &current,
+        _In_ AsicView &temporary,
+        _In_ const std::vector<std::shared_ptr<AsicOperation>> &ops,
+        _In_ size_t begin,
+        _In_ size_t end)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * All attribute lists are translated before any call to ASIC, since there
+     * is no dependency between entries in single bulk.
+     *
+     * Since SAI 0.9.4 don't have bulk API, entries are executed one by one
+     * like in handle_bulk_route, this is the place where SDK bulk API can be
+     * called when it will be available.
+     */
+
+    std::vector<std::shared_ptr<AsicAttributeList>> lists;
+
+    lists.reserve(end - begin);
+
+    for (size_t idx = begin; idx < end; ++idx)
+    {
+        const auto &op = ops[idx];
+
+        lists.push_back(std::make_shared<AsicAttributeList>(current, temporary, op->getObj()->getObjectType(), op->getAttrs()));
+    }
+
+    for (size_t idx = begin; idx < end; ++idx)
+    {
+        sai_status_t status = asic_process_event(current, temporary, *ops[idx], *lists[idx - begin]);
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}/*}}}*/
+
 void executeOperationsOnAsic(/*{{{*/
         _In_ AsicView &currentView,
         _In_ AsicView &temporaryView)
@@ -5560,13 +7631,37 @@ void executeOperationsOnAsic(/*{{{*/
 
     SWSS_LOG_NOTICE("operations to execute on ASIC: %zu", currentView.asicGetOperationsCount());
 
+    size_t bulks = 0;
+
     {
         SWSS_LOG_TIMER("asic apply");
 
         try
         {
-            for (const auto &op: currentView.asicGetOperations())
+            const auto &ops = currentView.asicGetOperations();
+
+            for (size_t idx = 0; idx < ops.size(); )
             {
+                /*
+                 * Consecutive operations of the same type which can be
+                 * grouped are executed as single bulk, order of operations is
+                 * preserved.
+                 */
+
+                size_t end = idx + 1;
+
+                while (end < ops.size() &&
+                        end - idx < ASIC_BULK_MAX_OPERATIONS &&
+                        asic_can_bulk(*ops[idx], *ops[end]))
+                {
+                    end++;
+                }
+
+                if (end - idx > 1)
+                {
+                    bulks++;
+                }
+
                 /*
                  * It is possible that this method will throw exception in that case we
                  * also should exit syncd since we can be in the middle of executing
@@ -5575,7 +7670,7 @@ void executeOperationsOnAsic(/*{{{*/
                  * will lead to unexpected behaviour.
                  */
 
-                sai_status_t status = asic_process_event(currentView, temporaryView, *op);
+                sai_status_t status = asic_process_bulk(currentView, temporaryView, ops, idx, end);
 
                 if (status != SAI_STATUS_SUCCESS)
                 {
@@ -5584,6 +7679,8 @@ void executeOperationsOnAsic(/*{{{*/
 
                     exit_and_notify(EXIT_FAILURE);
                 }
+
+                idx = end;
             }
         }
         catch (const std::exception &e)
@@ -5594,5 +7691,5 @@ void executeOperationsOnAsic(/*{{{*/
         }
     }
 
-    SWSS_LOG_NOTICE("performed all operations on asic succesfully");
+    SWSS_LOG_NOTICE("performed all operations on asic succesfully, %zu bulks", bulks);
 }/*}}}*/
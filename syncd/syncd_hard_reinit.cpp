@@ -1,8 +1,14 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
 
 #include "syncd.h"
+#include "syncd_redis_pipeline.h"
 
 typedef std::unordered_map<std::string, std::string> StringHash;
 typedef std::unordered_map<sai_object_id_t, sai_object_id_t> ObjectIdMap;
@@ -11,6 +17,12 @@ std::unordered_map<std::string, std::shared_ptr<SaiAttributeList>> g_attributesL
 
 ObjectIdMap g_translated;
 
+/*
+ * VIDs translated since maps in redis were last updated, used on fast boot
+ * where maps are updated while objects are still being reconciled.
+ */
+std::vector<sai_object_id_t> g_translatedNotPersisted;
+
 ObjectIdMap g_vidToRidMap;
 ObjectIdMap g_ridToVidMap;
 
@@ -22,14 +34,37 @@ StringHash g_fdbs;
 StringHash g_routes;
 StringHash g_traps;
 
+/*
+ * Time and number of processed objects for each hard reinit phase.
+ */
+struct HardReinitPhase
+{
+    std::string name;
+    double seconds;
+    size_t objects;
+};
+
+typedef std::vector<HardReinitPhase> HardReinitPhases;
+
+/*
+ * Number of dependency levels of OID objects created in last hard reinit.
+ */
+size_t g_oidLevels = 0;
+
 void processAttributesForOids(sai_object_type_t objectType, std::shared_ptr<SaiAttributeList> list);
-void processSwitch();
-void processVlans();
-void processNeighbors();
-void processOids();
-void processFdbs();
-void processRoutes(bool defaultOnly);
-void processTraps();
+size_t processSwitch();
+size_t processVlans();
+size_t processNeighbors();
+size_t processOids(bool criticalOnly);
+size_t processFdbs();
+size_t processRoutes(bool defaultOnly);
+size_t processTraps();
+std::vector<std::function<void()>> getFastBootDeferredTasks();
+
+/*
+ * Routes which will be created by fast boot reconcile.
+ */
+std::unordered_set<std::string> g_fastBootDeferredRoutes;
 
 sai_object_type_t getObjectTypeFromAsicKey(const std::string &key);
 
@@ -50,29 +85,6 @@ sai_object_type_t getObjectTypeFromVid(sai_object_id_t sai_object_id)
     return objectType;
 }
 
-std::shared_ptr<SaiAttributeList> redisGetAttributesFromAsicKey(const std::string &key)
-{
-    SWSS_LOG_ENTER();
-
-    sai_object_type_t objectType = getObjectTypeFromAsicKey(key);
-
-    std::vector<swss::FieldValueTuple> values;
-
-    auto hash = g_redisClient->hgetall(key);
-
-    for (auto &kv: hash)
-    {
-        const std::string &skey = kv.first;
-        const std::string &svalue = kv.second;
-
-        swss::FieldValueTuple fvt(skey, svalue);
-
-        values.push_back(fvt);
-    }
-
-    return std::shared_ptr<SaiAttributeList>(new SaiAttributeList(objectType, values, false));
-}
-
 sai_object_type_t getObjectTypeFromAsicKey(const std::string &key)
 {
     SWSS_LOG_ENTER();
@@ -106,6 +118,94 @@ std::string getObjectIdFromAsicKey(const std::string &key)
     return key.substr(end + 1);
 }
 
+void addAsicStateKey(const std::string &key, sai_object_type_t objectType)
+{
+    SWSS_LOG_ENTER();
+
+    const std::string &strObjectId = getObjectIdFromAsicKey(key);
+
+    switch (objectType)
+    {
+        case SAI_OBJECT_TYPE_ROUTE:
+            g_routes[strObjectId] = key;
+            break;
+
+        case SAI_OBJECT_TYPE_VLAN:
+            g_vlans[strObjectId] = key;
+            break;
+
+        case SAI_OBJECT_TYPE_FDB:
+            g_fdbs[strObjectId] = key;
+            break;
+
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+            g_neighbors[strObjectId] = key;
+            break;
+
+        case SAI_OBJECT_TYPE_TRAP:
+            g_traps[strObjectId] = key;
+            break;
+
+        case SAI_OBJECT_TYPE_SWITCH:
+            g_switches[strObjectId] = key;
+            break;
+
+        default:
+            g_oids[strObjectId] = key;
+            break;
+    }
+}
+
+void redisLoadAsicState()
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Instead of KEYS and HGETALL per key, keys are iterated using SCAN and
+     * attributes are fetched in pipelined HGETALL batches on separate
+     * connection. Attribute lists are deserialized on worker threads, since
+     * on large route tables this takes most of the load time.
+     */
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    RedisPipeline pipeline(&db);
+
+    pipeline.scanHashes(ASIC_STATE_TABLE ":*",
+            [&](const std::vector<std::string> &keys, std::vector<RedisHashFields> &fields)
+            {
+                std::vector<sai_object_type_t> objectTypes(keys.size());
+
+                for (size_t idx = 0; idx < keys.size(); ++idx)
+                {
+                    objectTypes[idx] = getObjectTypeFromAsicKey(keys[idx]);
+                }
+
+                std::vector<std::shared_ptr<SaiAttributeList>> lists(keys.size());
+
+                parallelFor(keys.size(), [&](size_t idx)
+                {
+                    lists[idx] = std::make_shared<SaiAttributeList>(objectTypes[idx], fields[idx], false);
+                });
+
+                /*
+                 * SCAN may return same key more than once, in that case
+                 * entry is just overwritten.
+                 */
+
+                for (size_t idx = 0; idx < keys.size(); ++idx)
+                {
+                    addAsicStateKey(keys[idx], objectTypes[idx]);
+
+                    g_attributesLists[keys[idx]] = lists[idx];
+                }
+            });
+
+    SWSS_LOG_NOTICE("loaded %zu asic state keys, redis round trips: %zu",
+            g_attributesLists.size(),
+            pipeline.getRoundTrips());
+}
+
 void redisSetVidAndRidMap(std::unordered_map<sai_object_id_t, sai_object_id_t> map)
 {
     SWSS_LOG_ENTER();
@@ -123,6 +223,87 @@ void redisSetVidAndRidMap(std::unordered_map<sai_object_id_t, sai_object_id_t> m
     }
 }
 
+/*
+ * Write VID to RID pairs of objects created since last call to redis and
+ * local cache, and remove RIDs from previous boot of those objects from
+ * RIDTOVID. Objects not yet reconciled keep their previous RIDs, but since
+ * they don't exist on ASIC, SDK will not report them in notifications.
+ */
+void redisPersistTranslatedIds()
+{
+    SWSS_LOG_ENTER();
+
+    if (g_translatedNotPersisted.empty())
+    {
+        return;
+    }
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    RedisPipeline pipeline(&db);
+
+    /*
+     * Previous RID can be already reused by SDK for object created in this
+     * boot, by reconcile or by operation processed while reconcile is
+     * pending, then it's entry was overwritten and must be kept, so current
+     * RIDTOVID values of previous RIDs are checked first.
+     */
+
+    std::vector<std::pair<sai_object_id_t, sai_object_id_t>> previous;
+
+    for (auto vid: g_translatedNotPersisted)
+    {
+        auto it = g_vidToRidMap.find(vid);
+
+        if (it != g_vidToRidMap.end() && it->second != g_translated.at(vid))
+        {
+            previous.push_back(std::make_pair(vid, it->second));
+        }
+    }
+
+    std::vector<std::string> currentVids(previous.size());
+
+    for (size_t idx = 0; idx < previous.size(); ++idx)
+    {
+        auto &strVid = currentVids[idx];
+
+        pipeline.push({ "HGET", RIDTOVID, sai_serialize_object_id(previous[idx].second) },
+                [&strVid](const redisReply *reply)
+                {
+                    if (reply->type == REDIS_REPLY_STRING)
+                    {
+                        strVid = std::string(reply->str, reply->len);
+                    }
+                });
+    }
+
+    pipeline.flush();
+
+    for (auto rid: selectStaleRids(previous, currentVids))
+    {
+        pipeline.push({ "HDEL", RIDTOVID, sai_serialize_object_id(rid) });
+    }
+
+    for (auto vid: g_translatedNotPersisted)
+    {
+        sai_object_id_t rid = g_translated.at(vid);
+
+        std::string strVid = sai_serialize_object_id(vid);
+        std::string strRid = sai_serialize_object_id(rid);
+
+        pipeline.push({ "HSET", VIDTORID, strVid, strRid });
+        pipeline.push({ "HSET", RIDTOVID, strRid, strVid });
+
+        save_rid_and_vid_to_local(rid, vid);
+    }
+
+    pipeline.flush();
+
+    SWSS_LOG_INFO("persisted %zu translated ids", g_translatedNotPersisted.size());
+
+    g_translatedNotPersisted.clear();
+}
+
 void checkAllIds()
 {
     SWSS_LOG_ENTER();
@@ -158,8 +339,6 @@ void checkAllIds()
 
         exit_and_notify(EXIT_FAILURE);
     }
-
-    redisSetVidAndRidMap(g_translated);
 }
 
 void saiRemoveDefaultVlanMembers()
@@ -209,70 +388,124 @@ void saiRemoveDefaultVlanMembers()
     }
 }
 
-void hardReinit()
+void logHardReinitReport(
+        _In_ const HardReinitPhases &phases)
 {
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_TIMER("hard reinit");
+    double total = 0;
+
+    for (const auto &phase: phases)
+    {
+        total += phase.seconds;
+    }
+
+    SWSS_LOG_NOTICE("hard reinit report: total %.3f s, asic state keys: %zu, oid dependency levels: %zu",
+            total,
+            g_attributesLists.size(),
+            g_oidLevels);
+
+    for (const auto &phase: phases)
+    {
+        SWSS_LOG_NOTICE("- phase %s: %.3f s, objects: %zu",
+                phase.name.c_str(),
+                phase.seconds,
+                phase.objects);
+    }
+}
+
+void hardReinit(bool fastBoot)
+{
+    SWSS_LOG_ENTER();
+
+    HardReinitPhases phases;
+
+    auto phaseStart = std::chrono::steady_clock::now();
+
+    auto phaseEnd = [&](const std::string &name, size_t objects)
+    {
+        auto now = std::chrono::steady_clock::now();
+
+        phases.push_back({ name, std::chrono::duration<double>(now - phaseStart).count(), objects });
+
+        phaseStart = now;
+    };
 
     saiRemoveDefaultVlanMembers();
 
+    phaseEnd("remove default vlan members", 0);
+
     // repopulate asic view from redis db after hard asic initialize
 
     g_vidToRidMap = redisGetVidToRidMap();
     g_ridToVidMap = redisGetRidToVidMap();
 
-    std::vector<std::string> asicStateKeys = redisGetAsicStateKeys();
+    redisLoadAsicState();
 
-    for (auto &key: asicStateKeys)
+    phaseEnd("load asic state", g_attributesLists.size());
+
+    phaseEnd("switch", processSwitch());
+    phaseEnd("vlans", processVlans());
+    phaseEnd("fdbs", processFdbs());
+    phaseEnd("neighbors", processNeighbors());
+
+    if (fastBoot)
     {
-        sai_object_type_t objectType = getObjectTypeFromAsicKey(key);
-        const std::string &strObjectId = getObjectIdFromAsicKey(key);
+        /*
+         * Only objects needed to forward traffic are created before switch is
+         * declared ready, remaining objects are reconciled in background.
+         * VID to RID maps in redis are updated when reconcile is finished.
+         */
 
-        switch (objectType)
-        {
-            case SAI_OBJECT_TYPE_ROUTE:
-                g_routes[strObjectId] = key;
-                break;
+        phaseEnd("critical oids", processOids(true));
+        phaseEnd("traps", processTraps());
+        phaseEnd("default routes", processRoutes(true));
 
-            case SAI_OBJECT_TYPE_VLAN:
-                g_vlans[strObjectId] = key;
-                break;
+        g_fastBootTasks = getFastBootDeferredTasks();
+        g_fastBootNextTask = 0;
+        g_fastBootPending = !g_fastBootTasks.empty();
 
-            case SAI_OBJECT_TYPE_FDB:
-                g_fdbs[strObjectId] = key;
-                break;
+        phaseEnd("prepare deferred objects", g_fastBootTasks.size());
 
-            case SAI_OBJECT_TYPE_NEIGHBOR:
-                g_neighbors[strObjectId] = key;
-                break;
+        /*
+         * Notifications and counters translate RIDs of created objects
+         * while reconcile is pending, so their maps must be in place
+         * before switch is declared ready, otherwise new VIDs would be
+         * created for them.
+         */
 
-            case SAI_OBJECT_TYPE_TRAP:
-                g_traps[strObjectId] = key;
-                break;
+        redisPersistTranslatedIds();
 
-            case SAI_OBJECT_TYPE_SWITCH:
-                g_switches[strObjectId] = key;
-                break;
+        phaseEnd("persist translated ids", g_translated.size());
 
-            default:
-                g_oids[strObjectId] = key;
-                break;
-        }
+        SWSS_LOG_NOTICE("fast boot: data plane critical objects created, %zu objects will be reconciled in background",
+                g_fastBootTasks.size());
 
-        g_attributesLists[key] = redisGetAttributesFromAsicKey(key);
-    }
+        if (g_fastBootPending)
+        {
+            g_fastBootPhases = phases;
+            g_fastBootReadyTime = std::chrono::steady_clock::now();
 
-    processSwitch();
-    processVlans();
-    processFdbs();
-    processNeighbors();
-    processOids();
-    processTraps();
-    processRoutes(true);
-    processRoutes(false);
+            return;
+        }
+    }
+    else
+    {
+        phaseEnd("oids", processOids(false));
+        phaseEnd("traps", processTraps());
+        phaseEnd("default routes", processRoutes(true));
+        phaseEnd("routes", processRoutes(false));
+    }
 
     checkAllIds();
+
+    redisSetVidAndRidMap(g_translated);
+
+    g_translatedNotPersisted.clear();
+
+    phaseEnd("check ids", g_translated.size());
+
+    logHardReinitReport(phases);
 }
 
 template<typename FUN>
@@ -539,69 +772,73 @@ sai_object_id_t processSingleVid(sai_object_id_t vid)
 
     g_translated[vid] = rid;
 
+    g_translatedNotPersisted.push_back(vid);
+
     return rid;
 }
 
-void processAttributesForOids(sai_object_type_t objectType, std::shared_ptr<SaiAttributeList> list)
+sai_object_id_t* getObjectIdsFromAttribute(
+        sai_object_type_t objectType,
+        sai_attribute_t &attr,
+        uint32_t &count)
 {
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_DEBUG("processing list for object type %d", objectType);
+    auto meta = get_attribute_metadata(objectType, attr.id);
 
-    sai_attribute_t *attrList = list->get_attr_list();
-
-    uint32_t attrCount = list->get_attr_count();
+    if (meta == NULL)
+    {
+        SWSS_LOG_ERROR("unable to get metadata for object type %x, attribute %x", objectType, attr.id);
+        exit_and_notify(EXIT_FAILURE);
+    }
 
-    for (uint32_t idx = 0; idx < attrCount; idx++)
+    switch (meta->serializationtype)
     {
-        sai_attribute_t &attr = attrList[idx];
+        case SAI_SERIALIZATION_TYPE_OBJECT_ID:
+            count = 1;
+            return &attr.value.oid;
 
-        auto meta = get_attribute_metadata(objectType, attr.id);
+        case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
+            count = attr.value.objlist.count;
+            return attr.value.objlist.list;
 
-        if (meta == NULL)
-        {
-            SWSS_LOG_ERROR("unable to get metadata for object type %x, attribute %x", objectType, attr.id);
-            exit_and_notify(EXIT_FAILURE);
-        }
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+            count = 1;
+            return &attr.value.aclfield.data.oid;
 
-        uint32_t count = 0;
-        sai_object_id_t *objectIdList;
+        case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            count = attr.value.aclfield.data.objlist.count;
+            return attr.value.aclfield.data.objlist.list;
 
-        switch (meta->serializationtype)
-        {
-            case SAI_SERIALIZATION_TYPE_OBJECT_ID:
-                count = 1;
-                objectIdList = &attr.value.oid;
-                break;
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+            count = 1;
+            return &attr.value.aclaction.parameter.oid;
 
-            case SAI_SERIALIZATION_TYPE_OBJECT_LIST:
-                count = attr.value.objlist.count;
-                objectIdList = attr.value.objlist.list;
-                break;
+        case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            count = attr.value.aclaction.parameter.objlist.count;
+            return attr.value.aclaction.parameter.objlist.list;
 
-            case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_ID:
-                count = 1;
-                objectIdList = &attr.value.aclfield.data.oid;
-                break;
+        default:
+            count = 0;
+            return NULL;
+    }
+}
 
-            case SAI_SERIALIZATION_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
-                count = attr.value.aclfield.data.objlist.count;
-                objectIdList = attr.value.aclfield.data.objlist.list;
-                break;
+void processAttributesForOids(sai_object_type_t objectType, std::shared_ptr<SaiAttributeList> list)
+{
+    SWSS_LOG_ENTER();
 
-            case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_ID:
-                count = 1;
-                objectIdList = &attr.value.aclaction.parameter.oid;
-                break;
+    SWSS_LOG_DEBUG("processing list for object type %d", objectType);
 
-            case SAI_SERIALIZATION_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-                count = attr.value.aclaction.parameter.objlist.count;
-                objectIdList = attr.value.aclaction.parameter.objlist.list;
-                break;
+    sai_attribute_t *attrList = list->get_attr_list();
 
-            default:
-                continue;
-        }
+    uint32_t attrCount = list->get_attr_count();
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        uint32_t count = 0;
+
+        sai_object_id_t *objectIdList = getObjectIdsFromAttribute(objectType, attrList[idx], count);
 
         // attribute contains object id's, they need to be translated
         // some of them could be already translated
@@ -627,19 +864,152 @@ sai_object_id_t getObjectIdFromString(const std::string &strObjectId)
     return objectId;
 }
 
-void processOids()
+/*
+ * Returns dependency level of object, objects which are already translated
+ * have level 0, and each object has level higher than any object it depends
+ * on, so objects on the same level can be created in any order.
+ */
+size_t getOidLevel(
+        sai_object_id_t vid,
+        std::unordered_map<sai_object_id_t, size_t> &levels)
 {
+    SWSS_LOG_ENTER();
+
+    if (vid == SAI_NULL_OBJECT_ID || g_translated.find(vid) != g_translated.end())
+    {
+        return 0;
+    }
+
+    auto it = levels.find(vid);
+
+    if (it != levels.end())
+    {
+        return it->second;
+    }
+
+    std::string strVid = sai_serialize_object_id(vid);
+
+    auto oit = g_oids.find(strVid);
+
+    if (oit == g_oids.end())
+    {
+        SWSS_LOG_ERROR("failed to find VID %s in OIDs map", strVid.c_str());
+
+        exit_and_notify(EXIT_FAILURE);
+    }
+
+    sai_object_type_t objectType = getObjectTypeFromVid(vid);
+
+    std::shared_ptr<SaiAttributeList> list = g_attributesLists[oit->second];
+
+    sai_attribute_t *attrList = list->get_attr_list();
+
+    uint32_t attrCount = list->get_attr_count();
+
+    size_t level = 1;
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        uint32_t count = 0;
+
+        sai_object_id_t *objectIdList = getObjectIdsFromAttribute(objectType, attrList[idx], count);
+
+        for (uint32_t j = 0; j < count; j++)
+        {
+            level = std::max(level, getOidLevel(objectIdList[j], levels) + 1);
+        }
+    }
+
+    levels[vid] = level;
+
+    return level;
+}
+
+/*
+ * Objects which are needed to forward traffic on fast boot, all objects
+ * they depend on are created as well.
+ */
+static const std::set<sai_object_type_t> g_fastBootCriticalObjectTypes = {
+    SAI_OBJECT_TYPE_VIRTUAL_ROUTER,
+    SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+    SAI_OBJECT_TYPE_NEXT_HOP,
+    SAI_OBJECT_TYPE_HOST_INTERFACE,
+};
+
+/*
+ * Returns not yet created objects in creation order.
+ *
+ * Instead of recursing object by object, objects are grouped by dependency
+ * level and created level by level, so when object is created all it's
+ * dependencies are already translated. Inside level objects are grouped by
+ * object type, since objects in single level are independent and same type
+ * objects could be passed to bulk create once SDK supports it.
+ */
+std::vector<sai_object_id_t> getOidsCreationOrder(bool criticalOnly)
+{
+    SWSS_LOG_ENTER();
+
+    std::unordered_map<sai_object_id_t, size_t> levels;
+
+    std::vector<std::vector<sai_object_id_t>> batches;
+
     for (auto &kv: g_oids)
     {
-        const std::string &strObjectId = kv.first;
+        sai_object_id_t vid = getObjectIdFromString(kv.first);
 
-        sai_object_id_t vidObjectId = getObjectIdFromString(strObjectId);
+        if (criticalOnly && g_fastBootCriticalObjectTypes.find(getObjectTypeFromVid(vid)) == g_fastBootCriticalObjectTypes.end())
+        {
+            continue;
+        }
+
+        size_t level = getOidLevel(vid, levels);
+
+        if (level == 0)
+        {
+            // already created by previous phase
+            continue;
+        }
+
+        if (batches.size() < level)
+        {
+            batches.resize(level);
+        }
+
+        batches[level - 1].push_back(vid);
+    }
+
+    std::vector<sai_object_id_t> order;
+
+    for (auto &batch: batches)
+    {
+        std::stable_sort(batch.begin(), batch.end(),
+                [](sai_object_id_t a, sai_object_id_t b) { return getObjectTypeFromVid(a) < getObjectTypeFromVid(b); });
 
-        processSingleVid(vidObjectId);
+        order.insert(order.end(), batch.begin(), batch.end());
     }
+
+    g_oidLevels = std::max(g_oidLevels, batches.size());
+
+    return order;
+}
+
+size_t processOids(bool criticalOnly)
+{
+    SWSS_LOG_ENTER();
+
+    auto order = getOidsCreationOrder(criticalOnly);
+
+    for (auto vid: order)
+    {
+        // non critical objects which this object depends on are
+        // created here by recursion
+        processSingleVid(vid);
+    }
+
+    return order.size();
 }
 
-void processSwitch()
+size_t processSwitch()
 {
     SWSS_LOG_ENTER();
 
@@ -669,6 +1039,8 @@ void processSwitch()
             }
         }
     }
+
+    return g_switches.size();
 }
 
 sai_vlan_id_t getVlanIdFromString(const std::string &strVlanId)
@@ -681,7 +1053,7 @@ sai_vlan_id_t getVlanIdFromString(const std::string &strVlanId)
     return vlanId;
 }
 
-void processVlans()
+size_t processVlans()
 {
     SWSS_LOG_ENTER();
 
@@ -727,6 +1099,8 @@ void processVlans()
             }
         }
     }
+
+    return g_vlans.size();
 }
 
 sai_fdb_entry_t getFdbEntryFromString(const std::string &strFdbEntry)
@@ -739,16 +1113,53 @@ sai_fdb_entry_t getFdbEntryFromString(const std::string &strFdbEntry)
     return fdbEntry;
 }
 
-void processFdbs()
+/*
+ * Deserialize entries of leaf objects on worker threads, entries don't depend
+ * on any state, only translation of object ids must be done serially.
+ */
+template<typename T>
+std::vector<std::pair<T, const std::string*>> deserializeEntries(
+        const std::vector<const StringHash::value_type*> &items,
+        T (*fun)(const std::string&))
 {
     SWSS_LOG_ENTER();
 
-    for (auto &kv: g_fdbs)
+    std::vector<std::pair<T, const std::string*>> entries(items.size());
+
+    parallelFor(items.size(), [&](size_t idx)
     {
-        const std::string &strFdbEntry = kv.first;
-        const std::string &asicKey = kv.second;
+        entries[idx] = std::make_pair(fun(items[idx]->first), &items[idx]->second);
+    });
+
+    return entries;
+}
+
+std::vector<const StringHash::value_type*> getItems(const StringHash &hash)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<const StringHash::value_type*> items;
 
-        sai_fdb_entry_t fdbEntry = getFdbEntryFromString(strFdbEntry);
+    items.reserve(hash.size());
+
+    for (auto &kv: hash)
+    {
+        items.push_back(&kv);
+    }
+
+    return items;
+}
+
+size_t processFdbs()
+{
+    SWSS_LOG_ENTER();
+
+    auto entries = deserializeEntries(getItems(g_fdbs), getFdbEntryFromString);
+
+    for (auto &e: entries)
+    {
+        sai_fdb_entry_t &fdbEntry = e.first;
+        const std::string &asicKey = *e.second;
 
         std::shared_ptr<SaiAttributeList> list = g_attributesLists[asicKey];
 
@@ -767,6 +1178,8 @@ void processFdbs()
             exit_and_notify(EXIT_FAILURE);
         }
     }
+
+    return entries.size();
 }
 
 sai_neighbor_entry_t getNeighborEntryFromString(const std::string &strNeighborEntry)
@@ -779,16 +1192,16 @@ sai_neighbor_entry_t getNeighborEntryFromString(const std::string &strNeighborEn
     return neighborEntry;
 }
 
-void processNeighbors()
+size_t processNeighbors()
 {
     SWSS_LOG_ENTER();
 
-    for (auto &kv: g_neighbors)
-    {
-        const std::string &strNeighborEntry = kv.first;
-        const std::string &asicKey = kv.second;
+    auto entries = deserializeEntries(getItems(g_neighbors), getNeighborEntryFromString);
 
-        sai_neighbor_entry_t neighborEntry = getNeighborEntryFromString(strNeighborEntry);
+    for (auto &e: entries)
+    {
+        sai_neighbor_entry_t &neighborEntry = e.first;
+        const std::string &asicKey = *e.second;
 
         neighborEntry.rif_id = processSingleVid(neighborEntry.rif_id);
 
@@ -809,6 +1222,8 @@ void processNeighbors()
             exit_and_notify(EXIT_FAILURE);
         }
     }
+
+    return entries.size();
 }
 
 sai_unicast_route_entry_t getRouteEntryFromString(const std::string &strRouteEntry)
@@ -821,50 +1236,105 @@ sai_unicast_route_entry_t getRouteEntryFromString(const std::string &strRouteEnt
     return routeEntry;
 }
 
-void processRoutes(bool defaultOnly)
+void createRoute(sai_unicast_route_entry_t &routeEntry, const std::string &asicKey)
 {
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_TIMER("apply routes");
+    routeEntry.vr_id = processSingleVid(routeEntry.vr_id);
 
-    for (auto &kv: g_routes)
+    std::shared_ptr<SaiAttributeList> list = g_attributesLists[asicKey];
+
+    processAttributesForOids(SAI_OBJECT_TYPE_ROUTE, list);
+
+    sai_attribute_t *attrList = list->get_attr_list();
+
+    uint32_t attrCount = list->get_attr_count();
+
+    sai_status_t status = sai_route_api->create_route(&routeEntry, attrCount, attrList);
+
+    if (status != SAI_STATUS_SUCCESS)
     {
-        const std::string &strRouteEntry = kv.first;
-        const std::string &asicKey = kv.second;
+        SWSS_LOG_ERROR(
+                "failed to create ROUTE %s: %s",
+                sai_serialize_route_entry(routeEntry).c_str(),
+                sai_serialize_status(status).c_str());
+
+        listFailedAttributes(SAI_OBJECT_TYPE_ROUTE, attrCount, attrList);
+
+        exit_and_notify(EXIT_FAILURE);
+    }
+}
+
+bool isDefaultRoute(const std::string &strRouteEntry)
+{
+    SWSS_LOG_ENTER();
+
+    return strRouteEntry.find("/0") != std::string::npos;
+}
+
+size_t processRoutes(bool defaultOnly)
+{
+    SWSS_LOG_ENTER();
 
-        bool isDefault = strRouteEntry.find("/0") != std::string::npos;
+    std::vector<const StringHash::value_type*> items;
 
-        if (defaultOnly ^ isDefault)
+    for (auto &kv: g_routes)
+    {
+        if (defaultOnly ^ isDefaultRoute(kv.first))
         {
             continue;
         }
 
-        sai_unicast_route_entry_t routeEntry = getRouteEntryFromString(strRouteEntry);
+        items.push_back(&kv);
+    }
 
-        routeEntry.vr_id = processSingleVid(routeEntry.vr_id);
+    auto entries = deserializeEntries(items, getRouteEntryFromString);
 
-        std::shared_ptr<SaiAttributeList> list = g_attributesLists[asicKey];
+    for (auto &e: entries)
+    {
+        createRoute(e.first, *e.second);
+    }
 
-        processAttributesForOids(SAI_OBJECT_TYPE_ROUTE, list);
+    return entries.size();
+}
 
-        sai_attribute_t *attrList = list->get_attr_list();
+/*
+ * On fast boot, all objects which are not created before switch is declared
+ * ready are reconciled later by fast boot reconcile thread.
+ */
+std::vector<std::function<void()>> getFastBootDeferredTasks()
+{
+    SWSS_LOG_ENTER();
 
-        uint32_t attrCount = list->get_attr_count();
+    std::vector<std::function<void()>> tasks;
 
-        sai_status_t status = sai_route_api->create_route(&routeEntry, attrCount, attrList);
+    for (auto vid: getOidsCreationOrder(false))
+    {
+        tasks.push_back([vid]() { processSingleVid(vid); });
+    }
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (auto &kv: g_routes)
+    {
+        if (isDefaultRoute(kv.first))
         {
-            SWSS_LOG_ERROR(
-                    "failed to create ROUTE %s: %s",
-                    sai_serialize_route_entry(routeEntry).c_str(),
-                    sai_serialize_status(status).c_str());
+            continue;
+        }
 
-            listFailedAttributes(SAI_OBJECT_TYPE_ROUTE, attrCount, attrList);
+        const StringHash::value_type *item = &kv;
 
-            exit_and_notify(EXIT_FAILURE);
-        }
+        g_fastBootDeferredRoutes.insert(item->first);
+
+        tasks.push_back([item]()
+        {
+            sai_unicast_route_entry_t routeEntry = getRouteEntryFromString(item->first);
+
+            createRoute(routeEntry, item->second);
+
+            g_fastBootDeferredRoutes.erase(item->first);
+        });
     }
+
+    return tasks;
 }
 
 sai_hostif_trap_id_t getTrapIdFromString(const std::string &strTrapId)
@@ -877,7 +1347,7 @@ sai_hostif_trap_id_t getTrapIdFromString(const std::string &strTrapId)
     return trapId;
 }
 
-void processTraps()
+size_t processTraps()
 {
     SWSS_LOG_ENTER();
 
@@ -910,4 +1380,219 @@ void processTraps()
             }
         }
     }
+
+    return g_traps.size();
+}
+
+/*
+ * Fast boot reconcile state, protected by g_mutex.
+ */
+std::vector<std::function<void()>> g_fastBootTasks;
+size_t g_fastBootNextTask = 0;
+bool g_fastBootPending = false;
+HardReinitPhases g_fastBootPhases;
+std::chrono::steady_clock::time_point g_fastBootReadyTime;
+
+bool isFastBootReconcilePending()
+{
+    SWSS_LOG_ENTER();
+
+    return g_fastBootPending;
+}
+
+bool isFastBootDeferredVid(sai_object_id_t vid)
+{
+    SWSS_LOG_ENTER();
+
+    if (vid == SAI_NULL_OBJECT_ID || g_translated.find(vid) != g_translated.end())
+    {
+        return false;
+    }
+
+    return g_oids.find(sai_serialize_object_id(vid)) != g_oids.end();
+}
+
+/*
+ * Objects created before switch was declared ready already have RIDs of
+ * this boot in redis, so only operations on objects which are not yet
+ * reconciled, or which reference them, need to finish reconcile first.
+ * Attribute values of GET are not references, so only object itself is
+ * checked. Removing created object which is still referenced by deferred
+ * object is not detected, but referring object is removed first, and that
+ * operation finishes reconcile.
+ */
+bool isFastBootDeferredObjectUsed(
+        _In_ sai_object_type_t objectType,
+        _In_ const std::string &strObjectId,
+        _In_ sai_common_api_t api,
+        _In_ uint32_t attrCount,
+        _In_ sai_attribute_t *attrList)
+{
+    SWSS_LOG_ENTER();
+
+    switch (objectType)
+    {
+        case SAI_OBJECT_TYPE_ROUTE:
+
+            if (g_fastBootDeferredRoutes.find(strObjectId) != g_fastBootDeferredRoutes.end())
+            {
+                return true;
+            }
+
+            break;
+
+        case SAI_OBJECT_TYPE_FDB:
+        case SAI_OBJECT_TYPE_NEIGHBOR:
+        case SAI_OBJECT_TYPE_SWITCH:
+        case SAI_OBJECT_TYPE_VLAN:
+        case SAI_OBJECT_TYPE_TRAP:
+            break;
+
+        default:
+
+            if (isFastBootDeferredVid(getObjectIdFromString(strObjectId)))
+            {
+                return true;
+            }
+
+            break;
+    }
+
+    if (api == SAI_COMMON_API_GET)
+    {
+        return false;
+    }
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        uint32_t count = 0;
+
+        sai_object_id_t *objectIdList = getObjectIdsFromAttribute(objectType, attrList[idx], count);
+
+        for (uint32_t j = 0; j < count; j++)
+        {
+            if (isFastBootDeferredVid(objectIdList[j]))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void fastBootReconcile(size_t maxTasks)
+{
+    SWSS_LOG_ENTER();
+
+    if (!g_fastBootPending)
+    {
+        return;
+    }
+
+    size_t count = g_fastBootTasks.size();
+
+    size_t end = (maxTasks >= count - g_fastBootNextTask) ? count : g_fastBootNextTask + maxTasks;
+
+    size_t decile = g_fastBootNextTask * 10 / count;
+
+    while (g_fastBootNextTask < end)
+    {
+        g_fastBootTasks[g_fastBootNextTask++]();
+    }
+
+    redisPersistTranslatedIds();
+
+    if (g_fastBootNextTask * 10 / count != decile)
+    {
+        SWSS_LOG_NOTICE("fast boot reconcile progress: %zu/%zu objects", g_fastBootNextTask, count);
+    }
+
+    if (g_fastBootNextTask < count)
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+
+    g_fastBootPhases.push_back({ "deferred objects", std::chrono::duration<double>(now - g_fastBootReadyTime).count(), count });
+
+    checkAllIds();
+
+    g_fastBootPhases.push_back({ "check ids", std::chrono::duration<double>(std::chrono::steady_clock::now() - now).count(), g_translated.size() });
+
+    SWSS_LOG_NOTICE("fast boot reconcile finished");
+
+    logHardReinitReport(g_fastBootPhases);
+
+    g_fastBootTasks.clear();
+    g_fastBootDeferredRoutes.clear();
+    g_fastBootPhases.clear();
+    g_fastBootNextTask = 0;
+    g_fastBootPending = false;
+}
+
+static volatile bool g_runFastBootReconcileThread = false;
+static std::shared_ptr<std::thread> g_fastBootReconcileThread = NULL;
+
+static std::mutex mtx_fastBootSleep;
+static std::condition_variable cv_fastBootSleep;
+
+void fastBootReconcileThread()
+{
+    SWSS_LOG_ENTER();
+
+    while (g_runFastBootReconcileThread)
+    {
+        {
+            // reconcile modifies ASIC and redis, so it must not run
+            // concurrently with processing events
+
+            std::lock_guard<std::mutex> lock(g_mutex);
+
+            fastBootReconcile(FAST_BOOT_RECONCILE_BATCH_SIZE);
+
+            if (!g_fastBootPending)
+            {
+                break;
+            }
+        }
+
+        std::unique_lock<std::mutex> lk(mtx_fastBootSleep);
+        cv_fastBootSleep.wait_for(lk, std::chrono::milliseconds(FAST_BOOT_RECONCILE_BATCH_INTERVAL_MS));
+    }
+}
+
+void startFastBootReconcileThread()
+{
+    SWSS_LOG_ENTER();
+
+    if (!isFastBootReconcilePending())
+    {
+        return;
+    }
+
+    g_runFastBootReconcileThread = true;
+
+    g_fastBootReconcileThread = std::shared_ptr<std::thread>(new std::thread(fastBootReconcileThread));
+}
+
+void endFastBootReconcileThread()
+{
+    SWSS_LOG_ENTER();
+
+    g_runFastBootReconcileThread = false;
+
+    cv_fastBootSleep.notify_all();
+
+    if (g_fastBootReconcileThread != NULL)
+    {
+        SWSS_LOG_INFO("fast boot reconcile thread join");
+
+        g_fastBootReconcileThread->join();
+
+        g_fastBootReconcileThread = NULL;
+    }
+
+    SWSS_LOG_INFO("fast boot reconcile thread ended");
 }
@@ -0,0 +1,51 @@
+#include "syncd.h"
+
+#include <algorithm>
+
+bool isEqualObjectIdMultiset(
+        _In_ std::vector<sai_object_id_t> first,
+        _In_ std::vector<sai_object_id_t> second)
+{
+    SWSS_LOG_ENTER();
+
+    if (first.size() != second.size())
+    {
+        return false;
+    }
+
+    /*
+     * Most of the time lists are in the same order, so check that first
+     * before sorting.
+     */
+
+    if (first == second)
+    {
+        return true;
+    }
+
+    std::sort(first.begin(), first.end());
+    std::sort(second.begin(), second.end());
+
+    return first == second;
+}
+
+std::vector<sai_object_id_t> selectStaleRids(
+        _In_ const std::vector<std::pair<sai_object_id_t, sai_object_id_t>> &vidAndPreviousRid,
+        _In_ const std::vector<std::string> &currentVids)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<sai_object_id_t> rids;
+
+    for (size_t idx = 0; idx < vidAndPreviousRid.size(); ++idx)
+    {
+        const auto &p = vidAndPreviousRid[idx];
+
+        if (currentVids.at(idx) == sai_serialize_object_id(p.first))
+        {
+            rids.push_back(p.second);
+        }
+    }
+
+    return rids;
+}
@@ -0,0 +1,305 @@
+#include "syncd.h"
+#include "syncd_redis_pipeline.h"
+
+RedisPipeline::RedisPipeline(
+        _In_ swss::DBConnector *db,
+        _In_ size_t batchSize):
+    m_context(db->getContext()),
+    m_batchSize(batchSize == 0 ? 1 : batchSize),
+    m_pending(0),
+    m_roundTrips(0),
+    m_commands(0)
+{
+    SWSS_LOG_ENTER();
+}
+
+RedisPipeline::~RedisPipeline()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pending != 0)
+    {
+        SWSS_LOG_ERROR("pipeline destroyed with %zu pending commands, flush was not called", m_pending);
+    }
+}
+
+void RedisPipeline::append(
+        _In_ const std::vector<std::string> &args)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<const char*> argv;
+    std::vector<size_t> argvlen;
+
+    for (const auto &arg: args)
+    {
+        argv.push_back(arg.c_str());
+        argvlen.push_back(arg.size());
+    }
+
+    if (redisAppendCommandArgv(m_context, (int)args.size(), argv.data(), argvlen.data()) != REDIS_OK)
+    {
+        SWSS_LOG_ERROR("failed to append command %s to pipeline: %s",
+                args.empty() ? "" : args[0].c_str(),
+                m_context->errstr);
+
+        throw std::runtime_error("failed to append command to redis pipeline");
+    }
+
+    m_commands++;
+}
+
+redisReply* RedisPipeline::getReply()
+{
+    SWSS_LOG_ENTER();
+
+    redisReply *reply = NULL;
+
+    if (redisGetReply(m_context, (void**)&reply) != REDIS_OK || reply == NULL)
+    {
+        SWSS_LOG_ERROR("failed to get reply from redis: %s", m_context->errstr);
+
+        throw std::runtime_error("failed to get reply from redis");
+    }
+
+    if (reply->type == REDIS_REPLY_ERROR)
+    {
+        SWSS_LOG_ERROR("redis returned error: %s", reply->str);
+
+        freeReplyObject(reply);
+
+        throw std::runtime_error("redis returned error reply");
+    }
+
+    return reply;
+}
+
+void RedisPipeline::push(
+        _In_ const std::vector<std::string> &args,
+        _In_ const RedisReplyCallback &callback)
+{
+    SWSS_LOG_ENTER();
+
+    append(args);
+
+    m_callbacks.push_back(callback);
+
+    if (++m_pending >= m_batchSize)
+    {
+        flush();
+    }
+}
+
+void RedisPipeline::flush()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pending == 0)
+    {
+        return;
+    }
+
+    m_roundTrips++;
+
+    /*
+     * First redisGetReply will write entire output buffer, remaining replies
+     * are read from the same socket buffer. Even if some command failed, we
+     * still need to read all replies, to keep connection in sync.
+     */
+
+    bool failed = false;
+
+    std::vector<RedisReplyCallback> callbacks;
+
+    callbacks.swap(m_callbacks);
+
+    for (size_t idx = 0; m_pending > 0; --m_pending, ++idx)
+    {
+        redisReply *reply = NULL;
+
+        try
+        {
+            reply = getReply();
+
+            if (callbacks[idx])
+            {
+                callbacks[idx](reply);
+            }
+        }
+        catch (const std::runtime_error&)
+        {
+            failed = true;
+
+            if (m_context->err)
+            {
+                /*
+                 * Connection is broken, no more replies can be read.
+                 */
+
+                m_pending = 0;
+
+                break;
+            }
+        }
+
+        if (reply != NULL)
+        {
+            freeReplyObject(reply);
+        }
+    }
+
+    if (failed)
+    {
+        throw std::runtime_error("redis pipeline flush failed");
+    }
+}
+
+long long RedisPipeline::commandInteger(
+        _In_ const std::vector<std::string> &args)
+{
+    SWSS_LOG_ENTER();
+
+    flush();
+
+    append(args);
+
+    m_roundTrips++;
+
+    redisReply *reply = getReply();
+
+    if (reply->type != REDIS_REPLY_INTEGER)
+    {
+        SWSS_LOG_ERROR("expected integer reply from %s, got type %d",
+                args.empty() ? "" : args[0].c_str(),
+                reply->type);
+
+        freeReplyObject(reply);
+
+        throw std::runtime_error("expected integer reply from redis");
+    }
+
+    long long result = reply->integer;
+
+    freeReplyObject(reply);
+
+    return result;
+}
+
+void RedisPipeline::scanKeys(
+        _In_ const std::string &pattern,
+        _In_ const RedisScanKeysCallback &callback)
+{
+    SWSS_LOG_ENTER();
+
+    std::string cursor = "0";
+
+    std::unordered_set<std::string> seen;
+
+    do
+    {
+        std::vector<std::string> keys;
+
+        push({ "SCAN", cursor, "MATCH", pattern, "COUNT", std::to_string(m_batchSize) },
+                [&](const redisReply *reply)
+                {
+                    if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2)
+                    {
+                        throw std::runtime_error("unexpected SCAN reply");
+                    }
+
+                    cursor = std::string(reply->element[0]->str, reply->element[0]->len);
+
+                    const redisReply *list = reply->element[1];
+
+                    for (size_t idx = 0; idx < list->elements; ++idx)
+                    {
+                        keys.emplace_back(list->element[idx]->str, list->element[idx]->len);
+                    }
+                });
+
+        flush();
+
+        removeDuplicateKeys(seen, keys);
+
+        if (!keys.empty())
+        {
+            callback(keys);
+        }
+    }
+    while (cursor != "0");
+}
+
+void RedisPipeline::scanHashes(
+        _In_ const std::string &pattern,
+        _In_ const RedisScanCallback &callback)
+{
+    SWSS_LOG_ENTER();
+
+    scanKeys(pattern, [&](const std::vector<std::string> &keys)
+    {
+        std::vector<RedisHashFields> fields(keys.size());
+
+        for (size_t idx = 0; idx < keys.size(); ++idx)
+        {
+            auto &f = fields[idx];
+
+            push({ "HGETALL", keys[idx] },
+                    [&f](const redisReply *reply)
+                    {
+                        if (reply->type != REDIS_REPLY_ARRAY)
+                        {
+                            throw std::runtime_error("unexpected HGETALL reply");
+                        }
+
+                        for (size_t i = 0; i + 1 < reply->elements; i += 2)
+                        {
+                            f.emplace_back(
+                                    std::string(reply->element[i]->str, reply->element[i]->len),
+                                    std::string(reply->element[i + 1]->str, reply->element[i + 1]->len));
+                        }
+                    });
+        }
+
+        flush();
+
+        callback(keys, fields);
+    });
+}
+
+void RedisPipeline::removeDuplicateKeys(
+        _Inout_ std::unordered_set<std::string> &seen,
+        _Inout_ std::vector<std::string> &keys)
+{
+    SWSS_LOG_ENTER();
+
+    size_t count = 0;
+
+    for (size_t idx = 0; idx < keys.size(); ++idx)
+    {
+        if (seen.insert(keys[idx]).second)
+        {
+            if (count != idx)
+            {
+                keys[count] = std::move(keys[idx]);
+            }
+
+            count++;
+        }
+    }
+
+    keys.resize(count);
+}
+
+size_t RedisPipeline::getRoundTrips() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_roundTrips;
+}
+
+size_t RedisPipeline::getCommandsCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_commands;
+}
@@ -0,0 +1,133 @@
+#ifndef __SYNCD_REDIS_PIPELINE_H__
+#define __SYNCD_REDIS_PIPELINE_H__
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_set>
+
+#include <hiredis/hiredis.h>
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "swss/dbconnector.h"
+
+#define REDIS_PIPELINE_DEFAULT_BATCH_SIZE 1024
+
+typedef std::function<void(const redisReply *reply)> RedisReplyCallback;
+
+typedef std::vector<std::pair<std::string, std::string>> RedisHashFields;
+
+typedef std::function<void(
+        const std::vector<std::string> &keys,
+        std::vector<RedisHashFields> &fields)> RedisScanCallback;
+
+typedef std::function<void(
+        const std::vector<std::string> &keys)> RedisScanKeysCallback;
+
+/**
+ * @brief Redis pipeline.
+ *
+ * Commands pushed to pipeline are not sent to redis until batch size is
+ * reached or flush is called, so number of round trips to redis is bounded
+ * by number of commands divided by batch size. Any error reply will cause
+ * exception to be thrown on flush.
+ *
+ * Pipeline should be used on it's own database connector, since pending
+ * replies will be read from that connection.
+ */
+class RedisPipeline
+{
+    public:
+
+        RedisPipeline(
+                _In_ swss::DBConnector *db,
+                _In_ size_t batchSize = REDIS_PIPELINE_DEFAULT_BATCH_SIZE);
+
+        virtual ~RedisPipeline();
+
+        /**
+         * @brief Append command to pipeline, may flush.
+         *
+         * If callback is specified, it will be called with command reply
+         * when pipeline is flushed. Reply is freed after callback returns.
+         */
+        void push(
+                _In_ const std::vector<std::string> &args,
+                _In_ const RedisReplyCallback &callback = nullptr);
+
+        /**
+         * @brief Read replies for all pending commands.
+         */
+        void flush();
+
+        /**
+         * @brief Flush pending commands and execute command which returns
+         * integer reply.
+         */
+        long long commandInteger(
+                _In_ const std::vector<std::string> &args);
+
+        /**
+         * @brief Iterate all keys matching pattern.
+         *
+         * Keys are iterated using SCAN, so redis is not blocked for entire
+         * key space like in case of KEYS. Callback is called for each batch
+         * of keys. SCAN may return same key more than once, but each key is
+         * passed to callback only once.
+         */
+        void scanKeys(
+                _In_ const std::string &pattern,
+                _In_ const RedisScanKeysCallback &callback);
+
+        /**
+         * @brief Iterate all hashes matching pattern.
+         *
+         * Keys are iterated using SCAN and hashes are fetched using pipelined
+         * HGETALL, callback is called for each batch of keys. Each key is
+         * passed to callback only once.
+         */
+        void scanHashes(
+                _In_ const std::string &pattern,
+                _In_ const RedisScanCallback &callback);
+
+        /**
+         * @brief Remove keys which are already in seen set, and add
+         * remaining keys to it.
+         *
+         * Order of first occurrences is preserved.
+         */
+        static void removeDuplicateKeys(
+                _Inout_ std::unordered_set<std::string> &seen,
+                _Inout_ std::vector<std::string> &keys);
+
+        size_t getRoundTrips() const;
+
+        size_t getCommandsCount() const;
+
+    private:
+
+        RedisPipeline(const RedisPipeline&) = delete;
+        RedisPipeline& operator=(const RedisPipeline&) = delete;
+
+        void append(
+                _In_ const std::vector<std::string> &args);
+
+        redisReply* getReply();
+
+        redisContext *m_context;
+
+        size_t m_batchSize;
+
+        size_t m_pending;
+
+        std::vector<RedisReplyCallback> m_callbacks;
+
+        size_t m_roundTrips;
+
+        size_t m_commands;
+};
+
+#endif // __SYNCD_REDIS_PIPELINE_H__
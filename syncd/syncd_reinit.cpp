@@ -4,8 +4,12 @@
 #include <set>
 
 #include "syncd.h"
+#include "syncd_redis_pipeline.h"
+#include "syncd_warm_snapshot.h"
 #include "sairedis.h"
 
+#include "swss/tokenize.h"
+
 sai_uint32_t saiGetPortCount()
 {
     SWSS_LOG_ENTER();
@@ -192,6 +196,11 @@ std::unordered_map<sai_uint32_t, sai_object_id_t> redisGetLaneMap()
 {
     SWSS_LOG_ENTER();
 
+    if (g_warmBootSnapshot)
+    {
+        return g_warmBootSnapshot->getLaneMap();
+    }
+
     auto hash = g_redisClient->hgetall(LANES);
 
     SWSS_LOG_DEBUG("previous lanes: %lu", hash.size());
@@ -235,13 +244,6 @@ void redisSaveLaneMap(const std::unordered_map<sai_uint32_t, sai_object_id_t> &m
     }
 }
 
-std::vector<std::string> redisGetAsicStateKeys()
-{
-    SWSS_LOG_ENTER();
-
-    return g_redisClient->keys(ASIC_STATE_TABLE + std::string(":*"));
-}
-
 void redisClearVidToRidMap()
 {
     SWSS_LOG_ENTER();
@@ -343,68 +345,53 @@ void helperCheckLaneMap()
     }
 }
 
-sai_object_id_t redisGetDefaultVirtualRouterId()
+sai_object_id_t redisGetHiddenObjectId(const std::string &field)
 {
     SWSS_LOG_ENTER();
 
-    auto redisVrId = g_redisClient->hget(HIDDEN, DEFAULT_VIRTUAL_ROUTER_ID);
+    sai_object_id_t objectId;
 
-    if (redisVrId == NULL)
-        return SAI_NULL_OBJECT_ID;
+    if (g_warmBootSnapshot && g_warmBootSnapshot->getHiddenObjectId(field, objectId))
+    {
+        return objectId;
+    }
 
-    sai_object_id_t vr_id;
+    auto redisObjectId = g_redisClient->hget(HIDDEN, field);
 
-    sai_deserialize_object_id(*redisVrId, vr_id);
+    if (redisObjectId == NULL)
+        return SAI_NULL_OBJECT_ID;
+
+    sai_deserialize_object_id(*redisObjectId, objectId);
 
-    return vr_id;
+    return objectId;
 }
 
-sai_object_id_t redisGetDefaultTrapGroupId()
+sai_object_id_t redisGetDefaultVirtualRouterId()
 {
     SWSS_LOG_ENTER();
 
-    auto redisVrId = g_redisClient->hget(HIDDEN, DEFAULT_TRAP_GROUP_ID);
-
-    if (redisVrId == NULL)
-        return SAI_NULL_OBJECT_ID;
-
-    sai_object_id_t vr_id;
+    return redisGetHiddenObjectId(DEFAULT_VIRTUAL_ROUTER_ID);
+}
 
-    sai_deserialize_object_id(*redisVrId, vr_id);
+sai_object_id_t redisGetDefaultTrapGroupId()
+{
+    SWSS_LOG_ENTER();
 
-    return vr_id;
+    return redisGetHiddenObjectId(DEFAULT_TRAP_GROUP_ID);
 }
 
 sai_object_id_t redisGetDefaultStpInstanceId()
 {
     SWSS_LOG_ENTER();
 
-    auto redisStpId = g_redisClient->hget(HIDDEN, DEFAULT_STP_INSTANCE_ID);
-
-    if (redisStpId == NULL)
-        return SAI_NULL_OBJECT_ID;
-
-    sai_object_id_t stp_id;
-
-    sai_deserialize_object_id(*redisStpId, stp_id);
-
-    return stp_id;
+    return redisGetHiddenObjectId(DEFAULT_STP_INSTANCE_ID);
 }
 
 sai_object_id_t redisGetCpuId()
 {
     SWSS_LOG_ENTER();
 
-    auto redisCpuId = g_redisClient->hget(HIDDEN, CPU_PORT_ID);
-
-    if (redisCpuId == NULL)
-        return SAI_NULL_OBJECT_ID;
-
-    sai_object_id_t cpuId;
-
-    sai_deserialize_object_id(*redisCpuId, cpuId);
-
-    return cpuId;
+    return redisGetHiddenObjectId(CPU_PORT_ID);
 }
 
 void redisSetDefaultVirtualRouterId(sai_object_id_t vr_id)
@@ -594,51 +581,107 @@ void helperCheckCpuId()
     }
 }
 
-void redisCreateDummyEntryInAsicView(sai_object_id_t objectId)
+void redisCreateDummyEntriesInAsicView(const std::vector<sai_object_id_t> &discoveredRids)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t vid = translate_rid_to_vid(objectId);
+    /*
+     * Same RID can be reported by more than one discovery list, each RID
+     * must get only one VID, so duplicates are removed before HGET, since
+     * mappings for new RIDs are created after all HGETs are processed.
+     */
 
-    sai_object_type_t objectType = sai_object_type_query(objectId);
+    std::vector<sai_object_id_t> rids;
 
-    if (objectType == SAI_OBJECT_TYPE_NULL)
+    std::set<sai_object_id_t> seen;
+
+    for (auto rid: discoveredRids)
     {
-        SWSS_LOG_ERROR("sai_object_type_query returned NULL type for RID 0x%lx", objectId);
+        if (seen.insert(rid).second)
+        {
+            rids.push_back(rid);
+        }
+    }
 
-        exit_and_notify(EXIT_FAILURE);
+    if (rids.size() != discoveredRids.size())
+    {
+        SWSS_LOG_WARN("removed %zu duplicated discovered RIDs", discoveredRids.size() - rids.size());
     }
 
-    std::string strObjectType = sai_serialize_object_type(objectType);
+    /*
+     * Instead of translating each object and writing it's entry separately,
+     * existing VIDs are fetched using pipelined HGET and all new mappings and
+     * dummy entries are written in pipelined batches.
+     */
 
-    std::string strVid = sai_serialize_object_id(vid);
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
 
-    std::string strKey = ASIC_STATE_TABLE + (":" + strObjectType + ":" + strVid);
+    RedisPipeline pipeline(&db);
 
-    g_redisClient->hset(strKey, "NULL", "NULL");
-}
+    std::vector<std::string> vids(rids.size());
 
-std::set<sai_object_id_t> g_defaultPortsRids;
+    for (size_t idx = 0; idx < rids.size(); ++idx)
+    {
+        auto &strVid = vids[idx];
+
+        pipeline.push({ "HGET", RIDTOVID, sai_serialize_object_id(rids[idx]) },
+                [&strVid](const redisReply *reply)
+                {
+                    if (reply->type == REDIS_REPLY_STRING)
+                    {
+                        strVid = std::string(reply->str, reply->len);
+                    }
+                });
+    }
 
-void helperCheckPortIds()
-{
-    SWSS_LOG_ENTER();
+    pipeline.flush();
 
-    auto laneMap = saiGetHardwareLaneMap();
+    size_t created = 0;
 
-    for (auto kv: laneMap)
+    for (size_t idx = 0; idx < rids.size(); ++idx)
     {
-        sai_object_id_t portId = kv.second;
+        sai_object_id_t rid = rids[idx];
+
+        sai_object_type_t objectType = sai_object_type_query(rid);
+
+        if (objectType == SAI_OBJECT_TYPE_NULL)
+        {
+            SWSS_LOG_ERROR("sai_object_type_query returned NULL type for RID 0x%lx", rid);
+
+            exit_and_notify(EXIT_FAILURE);
+        }
+
+        std::string &strVid = vids[idx];
+
+        if (strVid.empty())
+        {
+            SWSS_LOG_INFO("spotted new RID 0x%lx", rid);
+
+            strVid = sai_serialize_object_id(redis_create_virtual_object_id(objectType));
+
+            std::string strRid = sai_serialize_object_id(rid);
+
+            pipeline.push({ "HSET", RIDTOVID, strRid, strVid });
+            pipeline.push({ "HSET", VIDTORID, strVid, strRid });
 
-        // translate will create entry if missing
-        // we assume here that port numbers didn't changed
-        // during restarts
-        redisCreateDummyEntryInAsicView(portId);
+            created++;
+        }
+
+        std::string strKey = ASIC_STATE_TABLE + (":" + sai_serialize_object_type(objectType) + ":" + strVid);
 
-        g_defaultPortsRids.insert(portId);
+        pipeline.push({ "HSET", strKey, "NULL", "NULL" });
     }
+
+    pipeline.flush();
+
+    SWSS_LOG_NOTICE("created %zu dummy entries in asic view, new RIDs: %zu, redis round trips: %zu",
+            rids.size(),
+            created,
+            pipeline.getRoundTrips());
 }
 
+std::set<sai_object_id_t> g_defaultPortsRids;
+
 void helperCheckVlanId()
 {
     SWSS_LOG_ENTER();
@@ -716,33 +759,6 @@ std::vector<sai_object_id_t> saiGetPortQueues(sai_object_id_t portId)
 // later we need to have this in redis with port mapping
 std::set<sai_object_id_t> g_defaultQueuesRids;
 
-void helperCheckQueuesIds()
-{
-    SWSS_LOG_ENTER();
-
-    std::vector<sai_object_id_t> ports = saiGetPortList();
-
-    for (const auto& portId: ports)
-    {
-        SWSS_LOG_DEBUG("getting queues for port 0x%lx", portId);
-
-        std::vector<sai_object_id_t> queues = saiGetPortQueues(portId);
-
-        // we have queues
-
-        for (const auto& queueId: queues)
-        {
-            // create entry in asic view if missing
-            // we assume here that queue numbers will
-            // not be changed during restarts
-
-            redisCreateDummyEntryInAsicView(queueId);
-
-            g_defaultQueuesRids.insert(queueId);
-        }
-    }
-}
-
 sai_uint32_t saiGetPortNumberOfPriorityGroups(sai_object_id_t portId)
 {
     SWSS_LOG_ENTER();
@@ -801,31 +817,6 @@ std::vector<sai_object_id_t> saiGetPortPriorityGroups(sai_object_id_t portId)
 // later we need to have this in redis with port mapping
 std::set<sai_object_id_t> g_defaultPriorityGroupsRids;
 
-void helperCheckPriorityGroupsIds()
-{
-    SWSS_LOG_ENTER();
-
-    std::vector<sai_object_id_t> ports = saiGetPortList();
-
-    for (const auto& portId: ports)
-    {
-        SWSS_LOG_DEBUG("getting priority groups for port 0x%lx", portId);
-
-        std::vector<sai_object_id_t> pgs = saiGetPortPriorityGroups(portId);
-
-        for (const auto& pgId: pgs)
-        {
-            // create entry in asic view if missing
-            // we assume here that PG numbers will
-            // not be changed during restarts
-
-            redisCreateDummyEntryInAsicView(pgId);
-
-            g_defaultPriorityGroupsRids.insert(pgId);
-        }
-    }
-}
-
 uint32_t saiGetMaxNumberOfChildsPerSchedulerGroup()
 {
     SWSS_LOG_ENTER();
@@ -956,28 +947,318 @@ std::vector<sai_object_id_t> saiGetSchedulerGroupChildList(sai_object_id_t sched
 
 std::set<sai_object_id_t> g_defaultSchedulerGroupsRids;
 
-void helperCheckSchedulerGroupsIds()
+typedef std::map<sai_object_id_t, std::vector<sai_object_id_t>> PortObjectsMap;
+
+/*
+ * Objects created by SAI on switch initialize, discovered by walking port
+ * list.
+ */
+struct SwitchDiscovery
+{
+    std::vector<sai_object_id_t> ports;
+
+    PortObjectsMap queues;
+    PortObjectsMap priorityGroups;
+    PortObjectsMap schedulerGroups;
+};
+
+std::string serializeObjectIdList(const std::vector<sai_object_id_t> &list)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto& portId: saiGetPortList())
+    std::string s;
+
+    for (auto oid: list)
     {
-        // each group can contain next scheduler group or queue
+        if (!s.empty())
+        {
+            s += ",";
+        }
 
-        for (const auto& schedGroupId: saiGetSchedulerGroupList(portId))
+        s += sai_serialize_object_id(oid);
+    }
+
+    return s;
+}
+
+std::vector<sai_object_id_t> deserializeObjectIdList(const std::string &s)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<sai_object_id_t> list;
+
+    if (s.empty())
+    {
+        return list;
+    }
+
+    for (const auto &token: swss::tokenize(s, ','))
+    {
+        sai_object_id_t oid;
+
+        sai_deserialize_object_id(token, oid);
+
+        list.push_back(oid);
+    }
+
+    return list;
+}
+
+/*
+ * Snapshot is valid only for the same profile, since profile selects
+ * hardware SKU and port configuration. Boot type is skipped since it's
+ * different on each start.
+ */
+std::string getDiscoverySnapshotProfile()
+{
+    SWSS_LOG_ENTER();
+
+    std::string profile;
+
+    for (const auto &kv: gProfileMap)
+    {
+        if (kv.first == SAI_KEY_BOOT_TYPE)
+        {
+            continue;
+        }
+
+        profile += kv.first + "=" + kv.second + "\n";
+    }
+
+    return profile;
+}
+
+SwitchDiscovery saiDiscoverSwitch(const std::vector<sai_object_id_t> &ports)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER("discover switch");
+
+    SwitchDiscovery discovery;
+
+    discovery.ports = ports;
+
+    for (const auto& portId: ports)
+    {
+        SWSS_LOG_DEBUG("discovering queues, priority groups and scheduler groups on port 0x%lx", portId);
+
+        discovery.queues[portId] = saiGetPortQueues(portId);
+        discovery.priorityGroups[portId] = saiGetPortPriorityGroups(portId);
+        discovery.schedulerGroups[portId] = saiGetSchedulerGroupList(portId);
+    }
+
+    return discovery;
+}
+
+/*
+ * Get port object list using snapshot list size as buffer size, if number of
+ * objects on the port changed, GET will fail with buffer overflow or will
+ * return different count, and snapshot will be rejected.
+ */
+bool verifyDiscoveredObjects(
+        const PortObjectsMap &map,
+        sai_attr_id_t attrId)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &kv: map)
+    {
+        sai_object_id_t portId = kv.first;
+
+        std::vector<sai_object_id_t> list(kv.second.size());
+
+        sai_attribute_t attr;
+
+        attr.id = attrId;
+        attr.value.objlist.count = (uint32_t)list.size();
+        attr.value.objlist.list = list.data();
+
+        sai_status_t status = sai_port_api->get_port_attribute(portId, 1, &attr);
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_NOTICE("failed to get %s on port 0x%lx: %s",
+                    get_attribute_metadata(SAI_OBJECT_TYPE_PORT, attrId)->attridname,
+                    portId,
+                    sai_serialize_status(status).c_str());
+
+            return false;
+        }
+
+        list.resize(attr.value.objlist.count);
+
+        if (!isEqualObjectIdMultiset(list, kv.second))
         {
-            // create entry in asic view if missing
-            // we assume here that SchedulerGroups numbers will
-            // not be changed during restarts
+            SWSS_LOG_WARN("RIDs on port 0x%lx from discovery snapshot differ from %s",
+                    portId,
+                    get_attribute_metadata(SAI_OBJECT_TYPE_PORT, attrId)->attridname);
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool redisGetDiscoverySnapshot(
+        const std::string &profile,
+        const std::vector<sai_object_id_t> &ports,
+        SwitchDiscovery &discovery)
+{
+    SWSS_LOG_ENTER();
+
+    auto hash = g_redisClient->hgetall(DISCOVERY_SNAPSHOT);
+
+    if (hash.size() == 0)
+    {
+        SWSS_LOG_NOTICE("no discovery snapshot in redis");
+
+        return false;
+    }
+
+    if (hash["profile"] != profile)
+    {
+        SWSS_LOG_NOTICE("discovery snapshot was taken with different profile");
+
+        return false;
+    }
+
+    if (hash["ports"] != serializeObjectIdList(ports))
+    {
+        SWSS_LOG_NOTICE("discovery snapshot port list differs from switch port list");
+
+        return false;
+    }
+
+    discovery.ports = ports;
+
+    for (auto portId: ports)
+    {
+        const std::string strPortId = sai_serialize_object_id(portId);
 
-            redisCreateDummyEntryInAsicView(schedGroupId);
+        const std::string prefixes[] = { "queues:", "pgs:", "sgs:" };
+
+        for (const auto &prefix: prefixes)
+        {
+            if (hash.find(prefix + strPortId) == hash.end())
+            {
+                SWSS_LOG_NOTICE("discovery snapshot is missing %s%s", prefix.c_str(), strPortId.c_str());
+
+                return false;
+            }
+        }
+
+        discovery.queues[portId] = deserializeObjectIdList(hash["queues:" + strPortId]);
+        discovery.priorityGroups[portId] = deserializeObjectIdList(hash["pgs:" + strPortId]);
+        discovery.schedulerGroups[portId] = deserializeObjectIdList(hash["sgs:" + strPortId]);
+    }
+
+    /*
+     * Snapshot RIDs are compared with lists obtained from SDK, since RID
+     * values can change between boots even when object types and counts are
+     * the same. Object counts are taken from snapshot, so this needs half of
+     * GET calls of full discovery.
+     */
+
+    return verifyDiscoveredObjects(discovery.queues, SAI_PORT_ATTR_QOS_QUEUE_LIST) &&
+        verifyDiscoveredObjects(discovery.priorityGroups, SAI_PORT_ATTR_PRIORITY_GROUP_LIST) &&
+        verifyDiscoveredObjects(discovery.schedulerGroups, SAI_PORT_ATTR_QOS_SCHEDULER_GROUP_LIST);
+}
+
+void redisSaveDiscoverySnapshot(
+        const std::string &profile,
+        const SwitchDiscovery &discovery)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<std::string> args = { "HMSET", DISCOVERY_SNAPSHOT,
+        "profile", profile,
+        "ports", serializeObjectIdList(discovery.ports) };
+
+    for (auto portId: discovery.ports)
+    {
+        const std::string strPortId = sai_serialize_object_id(portId);
+
+        args.push_back("queues:" + strPortId);
+        args.push_back(serializeObjectIdList(discovery.queues.at(portId)));
+
+        args.push_back("pgs:" + strPortId);
+        args.push_back(serializeObjectIdList(discovery.priorityGroups.at(portId)));
+
+        args.push_back("sgs:" + strPortId);
+        args.push_back(serializeObjectIdList(discovery.schedulerGroups.at(portId)));
+    }
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    RedisPipeline pipeline(&db);
+
+    pipeline.push({ "DEL", DISCOVERY_SNAPSHOT });
+    pipeline.push(args);
+
+    pipeline.flush();
+}
+
+void helperCheckDiscoveredIds()
+{
+    SWSS_LOG_ENTER();
+
+    // we assume here that port, queue, priority group and scheduler group
+    // numbers will not be changed during restarts
+
+    std::vector<sai_object_id_t> ports = saiGetPortList();
+
+    std::string profile = getDiscoverySnapshotProfile();
+
+    SwitchDiscovery discovery;
+
+    if (redisGetDiscoverySnapshot(profile, ports, discovery))
+    {
+        SWSS_LOG_NOTICE("using discovery snapshot for %zu ports", ports.size());
+    }
+    else
+    {
+        discovery = saiDiscoverSwitch(ports);
+
+        redisSaveDiscoverySnapshot(profile, discovery);
+    }
+
+    std::vector<sai_object_id_t> rids = ports;
+
+    g_defaultPortsRids.insert(ports.begin(), ports.end());
+
+    for (auto portId: ports)
+    {
+        for (auto queueId: discovery.queues[portId])
+        {
+            rids.push_back(queueId);
+
+            g_defaultQueuesRids.insert(queueId);
+        }
+
+        for (auto pgId: discovery.priorityGroups[portId])
+        {
+            rids.push_back(pgId);
+
+            g_defaultPriorityGroupsRids.insert(pgId);
+        }
+
+        // each group can contain next scheduler group or queue
+
+        for (auto schedGroupId: discovery.schedulerGroups[portId])
+        {
+            rids.push_back(schedGroupId);
 
             g_defaultSchedulerGroupsRids.insert(schedGroupId);
         }
     }
+
+    // create entries in asic view if missing
+
+    redisCreateDummyEntriesInAsicView(rids);
 }
 
-void onSyncdStart(bool warmStart)
+void onSyncdStart(int startType)
 {
     // it may happen that after initialize we will receive
     // some port notifications with port'ids that are not in
@@ -1005,25 +1286,27 @@ void onSyncdStart(bool warmStart)
 
     helperCheckVlanId();
 
-    helperCheckPortIds();
-
-    helperCheckQueuesIds();
-
-    helperCheckPriorityGroupsIds();
-
-    helperCheckSchedulerGroupsIds();
+    helperCheckDiscoveredIds();
 
     // TODO add SAI_SCHEDULER_GROUP_ATTR_SCHEDULER_PROFILE_ID
     // also support this values inside virtual switch
     // and what will happen if user will moify existing profile values?
 
-    if (warmStart)
+    if (startType == SAI_WARM_BOOT)
     {
         SWSS_LOG_NOTICE("skipping hard reinit since WARM start was performed");
         return;
     }
 
+    if (startType == SAI_FAST_BOOT)
+    {
+        SWSS_LOG_NOTICE("performing hard reinit with deferred reconcile since FAST start was performed");
+
+        hardReinit(true);
+        return;
+    }
+
     SWSS_LOG_NOTICE("performing hard reinit since COLD start was performed");
 
-    hardReinit();
+    hardReinit(false);
 }
@@ -0,0 +1,461 @@
+#include "syncd.h"
+#include "syncd_warm_snapshot.h"
+#include "syncd_redis_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+WarmBootSnapshot::WarmBootSnapshot():
+    m_data(NULL),
+    m_size(0),
+    m_header(NULL),
+    m_vidToRid(NULL),
+    m_ridToVid(NULL),
+    m_lanes(NULL),
+    m_hidden(NULL)
+{
+    SWSS_LOG_ENTER();
+}
+
+WarmBootSnapshot::~WarmBootSnapshot()
+{
+    SWSS_LOG_ENTER();
+
+    unmap();
+}
+
+void WarmBootSnapshot::unmap()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_data != NULL)
+    {
+        munmap(m_data, m_size);
+    }
+
+    m_data = NULL;
+    m_size = 0;
+    m_header = NULL;
+    m_vidToRid = NULL;
+    m_ridToVid = NULL;
+    m_lanes = NULL;
+    m_hidden = NULL;
+}
+
+uint64_t WarmBootSnapshot::checksum(
+        _In_ const void *data,
+        _In_ size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    const uint8_t *p = (const uint8_t*)data;
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t idx = 0; idx < size; ++idx)
+    {
+        hash ^= p[idx];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+static bool writeAll(
+        _In_ int fd,
+        _In_ const void *data,
+        _In_ size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    const char *p = (const char*)data;
+
+    while (size > 0)
+    {
+        ssize_t written = ::write(fd, p, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        p += written;
+        size -= (size_t)written;
+    }
+
+    return true;
+}
+
+bool WarmBootSnapshot::write(
+        _In_ const std::string &path)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER("write warm boot snapshot");
+
+    std::vector<warm_boot_snapshot_object_id_pair_t> vidToRid;
+    std::vector<warm_boot_snapshot_object_id_pair_t> ridToVid;
+
+    for (const auto &kv: redisGetVidToRidMap())
+    {
+        vidToRid.push_back({ kv.first, kv.second });
+        ridToVid.push_back({ kv.second, kv.first });
+    }
+
+    auto less = [](const warm_boot_snapshot_object_id_pair_t &a, const warm_boot_snapshot_object_id_pair_t &b)
+    {
+        return a.key < b.key;
+    };
+
+    std::sort(vidToRid.begin(), vidToRid.end(), less);
+    std::sort(ridToVid.begin(), ridToVid.end(), less);
+
+    std::vector<warm_boot_snapshot_lane_t> lanes;
+
+    for (const auto &kv: redisGetLaneMap())
+    {
+        lanes.push_back({ kv.first, 0, kv.second });
+    }
+
+    std::vector<warm_boot_snapshot_hidden_t> hidden;
+
+    for (const auto &kv: g_redisClient->hgetall(HIDDEN))
+    {
+        if (kv.first.size() >= WARM_BOOT_SNAPSHOT_NAME_SIZE)
+        {
+            SWSS_LOG_ERROR("hidden field name %s is too long for snapshot", kv.first.c_str());
+
+            return false;
+        }
+
+        warm_boot_snapshot_hidden_t h;
+
+        memset(&h, 0, sizeof(h));
+
+        strncpy(h.name, kv.first.c_str(), WARM_BOOT_SNAPSHOT_NAME_SIZE - 1);
+
+        sai_deserialize_object_id(kv.second, h.object_id);
+
+        hidden.push_back(h);
+    }
+
+    std::vector<char> payload;
+
+    auto append = [&](const void *data, size_t size)
+    {
+        payload.insert(payload.end(), (const char*)data, (const char*)data + size);
+    };
+
+    append(vidToRid.data(), vidToRid.size() * sizeof(warm_boot_snapshot_object_id_pair_t));
+    append(ridToVid.data(), ridToVid.size() * sizeof(warm_boot_snapshot_object_id_pair_t));
+    append(lanes.data(), lanes.size() * sizeof(warm_boot_snapshot_lane_t));
+    append(hidden.data(), hidden.size() * sizeof(warm_boot_snapshot_hidden_t));
+
+    warm_boot_snapshot_header_t header;
+
+    memset(&header, 0, sizeof(header));
+
+    memcpy(header.magic, WARM_BOOT_SNAPSHOT_MAGIC, sizeof(header.magic));
+
+    header.version = WARM_BOOT_SNAPSHOT_VERSION;
+    header.header_size = (uint32_t)sizeof(header);
+    header.payload_size = payload.size();
+    header.checksum = checksum(payload.data(), payload.size());
+    header.generation = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    header.object_id_count = vidToRid.size();
+    header.lane_count = lanes.size();
+    header.hidden_count = hidden.size();
+
+    std::string tmpPath = path + ".tmp";
+
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        SWSS_LOG_ERROR("failed to open %s: %s", tmpPath.c_str(), strerror(errno));
+
+        return false;
+    }
+
+    bool success = writeAll(fd, &header, sizeof(header)) &&
+        writeAll(fd, payload.data(), payload.size()) &&
+        fsync(fd) == 0;
+
+    close(fd);
+
+    if (!success || rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        SWSS_LOG_ERROR("failed to write %s: %s", path.c_str(), strerror(errno));
+
+        unlink(tmpPath.c_str());
+
+        return false;
+    }
+
+    /*
+     * Token is set after file is in place, if syncd will fail before that,
+     * file will not match token and will be ignored on load.
+     */
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    RedisPipeline pipeline(&db);
+
+    pipeline.push({ "SET", WARM_BOOT_SNAPSHOT_TOKEN, serializeToken(header.generation, header.checksum) });
+
+    pipeline.flush();
+
+    SWSS_LOG_NOTICE("written warm boot snapshot %s: %zu object ids, %zu lanes, %zu hidden, %zu bytes",
+            path.c_str(),
+            vidToRid.size(),
+            lanes.size(),
+            hidden.size(),
+            sizeof(header) + payload.size());
+
+    return true;
+}
+
+bool WarmBootSnapshot::load(
+        _In_ const std::string &path)
+{
+    SWSS_LOG_ENTER();
+
+    unmap();
+
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        SWSS_LOG_NOTICE("warm boot snapshot %s not present: %s", path.c_str(), strerror(errno));
+
+        return false;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(warm_boot_snapshot_header_t))
+    {
+        SWSS_LOG_ERROR("warm boot snapshot %s is too small", path.c_str());
+
+        close(fd);
+
+        return false;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        SWSS_LOG_ERROR("failed to mmap %s: %s", path.c_str(), strerror(errno));
+
+        return false;
+    }
+
+    m_data = data;
+    m_size = (size_t)st.st_size;
+    m_header = (const warm_boot_snapshot_header_t*)m_data;
+
+    const warm_boot_snapshot_header_t &h = *m_header;
+
+    if (memcmp(h.magic, WARM_BOOT_SNAPSHOT_MAGIC, sizeof(h.magic)) != 0 ||
+            h.version != WARM_BOOT_SNAPSHOT_VERSION ||
+            h.header_size != sizeof(warm_boot_snapshot_header_t))
+    {
+        SWSS_LOG_ERROR("warm boot snapshot %s has invalid header", path.c_str());
+
+        unmap();
+
+        return false;
+    }
+
+    /*
+     * Counts are read from file, so each of them is checked against file
+     * size before multiplication, sum of the checked sizes can't overflow.
+     */
+
+    if (h.object_id_count > m_size / (2 * sizeof(warm_boot_snapshot_object_id_pair_t)) ||
+            h.lane_count > m_size / sizeof(warm_boot_snapshot_lane_t) ||
+            h.hidden_count > m_size / sizeof(warm_boot_snapshot_hidden_t))
+    {
+        SWSS_LOG_ERROR("warm boot snapshot %s counts exceed file size %zu: %lu object ids, %lu lanes, %lu hidden",
+                path.c_str(),
+                m_size,
+                h.object_id_count,
+                h.lane_count,
+                h.hidden_count);
+
+        unmap();
+
+        return false;
+    }
+
+    uint64_t expectedSize =
+        2 * h.object_id_count * sizeof(warm_boot_snapshot_object_id_pair_t) +
+        h.lane_count * sizeof(warm_boot_snapshot_lane_t) +
+        h.hidden_count * sizeof(warm_boot_snapshot_hidden_t);
+
+    if (h.payload_size != expectedSize || m_size != h.header_size + h.payload_size)
+    {
+        SWSS_LOG_ERROR("warm boot snapshot %s size mismatch: %zu, expected %lu",
+                path.c_str(),
+                m_size,
+                h.header_size + expectedSize);
+
+        unmap();
+
+        return false;
+    }
+
+    const char *payload = (const char*)m_data + h.header_size;
+
+    if (checksum(payload, h.payload_size) != h.checksum)
+    {
+        SWSS_LOG_ERROR("warm boot snapshot %s checksum mismatch", path.c_str());
+
+        unmap();
+
+        return false;
+    }
+
+    m_vidToRid = (const warm_boot_snapshot_object_id_pair_t*)payload;
+    m_ridToVid = m_vidToRid + h.object_id_count;
+    m_lanes = (const warm_boot_snapshot_lane_t*)(m_ridToVid + h.object_id_count);
+    m_hidden = (const warm_boot_snapshot_hidden_t*)(m_lanes + h.lane_count);
+
+    SWSS_LOG_NOTICE("loaded warm boot snapshot %s: %lu object ids, %lu lanes, %lu hidden",
+            path.c_str(),
+            h.object_id_count,
+            h.lane_count,
+            h.hidden_count);
+
+    return true;
+}
+
+std::string WarmBootSnapshot::serializeToken(
+        _In_ uint64_t generation,
+        _In_ uint64_t checksum)
+{
+    SWSS_LOG_ENTER();
+
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "%016lx:%016lx", generation, checksum);
+
+    return buffer;
+}
+
+std::string WarmBootSnapshot::getToken() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_header ? serializeToken(m_header->generation, m_header->checksum) : "";
+}
+
+size_t WarmBootSnapshot::getObjectIdCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_header ? (size_t)m_header->object_id_count : 0;
+}
+
+const warm_boot_snapshot_object_id_pair_t* WarmBootSnapshot::getVidToRidPairs() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_vidToRid;
+}
+
+static bool findPair(
+        _In_ const warm_boot_snapshot_object_id_pair_t *pairs,
+        _In_ size_t count,
+        _In_ sai_object_id_t key,
+        _Out_ sai_object_id_t &value)
+{
+    SWSS_LOG_ENTER();
+
+    const warm_boot_snapshot_object_id_pair_t *end = pairs + count;
+
+    auto it = std::lower_bound(pairs, end, key,
+            [](const warm_boot_snapshot_object_id_pair_t &p, sai_object_id_t k) { return p.key < k; });
+
+    if (it == end || it->key != key)
+    {
+        return false;
+    }
+
+    value = it->value;
+
+    return true;
+}
+
+bool WarmBootSnapshot::getRidFromVid(
+        _In_ sai_object_id_t vid,
+        _Out_ sai_object_id_t &rid) const
+{
+    SWSS_LOG_ENTER();
+
+    return findPair(m_vidToRid, getObjectIdCount(), vid, rid);
+}
+
+bool WarmBootSnapshot::getVidFromRid(
+        _In_ sai_object_id_t rid,
+        _Out_ sai_object_id_t &vid) const
+{
+    SWSS_LOG_ENTER();
+
+    return findPair(m_ridToVid, getObjectIdCount(), rid, vid);
+}
+
+std::unordered_map<sai_uint32_t, sai_object_id_t> WarmBootSnapshot::getLaneMap() const
+{
+    SWSS_LOG_ENTER();
+
+    std::unordered_map<sai_uint32_t, sai_object_id_t> map;
+
+    for (size_t idx = 0; m_header && idx < m_header->lane_count; ++idx)
+    {
+        map[m_lanes[idx].lane] = m_lanes[idx].port_id;
+    }
+
+    return map;
+}
+
+bool WarmBootSnapshot::getHiddenObjectId(
+        _In_ const std::string &name,
+        _Out_ sai_object_id_t &objectId) const
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t idx = 0; m_header && idx < m_header->hidden_count; ++idx)
+    {
+        if (strncmp(m_hidden[idx].name, name.c_str(), WARM_BOOT_SNAPSHOT_NAME_SIZE) == 0)
+        {
+            objectId = m_hidden[idx].object_id;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string getWarmBootSnapshotPath(
+        _In_ const std::string &warmBootFile)
+{
+    SWSS_LOG_ENTER();
+
+    return warmBootFile + WARM_BOOT_SNAPSHOT_SUFFIX;
+}
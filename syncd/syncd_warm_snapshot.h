@@ -0,0 +1,172 @@
+#ifndef __SYNCD_WARM_SNAPSHOT_H__
+#define __SYNCD_WARM_SNAPSHOT_H__
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+extern "C" {
+#include "sai.h"
+}
+
+/*
+ * Snapshot file is written next to SAI warm boot file, with this suffix.
+ */
+#define WARM_BOOT_SNAPSHOT_SUFFIX ".syncd"
+
+#define WARM_BOOT_SNAPSHOT_MAGIC "SYNCDWBS"
+
+#define WARM_BOOT_SNAPSHOT_VERSION 2
+
+#define WARM_BOOT_SNAPSHOT_NAME_SIZE 64
+
+typedef struct _warm_boot_snapshot_header_t
+{
+    char magic[8];
+
+    uint32_t version;
+
+    uint32_t header_size;
+
+    uint64_t payload_size;
+
+    /*
+     * FNV-1a hash of payload.
+     */
+    uint64_t checksum;
+
+    /*
+     * Unique value of each written snapshot, together with checksum it forms
+     * token which is also stored in redis.
+     */
+    uint64_t generation;
+
+    uint64_t object_id_count;
+
+    uint64_t lane_count;
+
+    uint64_t hidden_count;
+
+} warm_boot_snapshot_header_t;
+
+typedef struct _warm_boot_snapshot_object_id_pair_t
+{
+    sai_object_id_t key;
+
+    sai_object_id_t value;
+
+} warm_boot_snapshot_object_id_pair_t;
+
+typedef struct _warm_boot_snapshot_lane_t
+{
+    uint32_t lane;
+
+    uint32_t reserved;
+
+    sai_object_id_t port_id;
+
+} warm_boot_snapshot_lane_t;
+
+typedef struct _warm_boot_snapshot_hidden_t
+{
+    char name[WARM_BOOT_SNAPSHOT_NAME_SIZE];
+
+    sai_object_id_t object_id;
+
+} warm_boot_snapshot_hidden_t;
+
+/**
+ * @brief Binary snapshot of syncd state used on warm start.
+ *
+ * Snapshot holds VID to RID translation map, lane map and default object
+ * ids from HIDDEN hash. Payload consists of fixed size records, VID to RID
+ * and RID to VID pairs are sorted by key, so snapshot is used directly from
+ * memory mapped file without any parsing.
+ *
+ * Layout: header, VID to RID pairs, RID to VID pairs, lanes, hidden entries.
+ *
+ * When snapshot is written, it's token is stored in redis under
+ * WARM_BOOT_SNAPSHOT_TOKEN, snapshot is used on load only if token in redis
+ * is the same, so snapshot will not be used with redis state that was
+ * modified or restored after snapshot was written.
+ */
+class WarmBootSnapshot
+{
+    public:
+
+        WarmBootSnapshot();
+
+        virtual ~WarmBootSnapshot();
+
+        /**
+         * @brief Write snapshot of current redis state to file.
+         *
+         * File is written to temporary file and renamed, so partially
+         * written snapshot is never loaded.
+         */
+        static bool write(
+                _In_ const std::string &path);
+
+        /**
+         * @brief Memory map snapshot file and validate it's checksum.
+         */
+        bool load(
+                _In_ const std::string &path);
+
+        /**
+         * @brief Get token of loaded snapshot.
+         */
+        std::string getToken() const;
+
+        size_t getObjectIdCount() const;
+
+        const warm_boot_snapshot_object_id_pair_t* getVidToRidPairs() const;
+
+        bool getRidFromVid(
+                _In_ sai_object_id_t vid,
+                _Out_ sai_object_id_t &rid) const;
+
+        bool getVidFromRid(
+                _In_ sai_object_id_t rid,
+                _Out_ sai_object_id_t &vid) const;
+
+        std::unordered_map<sai_uint32_t, sai_object_id_t> getLaneMap() const;
+
+        bool getHiddenObjectId(
+                _In_ const std::string &name,
+                _Out_ sai_object_id_t &objectId) const;
+
+        static uint64_t checksum(
+                _In_ const void *data,
+                _In_ size_t size);
+
+        static std::string serializeToken(
+                _In_ uint64_t generation,
+                _In_ uint64_t checksum);
+
+    private:
+
+        WarmBootSnapshot(const WarmBootSnapshot&) = delete;
+        WarmBootSnapshot& operator=(const WarmBootSnapshot&) = delete;
+
+        void unmap();
+
+        void *m_data;
+
+        size_t m_size;
+
+        const warm_boot_snapshot_header_t *m_header;
+
+        const warm_boot_snapshot_object_id_pair_t *m_vidToRid;
+
+        const warm_boot_snapshot_object_id_pair_t *m_ridToVid;
+
+        const warm_boot_snapshot_lane_t *m_lanes;
+
+        const warm_boot_snapshot_hidden_t *m_hidden;
+};
+
+std::string getWarmBootSnapshotPath(
+        _In_ const std::string &warmBootFile);
+
+#endif // __SYNCD_WARM_SNAPSHOT_H__
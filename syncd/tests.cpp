@@ -0,0 +1,478 @@
+#include "syncd.h"
+#include "syncd_redis_pipeline.h"
+#include "sairedis.h"
+
+#include "swss/json.hpp"
+
+#include <arpa/inet.h>
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+using json = nlohmann::json;
+
+#define ASSERT_SUCCESS(format,...) \
+    if ((status)!=SAI_STATUS_SUCCESS) \
+        SWSS_LOG_THROW(format ": %s", ##__VA_ARGS__, sai_serialize_status(status).c_str());
+
+#define ASSERT_TRUE(x) \
+    if (!(x)) \
+{\
+    SWSS_LOG_THROW("assert true failed '%s'", # x);\
+}
+
+const char* profile_get_value(
+        _In_ sai_switch_profile_id_t profile_id,
+        _In_ const char* variable)
+{
+    SWSS_LOG_ENTER();
+
+    return NULL;
+}
+
+int profile_get_next_value(
+        _In_ sai_switch_profile_id_t profile_id,
+        _Out_ const char** variable,
+        _Out_ const char** value)
+{
+    SWSS_LOG_ENTER();
+
+    return -1;
+}
+
+service_method_table_t test_services = {
+    profile_get_value,
+    profile_get_next_value
+};
+
+void on_switch_state_change(
+        _In_ sai_switch_oper_status_t switch_oper_status)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_fdb_event(
+        _In_ uint32_t count,
+        _In_ sai_fdb_event_notification_data_t *data)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_port_state_change(
+        _In_ uint32_t count,
+        _In_ sai_port_oper_status_notification_t *data)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_port_event(
+        _In_ uint32_t count,
+        _In_ sai_port_event_notification_t *data)
+{
+    SWSS_LOG_ENTER();
+}
+
+void on_switch_shutdown_request()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_THROW("got shutdown request, syncd failed");
+}
+
+void on_packet_event(
+        _In_ const void *buffer,
+        _In_ sai_size_t buffer_size,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+}
+
+sai_switch_notification_t switch_notifications
+{
+    on_switch_state_change,
+        on_fdb_event,
+        on_port_state_change,
+        on_port_event,
+        on_switch_shutdown_request,
+        on_packet_event
+};
+
+sai_switch_api_t             *sai_switch_api;
+sai_router_interface_api_t   *sai_router_interface_api;
+sai_next_hop_api_t           *sai_next_hop_api;
+sai_next_hop_group_api_t     *sai_next_hop_group_api;
+
+void test_remove_duplicate_keys()
+{
+    SWSS_LOG_ENTER();
+
+    std::unordered_set<std::string> seen;
+
+    /*
+     * SCAN can return the same key in one batch and in following batches.
+     */
+
+    std::vector<std::string> batch = { "ASIC_STATE:a", "ASIC_STATE:b", "ASIC_STATE:a", "ASIC_STATE:c" };
+
+    RedisPipeline::removeDuplicateKeys(seen, batch);
+
+    ASSERT_TRUE((batch == std::vector<std::string>{ "ASIC_STATE:a", "ASIC_STATE:b", "ASIC_STATE:c" }));
+
+    batch = { "ASIC_STATE:c", "ASIC_STATE:d", "ASIC_STATE:a", "ASIC_STATE:d" };
+
+    RedisPipeline::removeDuplicateKeys(seen, batch);
+
+    ASSERT_TRUE((batch == std::vector<std::string>{ "ASIC_STATE:d" }));
+
+    batch = { "ASIC_STATE:b" };
+
+    RedisPipeline::removeDuplicateKeys(seen, batch);
+
+    ASSERT_TRUE(batch.empty());
+    ASSERT_TRUE(seen.size() == 4);
+}
+
+void test_object_id_multiset()
+{
+    SWSS_LOG_ENTER();
+
+    struct
+    {
+        std::vector<sai_object_id_t> first;
+        std::vector<sai_object_id_t> second;
+        bool equal;
+    } matrix[] = {
+
+        // order
+
+        { { }, { }, true },
+        { { 1, 2, 3 }, { 1, 2, 3 }, true },
+        { { 1, 2, 3 }, { 3, 1, 2 }, true },
+        { { 1, 2, 3 }, { 1, 2, 4 }, false },
+        { { 1, 2 }, { 1, 2, 3 }, false },
+
+        // NULL objects
+
+        { { 1, 0, 2 }, { 0, 2, 1 }, true },
+        { { 1, 0, 2 }, { 1, 2, 2 }, false },
+        { { 0, 0, 1 }, { 0, 1, 1 }, false },
+
+        // duplicates
+
+        { { 1, 1, 2 }, { 2, 1, 1 }, true },
+        { { 1, 1, 2 }, { 1, 2, 2 }, false },
+        { { 1, 1 }, { 1 }, false },
+    };
+
+    for (const auto &m: matrix)
+    {
+        ASSERT_TRUE(isEqualObjectIdMultiset(m.first, m.second) == m.equal);
+        ASSERT_TRUE(isEqualObjectIdMultiset(m.second, m.first) == m.equal);
+    }
+}
+
+/*
+ * Fast boot persists new RIDs of reconciled objects and removes their
+ * previous RIDs from RIDTOVID, previous RID reused by SDK for object created
+ * while reconcile was pending must keep it's entry.
+ */
+void test_select_stale_rids()
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t deferredVid = 0x1000000000001;
+    sai_object_id_t otherVid = 0x1000000000002;
+    sai_object_id_t createdVid = 0x1000000000003;
+
+    sai_object_id_t reusedRid = 0x10;
+    sai_object_id_t previousRid = 0x20;
+    sai_object_id_t missingRid = 0x30;
+
+    std::vector<std::pair<sai_object_id_t, sai_object_id_t>> previous = {
+        { deferredVid, reusedRid },
+        { otherVid, previousRid },
+        { createdVid, missingRid },
+    };
+
+    /*
+     * reusedRid was given to object created by processEvent while reconcile
+     * was pending, so RIDTOVID already points it to new VID.
+     */
+
+    std::vector<std::string> currentVids = {
+        sai_serialize_object_id(0x1000000000004),
+        sai_serialize_object_id(otherVid),
+        "",
+    };
+
+    auto rids = selectStaleRids(previous, currentVids);
+
+    ASSERT_TRUE((rids == std::vector<sai_object_id_t>{ previousRid }));
+
+    ASSERT_TRUE(selectStaleRids({}, {}).empty());
+}
+
+void notify_syncd(
+        _In_ sai_redis_notify_syncd_t op)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_NOTIFY_SYNCD;
+    attr.value.s32 = op;
+
+    sai_status_t status = sai_switch_api->set_switch_attribute(&attr);
+
+    ASSERT_SUCCESS("Failed to notify syncd");
+}
+
+/**
+ * @brief Create view with next hop group with members in given order.
+ *
+ * Values are indexes of next hops, all next hops are created in every view,
+ * so only next hop group differs between views.
+ */
+void create_next_hop_group_view(
+        _In_ const std::vector<uint32_t> &members)
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status;
+
+    sai_attribute_t attr;
+
+    std::vector<sai_object_id_t> ports(1024);
+
+    attr.id = SAI_SWITCH_ATTR_PORT_LIST;
+    attr.value.objlist.count = (uint32_t)ports.size();
+    attr.value.objlist.list = ports.data();
+
+    status = sai_switch_api->get_switch_attribute(1, &attr);
+
+    ASSERT_SUCCESS("Failed to get port list");
+    ASSERT_TRUE(attr.value.objlist.count > 0);
+
+    attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+
+    status = sai_switch_api->get_switch_attribute(1, &attr);
+
+    ASSERT_SUCCESS("Failed to get default virtual router");
+
+    sai_object_id_t vr = attr.value.oid;
+
+    sai_attribute_t attrs[4];
+
+    attrs[0].id = SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID;
+    attrs[0].value.oid = vr;
+
+    attrs[1].id = SAI_ROUTER_INTERFACE_ATTR_TYPE;
+    attrs[1].value.s32 = SAI_ROUTER_INTERFACE_TYPE_PORT;
+
+    attrs[2].id = SAI_ROUTER_INTERFACE_ATTR_PORT_ID;
+    attrs[2].value.oid = ports[0];
+
+    attrs[3].id = SAI_ROUTER_INTERFACE_ATTR_SRC_MAC_ADDRESS;
+    memset(attrs[3].value.mac, 0, sizeof(sai_mac_t));
+    attrs[3].value.mac[0] = 0x02;
+
+    sai_object_id_t rif;
+
+    status = sai_router_interface_api->create_router_interface(&rif, 4, attrs);
+
+    ASSERT_SUCCESS("Failed to create router interface");
+
+    std::vector<sai_object_id_t> nextHops(5);
+
+    for (uint32_t idx = 0; idx < nextHops.size(); ++idx)
+    {
+        attrs[0].id = SAI_NEXT_HOP_ATTR_TYPE;
+        attrs[0].value.s32 = SAI_NEXT_HOP_IP;
+
+        attrs[1].id = SAI_NEXT_HOP_ATTR_IP;
+        attrs[1].value.ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        attrs[1].value.ipaddr.addr.ip4 = htonl(0x0a000001 + idx);
+
+        attrs[2].id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+        attrs[2].value.oid = rif;
+
+        status = sai_next_hop_api->create_next_hop(&nextHops[idx], 3, attrs);
+
+        ASSERT_SUCCESS("Failed to create next hop");
+    }
+
+    std::vector<sai_object_id_t> list;
+
+    for (auto idx: members)
+    {
+        list.push_back(nextHops.at(idx));
+    }
+
+    attrs[0].id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+    attrs[0].value.s32 = SAI_NEXT_HOP_GROUP_ECMP;
+
+    attrs[1].id = SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_LIST;
+    attrs[1].value.objlist.count = (uint32_t)list.size();
+    attrs[1].value.objlist.list = list.data();
+
+    sai_object_id_t group;
+
+    status = sai_next_hop_group_api->create_next_hop_group(&group, 2, attrs);
+
+    ASSERT_SUCCESS("Failed to create next hop group");
+}
+
+uint64_t get_apply_view_operations()
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_APPLY_VIEW_REPORT;
+    attr.value.s8list.count = 0;
+    attr.value.s8list.list = NULL;
+
+    sai_status_t status = sai_switch_api->get_switch_attribute(1, &attr);
+
+    ASSERT_TRUE(status == SAI_STATUS_BUFFER_OVERFLOW);
+
+    std::vector<int8_t> buffer(attr.value.s8list.count);
+
+    attr.value.s8list.list = buffer.data();
+
+    status = sai_switch_api->get_switch_attribute(1, &attr);
+
+    ASSERT_SUCCESS("Failed to get apply view report");
+
+    json report = json::parse((const char*)buffer.data());
+
+    ASSERT_TRUE(report.find("operations") != report.end());
+
+    return std::stoull(report["operations"].get<std::string>());
+}
+
+/**
+ * @brief Apply view with reordered object lists.
+ *
+ * Current view has next hop group with members in fixed order, each
+ * temporary view is compared using dry run. Views which differ only by
+ * order of members must converge with zero ASIC operations.
+ */
+void test_apply_view_object_list_matrix()
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status = sai_api_initialize(0, &test_services);
+
+    ASSERT_SUCCESS("Failed to initialize api");
+
+    sai_api_query(SAI_API_SWITCH,           (void**)&sai_switch_api);
+    sai_api_query(SAI_API_ROUTER_INTERFACE, (void**)&sai_router_interface_api);
+    sai_api_query(SAI_API_NEXT_HOP,         (void**)&sai_next_hop_api);
+    sai_api_query(SAI_API_NEXT_HOP_GROUP,   (void**)&sai_next_hop_group_api);
+
+    status = sai_switch_api->initialize_switch(0, "", "", &switch_notifications);
+
+    ASSERT_SUCCESS("Failed to initialize switch");
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_USE_TEMP_VIEW;
+    attr.value.booldata = true;
+
+    status = sai_switch_api->set_switch_attribute(&attr);
+
+    ASSERT_SUCCESS("Failed to enable temporary view");
+
+    notify_syncd(SAI_REDIS_NOTIFY_SYNCD_INIT_VIEW);
+
+    create_next_hop_group_view({ 0, 1, 2, 3 });
+
+    notify_syncd(SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW);
+
+    struct
+    {
+        std::vector<uint32_t> members;
+        bool converges;
+    } matrix[] = {
+        { { 0, 1, 2, 3 }, true },
+        { { 3, 2, 1, 0 }, true },
+        { { 1, 3, 0, 2 }, true },
+        { { 0, 1, 2 }, false },
+        { { 0, 1, 2, 4 }, false },
+        { { 4, 2, 1, 0 }, false },
+    };
+
+    for (const auto &m: matrix)
+    {
+        notify_syncd(SAI_REDIS_NOTIFY_SYNCD_INIT_VIEW);
+
+        create_next_hop_group_view(m.members);
+
+        notify_syncd(SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW_DRY_RUN);
+
+        uint64_t operations = get_apply_view_operations();
+
+        SWSS_LOG_NOTICE("%zu members: %lu operations", m.members.size(), operations);
+
+        ASSERT_TRUE((operations == 0) == m.converges);
+    }
+
+    /*
+     * Bring syncd back to apply mode with view equal to current.
+     */
+
+    notify_syncd(SAI_REDIS_NOTIFY_SYNCD_INIT_VIEW);
+
+    create_next_hop_group_view({ 0, 1, 2, 3 });
+
+    notify_syncd(SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW);
+
+    ASSERT_TRUE(get_apply_view_operations() == 0);
+
+    sai_switch_api->shutdown_switch(false);
+
+    sai_api_uninitialize();
+}
+
+int main(int argc, char **argv)
+{
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
+
+    SWSS_LOG_ENTER();
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_INFO);
+
+    try
+    {
+        test_remove_duplicate_keys();
+
+        test_object_id_multiset();
+
+        test_select_stale_rids();
+
+        /*
+         * Apply view tests need running redis and syncd built with vslib
+         * and started with temporary view enabled, same as saiviewbench.
+         */
+
+        if (argc > 1 && std::string(argv[1]) == "--syncd")
+        {
+            test_apply_view_object_list_matrix();
+        }
+
+        printf("\n[ %s ]\n\n", sai_serialize_status(SAI_STATUS_SUCCESS).c_str());
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("exception: %s", e.what());
+
+        printf("\n[ %s ]\n\n%s\n\n", sai_serialize_status(SAI_STATUS_FAILURE).c_str(), e.what());
+
+        exit(EXIT_FAILURE);
+    }
+
+    return 0;
+}